@@ -41,6 +41,16 @@ int main(int argc, const char** argv)
         BRAYNS_INFO << "[PERF] Scene initialization took "
                     << timer.milliseconds() << " milliseconds" << std::endl;
 
+        // the first frame includes the commit of the whole scene, Brayns logs
+        // the duration of each startup phase once it is rendered
+        timer.start();
+        brayns.commitAndRender();
+        timer.stop();
+        BRAYNS_INFO << "[PERF] First frame took " << timer.milliseconds()
+                    << " milliseconds" << std::endl;
+        BRAYNS_INFO << "[PERF] Time to first frame: "
+                    << brayns.getTimeToFirstFrame() << " seconds" << std::endl;
+
         auto& engine = brayns.getEngine();
         auto& scene = engine.getScene();
         const auto bounds = scene.getBounds();
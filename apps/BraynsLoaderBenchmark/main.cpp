@@ -0,0 +1,409 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <brayns/Brayns.h>
+#include <brayns/common/PhaseTimings.h>
+#include <brayns/common/engine/Engine.h>
+#include <brayns/common/loader/LoaderRegistry.h>
+#include <brayns/common/log.h>
+#include <brayns/common/scene/Model.h>
+#include <brayns/common/scene/Scene.h>
+#include <brayns/common/types.h>
+#include <brayns/parameters/ParametersManager.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+namespace fs = boost::filesystem;
+namespace po = boost::program_options;
+
+namespace
+{
+const std::string PARAM_OUTPUT = "output";
+const std::string PARAM_REPETITIONS = "repetitions";
+const std::string PARAM_SCALE = "scale";
+
+const unsigned SEED = 42;
+
+/** Measurements of one import of a file, phases in seconds */
+struct Run
+{
+    std::vector<brayns::PhaseTimings::Phase> phases;
+    double total{0};
+    size_t modelBytes{0};
+};
+
+/** Generated input file of a loader and its measurements */
+struct Input
+{
+    std::string name;
+    std::string filename;
+    std::vector<Run> runs;
+};
+
+/** Random points in a cube, one "x y z" line per point */
+void writePoints(const std::string& filename, const size_t nbPoints)
+{
+    std::mt19937 generator(SEED);
+    std::uniform_real_distribution<float> position(-100.f, 100.f);
+    std::ofstream file(filename);
+    for (size_t i = 0; i < nbPoints; ++i)
+        file << position(generator) << " " << position(generator) << " "
+             << position(generator) << "\n";
+}
+
+/** Height field of size x size vertices as a triangle mesh */
+void writeObjMesh(const std::string& filename, const size_t size)
+{
+    std::mt19937 generator(SEED);
+    std::uniform_real_distribution<float> height(0.f, 1.f);
+    std::ofstream file(filename);
+    for (size_t y = 0; y < size; ++y)
+        for (size_t x = 0; x < size; ++x)
+            file << "v " << x << " " << height(generator) << " " << y << "\n";
+    for (size_t y = 0; y + 1 < size; ++y)
+        for (size_t x = 0; x + 1 < size; ++x)
+        {
+            const size_t i = y * size + x + 1;
+            file << "f " << i << " " << i + size << " " << i + 1 << "\n";
+            file << "f " << i + 1 << " " << i + size << " " << i + size + 1
+                 << "\n";
+        }
+}
+
+/** Same height field as writeObjMesh, in the ASCII PLY format */
+void writePlyMesh(const std::string& filename, const size_t size)
+{
+    std::mt19937 generator(SEED);
+    std::uniform_real_distribution<float> height(0.f, 1.f);
+    std::ofstream file(filename);
+    file << "ply\nformat ascii 1.0\n"
+         << "element vertex " << size * size << "\n"
+         << "property float x\nproperty float y\nproperty float z\n"
+         << "element face " << 2 * (size - 1) * (size - 1) << "\n"
+         << "property list uchar int vertex_indices\nend_header\n";
+    for (size_t y = 0; y < size; ++y)
+        for (size_t x = 0; x < size; ++x)
+            file << x << " " << height(generator) << " " << y << "\n";
+    for (size_t y = 0; y + 1 < size; ++y)
+        for (size_t x = 0; x + 1 < size; ++x)
+        {
+            const size_t i = y * size + x;
+            file << "3 " << i << " " << i + size << " " << i + 1 << "\n";
+            file << "3 " << i + 1 << " " << i + size << " " << i + size + 1
+                 << "\n";
+        }
+}
+
+/** Random walk of atoms in fixed column PDB records */
+void writeProtein(const std::string& filename, const size_t nbAtoms)
+{
+    const char* elements[] = {"C", "N", "O", "S", "H"};
+    std::mt19937 generator(SEED);
+    std::uniform_real_distribution<float> step(-1.5f, 1.5f);
+    std::uniform_int_distribution<size_t> element(0, 4);
+    std::ofstream file(filename);
+    float x = 0.f, y = 0.f, z = 0.f;
+    char line[128];
+    for (size_t i = 0; i < nbAtoms; ++i)
+    {
+        x += step(generator);
+        y += step(generator);
+        z += step(generator);
+        const auto name = elements[element(generator)];
+        snprintf(line, sizeof(line),
+                 "ATOM  %5d %-4s %3s %c%4d    %8.3f%8.3f%8.3f%6.2f%6.2f"
+                 "          %2s  ",
+                 int(i % 100000), name, "ALA", 'A' + char(i / 10000 % 26),
+                 int(i / 10 % 10000), x, y, z, 1.f, 0.f, name);
+        file << line << "\n";
+    }
+    file << "END\n";
+}
+
+/** @return the raw file holding the voxels of the given mhd file */
+fs::path getRawFilename(const std::string& filename)
+{
+    return fs::path(filename).stem().string() + ".raw";
+}
+
+/** Cube of size^3 voxels with a spherical density, as mhd and raw files */
+void writeVolume(const std::string& filename, const size_t size)
+{
+    const auto rawFilename = getRawFilename(filename).string();
+    {
+        std::ofstream file(filename);
+        file << "ObjectType = Image\n"
+             << "DimSize = " << size << " " << size << " " << size << "\n"
+             << "ElementSpacing = 1 1 1\n"
+             << "ElementType = MET_UCHAR\n"
+             << "ElementDataFile = " << rawFilename << "\n";
+    }
+
+    std::vector<unsigned char> voxels(size * size * size);
+    const float center = 0.5f * size;
+    for (size_t z = 0; z < size; ++z)
+        for (size_t y = 0; y < size; ++y)
+            for (size_t x = 0; x < size; ++x)
+            {
+                const float dx = x - center, dy = y - center, dz = z - center;
+                const float distance =
+                    std::sqrt(dx * dx + dy * dy + dz * dz) / center;
+                voxels[(z * size + y) * size + x] = static_cast<unsigned char>(
+                    255.f * std::max(0.f, 1.f - distance));
+            }
+    std::ofstream raw((fs::path(filename).parent_path() / rawFilename).string(),
+                      std::ios::binary);
+    raw.write(reinterpret_cast<const char*>(voxels.data()), voxels.size());
+}
+
+/** Soma and random branching neurites in the SWC format */
+void writeMorphology(const std::string& filename, const size_t nbSamples)
+{
+    std::mt19937 generator(SEED);
+    std::uniform_real_distribution<float> step(-1.f, 1.f);
+    std::uniform_int_distribution<int> branch(0, 20);
+    std::ofstream file(filename);
+    file << "1 1 0 0 0 5 -1\n";
+
+    std::vector<brayns::Vector3f> positions{{0.f, 0.f, 0.f}};
+    size_t parent = 1;
+    for (size_t i = 2; i <= nbSamples; ++i)
+    {
+        // start a new section from a random previous sample now and then
+        if (i > 2 && branch(generator) == 0)
+            parent = std::uniform_int_distribution<size_t>(2, i - 1)(generator);
+        const auto& origin = positions[parent - 1];
+        const brayns::Vector3f position(origin.x() + step(generator),
+                                        origin.y() + step(generator) + 1.f,
+                                        origin.z() + step(generator));
+        positions.push_back(position);
+        file << i << " " << (i % 2 ? 3 : 2) << " " << position.x() << " "
+             << position.y() << " " << position.z() << " 0.5 " << parent
+             << "\n";
+        parent = i;
+    }
+}
+
+std::vector<Input> generateInputs(const fs::path& folder, const size_t scale)
+{
+    const auto path = [&folder](const std::string& name) {
+        return (folder / name).string();
+    };
+
+    std::vector<Input> inputs{{"xyz", path("points.xyz"), {}},
+                              {"obj", path("mesh.obj"), {}},
+                              {"ply", path("mesh.ply"), {}},
+                              {"pdb", path("protein.pdb"), {}},
+                              {"mhd", path("volume.mhd"), {}},
+                              {"swc", path("morphology.swc"), {}}};
+    writePoints(inputs[0].filename, 100000 * scale);
+    writeObjMesh(inputs[1].filename, 256 * scale);
+    writePlyMesh(inputs[2].filename, 256 * scale);
+    writeProtein(inputs[3].filename, 20000 * scale);
+    writeVolume(inputs[4].filename, 128 * scale);
+    writeMorphology(inputs[5].filename, 20000 * scale);
+    return inputs;
+}
+
+/**
+ * Imports the file once and commits it to the engine. The phases of the
+ * import are reading the file followed by the phases the loader marks with
+ * startPhase(), e.g. parsing and building the geometry, then the commit of
+ * the scene and the first frame.
+ */
+Run measure(brayns::Brayns& brayns, const Input& input)
+{
+    auto& scene = brayns.getEngine().getScene();
+    auto loader = scene.getLoaderRegistry().createLoader(input.filename);
+
+    brayns::PhaseTimings timings;
+    loader->setPhaseCallback(
+        [&timings](const std::string& name) { timings.start(name); });
+
+    timings.start("Read");
+    auto model = loader->importFromFile(input.filename, 0, brayns::NO_MATERIAL);
+    if (!model)
+        throw std::runtime_error("Could not import " + input.filename);
+
+    timings.start("Commit");
+    const auto modelID = scene.addModel(model);
+    scene.commit();
+
+    timings.start("First frame");
+    brayns.commitAndRender();
+    timings.stop();
+
+    Run run;
+    run.phases = timings.getPhases();
+    run.total = timings.getTotal();
+    run.modelBytes = scene.getSizeInBytes();
+    scene.removeModel(modelID);
+    scene.commit();
+    return run;
+}
+
+std::string escape(const std::string& value)
+{
+    std::string escaped;
+    for (const auto c : value)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            escaped += c;
+    }
+    return escaped;
+}
+
+/** @return the size of the input file, including the raw file of a volume */
+uintmax_t getFileBytes(const std::string& filename)
+{
+    auto bytes = fs::file_size(filename);
+    if (fs::path(filename).extension() == ".mhd")
+        bytes += fs::file_size(fs::path(filename).parent_path() /
+                               getRawFilename(filename));
+    return bytes;
+}
+
+void writeReport(std::ostream& stream, const std::vector<Input>& inputs)
+{
+    stream << "{\n  \"loaders\": [";
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        const auto& input = inputs[i];
+        stream << (i ? "," : "") << "\n    {\n"
+               << "      \"name\": \"" << escape(input.name) << "\",\n"
+               << "      \"file\": \"" << escape(input.filename) << "\",\n"
+               << "      \"file_bytes\": " << getFileBytes(input.filename)
+               << ",\n      \"runs\": [";
+        for (size_t j = 0; j < input.runs.size(); ++j)
+        {
+            const auto& run = input.runs[j];
+            stream << (j ? "," : "") << "\n        {\n"
+                   << "          \"phases\": [";
+            for (size_t k = 0; k < run.phases.size(); ++k)
+                stream << (k ? ", " : "") << "{\"name\": \""
+                       << escape(run.phases[k].first)
+                       << "\", \"seconds\": " << run.phases[k].second << "}";
+            stream << "],\n"
+                   << "          \"total_seconds\": " << run.total << ",\n"
+                   << "          \"model_bytes\": " << run.modelBytes
+                   << "\n        }";
+        }
+        stream << "\n      ]\n    }";
+    }
+    stream << "\n  ]\n}\n";
+}
+}
+
+int main(int argc, const char** argv)
+{
+    try
+    {
+        po::options_description options("Loader benchmark");
+        options.add_options()(PARAM_OUTPUT.c_str(), po::value<std::string>(),
+                              "JSON file for the results, stdout if not set")(
+            PARAM_REPETITIONS.c_str(), po::value<size_t>()->default_value(3),
+            "Number of imports of each file")(
+            PARAM_SCALE.c_str(), po::value<size_t>()->default_value(1),
+            "Size factor of the generated files")("help", "Print this help");
+
+        const auto parsed = po::command_line_parser(argc, argv)
+                                .options(options)
+                                .allow_unregistered()
+                                .run();
+        po::variables_map vm;
+        po::store(parsed, vm);
+        po::notify(vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << options << std::endl;
+            return 0;
+        }
+
+        const auto repetitions = vm[PARAM_REPETITIONS].as<size_t>();
+        const auto scale = std::max<size_t>(1, vm[PARAM_SCALE].as<size_t>());
+
+        // the other arguments configure Brayns, for instance the engine
+        brayns::strings braynsArguments{argv[0]};
+        for (const auto& arg :
+             po::collect_unrecognized(parsed.options, po::include_positional))
+            braynsArguments.push_back(arg);
+        std::vector<const char*> braynsArgv;
+        for (const auto& arg : braynsArguments)
+            braynsArgv.push_back(arg.c_str());
+        brayns::Brayns brayns(int(braynsArgv.size()), braynsArgv.data());
+
+        const auto& appParams =
+            brayns.getParametersManager().getApplicationParameters();
+        const auto folder =
+            fs::path(appParams.getTmpFolder()) /
+            fs::unique_path("brayns_loader_benchmark_%%%%%%%%");
+        fs::create_directories(folder);
+
+        BRAYNS_INFO << "Generating input files in " << folder.string()
+                    << std::endl;
+        auto inputs = generateInputs(folder, scale);
+
+        auto& registry = brayns.getEngine().getScene().getLoaderRegistry();
+        for (auto& input : inputs)
+        {
+            if (!registry.isSupported(input.filename))
+            {
+                BRAYNS_WARN << "No loader for " << input.name << " files"
+                            << std::endl;
+                continue;
+            }
+
+            for (size_t i = 0; i < repetitions; ++i)
+            {
+                input.runs.push_back(measure(brayns, input));
+                BRAYNS_INFO << input.name << " " << i + 1 << "/"
+                            << repetitions << ": " << input.runs.back().total
+                            << " seconds" << std::endl;
+            }
+        }
+
+        if (vm.count(PARAM_OUTPUT))
+        {
+            std::ofstream file(vm[PARAM_OUTPUT].as<std::string>());
+            writeReport(file, inputs);
+        }
+        else
+            writeReport(std::cout, inputs);
+
+        fs::remove_all(folder);
+    }
+    catch (const std::exception& e)
+    {
+        BRAYNS_ERROR << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,631 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/common/Timer.h>
+#include <brayns/common/log.h>
+#include <brayns/common/simulation/FrameReader.h>
+#include <brayns/common/simulation/SimulationCacheWriter.h>
+#include <brayns/common/types.h>
+
+#if (BRAYNS_USE_BRION)
+#include <brion/brion.h>
+#endif
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace po = boost::program_options;
+using brayns::floats;
+using brayns::uint32_ts;
+
+/**
+ * Converts a compartment report or a NEST spike report into a simulation cache
+ * file, as attached by the simulation handlers, outside of a running service.
+ *
+ * Batches of frames are read in parallel and written in order with large
+ * aligned writes. An interrupted conversion can be resumed, and the cache can
+ * be validated against the original report.
+ */
+namespace
+{
+const uint32_t NEST_MAGIC = 0xf0a;
+const uint32_t NEST_VERSION = 1;
+const uint32_t NEST_OFFSET = 2;
+const double NEST_TIMESTEP = 0.1;
+
+/** Reads frames of a report; each reading thread has its own source */
+class FrameSource
+{
+public:
+    virtual ~FrameSource() = default;
+
+    /** Reads nbFrames frames starting at frame first into buffer */
+    virtual void read(uint64_t first, uint64_t nbFrames, float* buffer) = 0;
+};
+
+using FrameSourcePtr = std::unique_ptr<FrameSource>;
+
+struct Simulation
+{
+    uint64_t nbFrames{0};
+    uint64_t frameSize{0};
+    /** Time of the first frame and step between frames, 0 for spikes */
+    double startTime{0};
+    double dt{0};
+    std::function<FrameSourcePtr()> createSource;
+};
+
+#if (BRAYNS_USE_BRION)
+/** Frames of a compartment report, timed as by CircuitSimulationHandler */
+class CompartmentReportSource : public FrameSource
+{
+public:
+    CompartmentReportSource(const brion::URI& uri, const double startTime,
+                            const double endTime, const double dt)
+        : _report(uri, brion::MODE_READ, brion::GIDSet())
+        , _startTime(startTime)
+        , _endTime(endTime)
+        , _dt(dt)
+    {
+    }
+
+    void read(const uint64_t first, const uint64_t nbFrames,
+              float* buffer) final
+    {
+        // request all frames of the batch before waiting for them
+        std::vector<std::future<brion::floatsPtr>> frames;
+        for (uint64_t i = 0; i < nbFrames; ++i)
+        {
+            const double timestamp = _startTime + (first + i) * _dt;
+            frames.push_back(_report.loadFrame(std::min(_endTime, timestamp)));
+        }
+
+        const size_t frameSize = _report.getFrameSize();
+        for (uint64_t i = 0; i < nbFrames; ++i)
+        {
+            const auto values = frames[i].get();
+            if (!values || values->size() != frameSize)
+                throw std::runtime_error("Could not read frame " +
+                                         std::to_string(first + i));
+            std::copy(values->begin(), values->end(), buffer + i * frameSize);
+        }
+    }
+
+private:
+    brion::CompartmentReport _report;
+    const double _startTime;
+    const double _endTime;
+    const double _dt;
+};
+
+Simulation openCompartmentReport(const std::string& uri,
+                                 const po::variables_map& vm)
+{
+    const brion::CompartmentReport report(brion::URI(uri), brion::MODE_READ,
+                                          brion::GIDSet());
+    const double startTime =
+        std::max(report.getStartTime(),
+                 vm["circuit-start-simulation-time"].as<double>());
+    const double endTime = std::min(
+        report.getEndTime(), vm["circuit-end-simulation-time"].as<double>());
+    const double dt = std::max(report.getTimestep(),
+                               vm["circuit-simulation-step"].as<double>());
+
+    Simulation simulation;
+    simulation.nbFrames = (endTime - startTime) / dt;
+    simulation.frameSize = report.getFrameSize();
+    simulation.startTime = startTime;
+    simulation.dt = dt;
+    simulation.createSource = [uri, startTime, endTime, dt] {
+        return FrameSourcePtr(new CompartmentReportSource(brion::URI(uri),
+                                                          startTime, endTime,
+                                                          dt));
+    };
+    return simulation;
+}
+#else
+Simulation openCompartmentReport(const std::string&, const po::variables_map&)
+{
+    throw std::runtime_error("Brion is required to read compartment reports");
+}
+#endif
+
+/** Spikes of a NEST report, sorted by time */
+struct Spikes
+{
+    floats times;
+    uint32_ts gids;
+};
+
+/**
+ * Frames of a NEST spike report, as written by NESTLoader: each value is the
+ * time of the last spike of the cell up to the end of the frame, -1 if the
+ * cell did not spike yet.
+ */
+class SpikeReportSource : public FrameSource
+{
+public:
+    SpikeReportSource(std::shared_ptr<const Spikes> spikes,
+                      const uint64_t frameSize)
+        : _spikes(std::move(spikes))
+        , _frameSize(frameSize)
+    {
+    }
+
+    void read(const uint64_t first, const uint64_t nbFrames,
+              float* buffer) final
+    {
+        const auto& times = _spikes->times;
+        const double startTime = times.front();
+
+        // replay the spikes that happened before the first frame
+        floats values(_frameSize, -1.f);
+        auto end = std::lower_bound(times.begin(), times.end(),
+                                    startTime + first * NEST_TIMESTEP);
+        _apply(values, times.begin(), end);
+
+        for (uint64_t i = 0; i < nbFrames; ++i)
+        {
+            const auto begin = end;
+            end = std::lower_bound(begin, times.end(),
+                                   startTime +
+                                       (first + i + 1) * NEST_TIMESTEP);
+            _apply(values, begin, end);
+            std::copy(values.begin(), values.end(), buffer + i * _frameSize);
+        }
+    }
+
+private:
+    void _apply(floats& values, const floats::const_iterator begin,
+                const floats::const_iterator end) const
+    {
+        const auto& times = _spikes->times;
+        for (auto i = begin; i != end; ++i)
+        {
+            const uint32_t gid =
+                _spikes->gids[i - times.begin()] - NEST_OFFSET;
+            if (gid < values.size())
+                values[gid] = *i;
+        }
+    }
+
+    std::shared_ptr<const Spikes> _spikes;
+    const uint64_t _frameSize;
+};
+
+Simulation openSpikeReport(const std::string& filename, uint64_t frameSize)
+{
+    std::ifstream file(filename, std::ios::binary);
+    uint32_t header[2] = {0, 0};
+    file.read((char*)header, sizeof(header));
+    if (!file || header[0] != NEST_MAGIC || header[1] != NEST_VERSION)
+        throw std::runtime_error(filename + " is not a NEST spike report");
+
+    auto spikes = std::make_shared<Spikes>();
+    float time;
+    uint32_t gid;
+    uint32_t maxGid = NEST_OFFSET;
+    while (file.read((char*)&time, sizeof(time)) &&
+           file.read((char*)&gid, sizeof(gid)))
+    {
+        spikes->times.push_back(time);
+        spikes->gids.push_back(gid);
+        maxGid = std::max(maxGid, gid);
+    }
+    if (spikes->times.empty())
+        throw std::runtime_error(filename + " contains no spikes");
+    if (!std::is_sorted(spikes->times.begin(), spikes->times.end()))
+        throw std::runtime_error(filename + " is not sorted by time");
+
+    if (frameSize == 0)
+    {
+        frameSize = maxGid - NEST_OFFSET + 1;
+        BRAYNS_WARN << "No frame size given, using " << frameSize
+                    << " from the highest GID; it must match the number of "
+                    << "cells of the NEST circuit" << std::endl;
+    }
+
+    Simulation simulation;
+    simulation.nbFrames =
+        (spikes->times.back() - spikes->times.front()) / NEST_TIMESTEP;
+    simulation.frameSize = frameSize;
+    simulation.createSource = [spikes, frameSize] {
+        return FrameSourcePtr(new SpikeReportSource(spikes, frameSize));
+    };
+    return simulation;
+}
+
+/**
+ * Reads the batches of frames [firstFrame, nbFrames) in parallel and hands
+ * them to consume() in order, from the calling thread. At most maxBatches
+ * batches are held in memory.
+ */
+void processInOrder(
+    const Simulation& simulation, const uint64_t firstFrame,
+    const uint64_t batchFrames, const size_t nbThreads,
+    const size_t maxBatches,
+    const std::function<void(uint64_t frame, uint64_t nbFrames, floats&)>&
+        consume)
+{
+    const uint64_t nbBatches =
+        (simulation.nbFrames - firstFrame + batchFrames - 1) / batchFrames;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::map<uint64_t, floats> readyBatches;
+    uint64_t nextBatch = 0;
+    uint64_t consumedBatches = 0;
+    std::exception_ptr error;
+
+    auto readBatches = [&] {
+        try
+        {
+            auto source = simulation.createSource();
+            for (;;)
+            {
+                uint64_t batch;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock, [&] {
+                        return error || nextBatch >= nbBatches ||
+                               nextBatch < consumedBatches + maxBatches;
+                    });
+                    if (error || nextBatch >= nbBatches)
+                        return;
+                    batch = nextBatch++;
+                }
+
+                const uint64_t first = firstFrame + batch * batchFrames;
+                const uint64_t count =
+                    std::min(batchFrames, simulation.nbFrames - first);
+                floats values(count * simulation.frameSize);
+                source->read(first, count, values.data());
+
+                std::lock_guard<std::mutex> lock(mutex);
+                readyBatches.emplace(batch, std::move(values));
+                condition.notify_all();
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = std::current_exception();
+            condition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nbThreads; ++i)
+        threads.emplace_back(readBatches);
+
+    try
+    {
+        for (uint64_t batch = 0; batch < nbBatches; ++batch)
+        {
+            floats values;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&] {
+                    return error || readyBatches.count(batch) > 0;
+                });
+                if (error)
+                    break;
+                values = std::move(readyBatches[batch]);
+                readyBatches.erase(batch);
+            }
+
+            const uint64_t first = firstFrame + batch * batchFrames;
+            consume(first, values.size() / std::max<uint64_t>(
+                                               simulation.frameSize, 1),
+                    values);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ++consumedBatches;
+            condition.notify_all();
+        }
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+            error = std::current_exception();
+        condition.notify_all();
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/**
+ * @return the number of frames of the cache that differ from the report, by
+ *         more than the error bound of compressed caches
+ */
+uint64_t validate(const Simulation& simulation, const std::string& cacheFile,
+                  const uint64_t batchFrames, const size_t nbThreads,
+                  const size_t maxBatches)
+{
+    // only the magic is needed to tell an uncompressed cache
+    brayns::CompressedSimulationCacheHeader header;
+    {
+        std::ifstream file(cacheFile, std::ios::binary);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (file.gcount() < std::streamsize(sizeof(header.magic)))
+            throw std::runtime_error("Could not open " + cacheFile);
+    }
+    const bool compressed =
+        header.magic == brayns::COMPRESSED_SIMULATION_CACHE_MAGIC;
+
+    auto reader = brayns::FrameReader::create(brayns::FrameReaderType::pread,
+                                              cacheFile, 1);
+    if (reader->getNbFrames() != simulation.nbFrames ||
+        reader->getFrameSize() != simulation.frameSize)
+    {
+        throw std::runtime_error(cacheFile + " does not match the report");
+    }
+
+    const uint64_t frameBytes = simulation.frameSize * sizeof(float);
+    uint64_t nbInvalidFrames = 0;
+    float maxError = 0;
+    processInOrder(
+        simulation, 0, batchFrames, nbThreads, maxBatches,
+        [&](const uint64_t first, const uint64_t nbFrames, floats& values) {
+            for (uint64_t i = 0; i < nbFrames; ++i)
+            {
+                const auto cached = reader->getFrame(first + i, true);
+                const auto original = values.data() + i * simulation.frameSize;
+                bool valid = true;
+                if (compressed)
+                {
+                    float error = 0;
+                    float magnitude = 0;
+                    for (uint64_t j = 0; j < simulation.frameSize; ++j)
+                    {
+                        error = std::max(error,
+                                         std::abs(cached[j] - original[j]));
+                        magnitude = std::max(magnitude, std::abs(original[j]));
+                    }
+                    maxError = std::max(maxError, error);
+                    // allow for rounding differences with the encoder, an
+                    // absolute amount at the magnitude of the values
+                    valid = error <= header.errorBound +
+                                         brayns::getSimulationRoundingError(
+                                             magnitude);
+                }
+                else
+                    valid = std::memcmp(cached, original, frameBytes) == 0;
+
+                if (!valid)
+                {
+                    if (nbInvalidFrames == 0)
+                        BRAYNS_ERROR << "First invalid frame: " << first + i
+                                     << std::endl;
+                    ++nbInvalidFrames;
+                }
+            }
+        });
+
+    if (compressed)
+        BRAYNS_INFO << "Maximum error: " << maxError << " (bound "
+                    << header.errorBound << ")" << std::endl;
+    return nbInvalidFrames;
+}
+}
+
+int main(int argc, const char** argv)
+{
+    po::options_description options("Options");
+    // clang-format off
+    options.add_options()
+        ("help", "Print this help")
+        ("report", po::value<std::string>(),
+            "Compartment report to convert [URI]")
+        ("nest-report", po::value<std::string>(),
+            "NEST spike report to convert [string]")
+        ("nest-frame-size", po::value<uint64_t>()->default_value(0),
+            "Number of cells of the NEST circuit; the highest GID of the "
+            "report if 0 [int]")
+        ("output", po::value<std::string>(), "Cache file to write [string]")
+        ("circuit-start-simulation-time",
+            po::value<double>()->default_value(0),
+            "Start of the converted simulation [float]")
+        ("circuit-end-simulation-time",
+            po::value<double>()->default_value(
+                std::numeric_limits<float>::max()),
+            "End of the converted simulation [float]")
+        ("circuit-simulation-step", po::value<double>()->default_value(0),
+            "Step between frames, at least the report's one [float]")
+        ("threads", po::value<size_t>()->default_value(
+                std::max(1u, std::thread::hardware_concurrency())),
+            "Number of reading threads [int]")
+        ("batch-frames", po::value<uint64_t>()->default_value(16),
+            "Number of frames read at once by a thread [int]")
+        ("memory", po::value<size_t>()->default_value(4096),
+            "Memory for the frames read ahead, in MB [int]")
+        ("block-size", po::value<size_t>()->default_value(64),
+            "Size of the writes, in MB [int]")
+        ("quantization-bits", po::value<uint32_t>()->default_value(32),
+            "Bits per value: 32 for raw floats, 16 or 8 to quantize and "
+            "compress the frames [int]")
+        ("key-frame-interval", po::value<uint32_t>()->default_value(16),
+            "Frames between two frames not encoded as the difference with "
+            "the previous one, 0 to disable; with quantization only [int]")
+        ("resume", "Continue an interrupted conversion, raw caches only")
+        ("validate", "Compare the cache with the report after the conversion")
+        ("validate-only", "Compare an existing cache with the report");
+    // clang-format on
+
+    try
+    {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, options), vm);
+        po::notify(vm);
+
+        if (vm.count("help") || !vm.count("output") ||
+            vm.count("report") == vm.count("nest-report"))
+        {
+            std::cout << "Usage: " << argv[0]
+                      << " (--report URI | --nest-report FILE) --output FILE"
+                      << std::endl
+                      << options << std::endl;
+            return vm.count("help") ? 0 : 1;
+        }
+
+        const auto output = vm["output"].as<std::string>();
+        const auto simulation =
+            vm.count("report")
+                ? openCompartmentReport(vm["report"].as<std::string>(), vm)
+                : openSpikeReport(vm["nest-report"].as<std::string>(),
+                                  vm["nest-frame-size"].as<uint64_t>());
+        if (simulation.nbFrames == 0 || simulation.frameSize == 0)
+            throw std::runtime_error("The report contains no data");
+
+        const uint64_t batchFrames =
+            std::max<uint64_t>(1, vm["batch-frames"].as<uint64_t>());
+        const size_t nbThreads =
+            std::max<size_t>(1, vm["threads"].as<size_t>());
+        const size_t batchBytes =
+            batchFrames * simulation.frameSize * sizeof(float);
+        const size_t maxBatches =
+            std::max(nbThreads, (vm["memory"].as<size_t>() << 20) / batchBytes);
+        const uint64_t frameBytes = simulation.frameSize * sizeof(float);
+
+        BRAYNS_INFO << "Frames     : " << simulation.nbFrames << std::endl;
+        BRAYNS_INFO << "Frame size : " << simulation.frameSize << std::endl;
+        BRAYNS_INFO << "Cache size : "
+                    << (brayns::SIMULATION_CACHE_HEADER_SIZE +
+                        simulation.nbFrames * frameBytes) /
+                           (1024 * 1024)
+                    << " MB" << std::endl;
+
+        brayns::SimulationCacheFormat format;
+        format.bits = vm["quantization-bits"].as<uint32_t>();
+        format.keyFrameInterval = vm["key-frame-interval"].as<uint32_t>();
+
+        brayns::Timer timer;
+        if (!vm.count("validate-only"))
+        {
+            brayns::SimulationCacheWriter writer(
+                output, simulation.nbFrames, simulation.frameSize,
+                vm.count("resume") > 0, vm["block-size"].as<size_t>() << 20,
+                format);
+
+            const uint64_t firstFrame = writer.getNbFrames();
+            uint64_t nextReport = 0;
+            float minValue = std::numeric_limits<float>::max();
+            float maxValue = std::numeric_limits<float>::lowest();
+            timer.start();
+            processInOrder(
+                simulation, firstFrame, batchFrames, nbThreads, maxBatches,
+                [&](const uint64_t, const uint64_t nbFrames, floats& values) {
+                    writer.append(values.data(), nbFrames);
+                    if (format.isCompressed())
+                    {
+                        const auto range =
+                            std::minmax_element(values.begin(), values.end());
+                        minValue = std::min(minValue, *range.first);
+                        maxValue = std::max(maxValue, *range.second);
+                    }
+                    const auto done = writer.getNbFrames();
+                    if (done >= nextReport || done == simulation.nbFrames)
+                    {
+                        const double seconds = timer.elapsed();
+                        BRAYNS_INFO << "Frame " << done << "/"
+                                    << simulation.nbFrames << ", "
+                                    << (done - firstFrame) * frameBytes /
+                                           (1024 * 1024 * seconds)
+                                    << " MB/s" << std::endl;
+                        nextReport = done + simulation.nbFrames / 100;
+                    }
+                });
+            writer.close();
+            if (simulation.dt > 0)
+            {
+                // CircuitSimulationHandler only uses the cache with the same
+                // simulation times
+                std::ofstream times(output +
+                                    brayns::SIMULATION_CACHE_TIMES_SUFFIX);
+                times.precision(std::numeric_limits<double>::max_digits10);
+                times << simulation.startTime << " " << simulation.dt
+                      << std::endl;
+                if (!times)
+                    throw std::runtime_error("Could not write the times of " +
+                                             output);
+            }
+            BRAYNS_INFO << "Converted " << simulation.nbFrames - firstFrame
+                        << " frames in " << timer.elapsed() << " seconds"
+                        << std::endl;
+            if (format.isCompressed())
+            {
+                const double rawSize = brayns::SIMULATION_CACHE_HEADER_SIZE +
+                                       simulation.nbFrames * frameBytes;
+                BRAYNS_INFO << "Compressed size   : "
+                            << writer.getSizeInBytes() / (1024 * 1024)
+                            << " MB, ratio "
+                            << rawSize / writer.getSizeInBytes() << std::endl;
+                BRAYNS_INFO << "Values range      : [" << minValue << ", "
+                            << maxValue << "]" << std::endl;
+                BRAYNS_INFO << "Error bound       : "
+                            << writer.getErrorBound() << std::endl;
+                BRAYNS_INFO << "Maximum error     : " << writer.getMaxError()
+                            << " ("
+                            << 100. * writer.getMaxError() /
+                                   std::max(maxValue - minValue,
+                                            std::numeric_limits<float>::min())
+                            << "% of the range)" << std::endl;
+            }
+        }
+
+        if (vm.count("validate") || vm.count("validate-only"))
+        {
+            timer.start();
+            const auto nbInvalidFrames = validate(simulation, output,
+                                                  batchFrames, nbThreads,
+                                                  maxBatches);
+            BRAYNS_INFO << "Validated " << simulation.nbFrames << " frames in "
+                        << timer.elapsed() << " seconds" << std::endl;
+            if (nbInvalidFrames != 0)
+            {
+                BRAYNS_ERROR << nbInvalidFrames << " frames differ from the "
+                             << "report" << std::endl;
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        BRAYNS_ERROR << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
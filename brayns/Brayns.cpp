@@ -21,6 +21,8 @@
 
 #include "Brayns.h"
 
+#include <brayns/common/FrameScheduler.h>
+#include <brayns/common/PhaseTimings.h>
 #include <brayns/common/Timer.h>
 #include <brayns/common/camera/Camera.h>
 #include <brayns/common/camera/FlyingModeManipulator.h>
@@ -65,6 +67,8 @@
 #include <servus/uri.h>
 #endif
 
+#include <cstdio>
+#include <fstream>
 #include <future>
 #ifdef BRAYNS_USE_LUNCHBOX
 #include <lunchbox/threadPool.h>
@@ -81,6 +85,12 @@ namespace
 const float DEFAULT_TEST_ANIMATION_FRAME = 10000;
 const float DEFAULT_MOTION_ACCELERATION = 1.5f;
 const size_t LOADING_PROGRESS_DATA = 100;
+const std::string WARM_STATE_ARGUMENTS_SUFFIX = ".arguments";
+// options whose files are written by Brayns, they do not invalidate the state
+const brayns::strings WARM_STATE_OUTPUT_OPTIONS = {"--warm-state-file",
+                                                   "--save-cache-file",
+                                                   "--frame-export-folder",
+                                                   "--tmp-folder"};
 }
 
 #define REGISTER_LOADER(LOADER, FUNC) \
@@ -93,6 +103,7 @@ struct Brayns::Impl : public PluginAPI
     Impl(int argc, const char** argv)
         : _engineFactory{argc, argv, _parametersManager}
     {
+        _startupTimer.start();
         BRAYNS_INFO << "     ____                             " << std::endl;
         BRAYNS_INFO << "    / __ )_________ ___  ______  _____" << std::endl;
         BRAYNS_INFO << "   / __  / ___/ __ `/ / / / __ \\/ ___/" << std::endl;
@@ -102,17 +113,21 @@ struct Brayns::Impl : public PluginAPI
         BRAYNS_INFO << std::endl;
 
         BRAYNS_INFO << "Parsing command line options" << std::endl;
+        _startupTimings.start("Parameters");
         _parametersManager.parse(argc, argv);
         _parametersManager.print();
+        _arguments.assign(argv + 1, argv + argc);
 
         _registerKeyboardShortcuts();
 
         createEngine();
 
+        _startupTimings.start("Scene commit");
         _engine->getScene().commit();
         _engine->setDefaultCamera();
         _finishLoadScene();
         _engine->getScene().resetModified();
+        _startupTimings.start("First frame");
     }
 
     void addPlugins()
@@ -221,6 +236,8 @@ struct Brayns::Impl : public PluginAPI
 
         _engine->getStatistics().setSceneSizeInBytes(
             _engine->getScene().getSizeInBytes());
+        _engine->getStatistics().setTextureSizeInBytes(
+            _engine->getScene().getTextureCache().getSizeInBytes());
 
         _updateAnimation();
 
@@ -253,6 +270,7 @@ struct Brayns::Impl : public PluginAPI
             scene.isModified() || renderer.isModified())
         {
             _engine->getFrameBuffer().clear();
+            _frameScheduler.wakeUp();
         }
 
         _parametersManager.resetModified();
@@ -264,22 +282,33 @@ struct Brayns::Impl : public PluginAPI
     }
 
     void render()
+    {
+        const auto& params = _parametersManager.getApplicationParameters();
+        _frameScheduler.setMaxFPS(params.getMaxRenderFPS());
+        _render();
+
+        // wait for the next frame without the render lock, so commit() and
+        // tasks can proceed; changes to render end the wait early
+        _frameScheduler.waitForNextFrame();
+    }
+
+    void _render()
     {
         std::lock_guard<std::mutex> lock{_renderMutex};
 
+        _frameScheduler.startFrame();
         _renderTimer.start();
         _engine->render();
         _renderTimer.stop();
         _lastFPS = _renderTimer.perSecondSmoothed();
 
-        const auto& params = _parametersManager.getApplicationParameters();
-        const auto fps = params.getMaxRenderFPS();
-        const auto delta = _lastFPS - fps;
-        if (delta > 0)
+        if (_startupTimings.isRunning())
         {
-            const int64_t targetTime = (1. / fps) * 1000.f;
-            std::this_thread::sleep_for(std::chrono::milliseconds(
-                targetTime - _renderTimer.milliseconds()));
+            _startupTimings.stop();
+            _timeToFirstFrame = _startupTimer.elapsed();
+            _startupTimings.print("Startup");
+            BRAYNS_INFO << "[PERF] Time to first frame: " << _timeToFirstFrame
+                        << " s" << std::endl;
         }
     }
 
@@ -289,6 +318,8 @@ struct Brayns::Impl : public PluginAPI
             _updateRenderOutput(*output);
 
         _engine->getStatistics().setFPS(_lastFPS);
+        _engine->getStatistics().setFrameTimeJitter(
+            _frameScheduler.getJitter().standardDeviation * 1000.);
 
         _engine->postRender();
 
@@ -303,6 +334,9 @@ struct Brayns::Impl : public PluginAPI
     {
         _engine.reset(); // Free resources before creating a new engine
 
+        // the engine records its own phases, the time to load its library is
+        // part of the time to first frame only
+        _startupTimings.stop();
         const auto& engineName =
             _parametersManager.getApplicationParameters().getEngine();
         _engine = _engineFactory.create(engineName);
@@ -311,6 +345,7 @@ struct Brayns::Impl : public PluginAPI
                 "Unsupported engine: " +
                 _parametersManager.getApplicationParameters().getEngineAsString(
                     engineName));
+        _startupTimings.append(_engine->getInitializationTimings(), "Engine: ");
 
         _setupCameraManipulator(CameraMode::inspect);
 
@@ -354,6 +389,15 @@ struct Brayns::Impl : public PluginAPI
             }));
 #endif
 
+        _startupTimings.start("Data loading");
+        if (_loadWarmState())
+            return;
+        _loadInputData();
+        _saveWarmState();
+    }
+
+    void _loadInputData()
+    {
         const auto& paths =
             _parametersManager.getApplicationParameters().getInputPaths();
         if (!paths.empty())
@@ -377,6 +421,72 @@ struct Brayns::Impl : public PluginAPI
         buildScene();
     }
 
+    /**
+     * The warm state is the binary scene cache of the loaded data and the
+     * command line arguments it was loaded with, with the size and time of
+     * the files they name. It is only used if the current arguments and
+     * files are the same.
+     */
+    bool _loadWarmState()
+    {
+        const auto& filename =
+            _parametersManager.getApplicationParameters().getWarmStateFile();
+        if (filename.empty())
+            return false;
+
+        std::ifstream file(filename + WARM_STATE_ARGUMENTS_SUFFIX);
+        strings arguments;
+        for (std::string argument; std::getline(file, argument);)
+            arguments.push_back(argument);
+        if (!file.eof() || arguments != _getWarmStateKey())
+        {
+            BRAYNS_INFO << "No warm state for these arguments in " << filename
+                        << std::endl;
+            return false;
+        }
+
+        auto& scene = _engine->getScene();
+        if (!scene.loadFromCacheFile(filename))
+            return false;
+        scene.buildEnvironmentMap();
+        return true;
+    }
+
+    strings _getWarmStateKey() const
+    {
+        return getInputStamps(_arguments, WARM_STATE_OUTPUT_OPTIONS);
+    }
+
+    void _saveWarmState()
+    {
+        const auto& filename =
+            _parametersManager.getApplicationParameters().getWarmStateFile();
+        if (filename.empty())
+            return;
+
+        // the arguments are written last, a partial state is never used
+        _finishLoadScene();
+        const auto argumentsFile = filename + WARM_STATE_ARGUMENTS_SUFFIX;
+        std::remove(argumentsFile.c_str());
+        if (!_engine->getScene().saveToCacheFile(filename))
+        {
+            BRAYNS_WARN << "Not saving the warm state to " << filename
+                        << std::endl;
+            return;
+        }
+
+        std::ofstream file(argumentsFile);
+        for (const auto& argument : _getWarmStateKey())
+            file << argument << std::endl;
+        file.close();
+        if (!file)
+        {
+            BRAYNS_ERROR << "Could not save the warm state to " << filename
+                         << std::endl;
+            std::remove(argumentsFile.c_str());
+        }
+    }
+
     void buildScene()
     {
         if (!isLoadingFinished())
@@ -433,6 +543,9 @@ struct Brayns::Impl : public PluginAPI
     }
 
     Engine& getEngine() { return *_engine; }
+    const PhaseTimings& getStartupTimings() const { return _startupTimings; }
+    double getTimeToFirstFrame() const { return _timeToFirstFrame; }
+    FrameScheduler& getFrameScheduler() { return _frameScheduler; }
     ParametersManager& getParametersManager() final
     {
         return _parametersManager;
@@ -479,7 +592,8 @@ private:
         if ((animParams.isModified() || animParams.getDelta() != 0) &&
             simHandler && simHandler->isReady())
         {
-            animParams.setFrame(animParams.getFrame() + animParams.getDelta());
+            animParams.setFramePosition(animParams.getFramePosition() +
+                                        animParams.getDelta());
         }
     }
 
@@ -491,17 +605,16 @@ private:
 
         size_t nextTic = 0;
         const size_t tic = LOADING_PROGRESS_DATA;
+        // parallel loaders publish their progress from a single thread, see
+        // ProgressAggregator
         auto updateProgress = [&nextTic,
                                &loadingProgress](const std::string&,
                                                  const float progress) {
-#pragma omp critical
+            const size_t newProgress = progress * tic;
+            if (newProgress % tic > nextTic)
             {
-                const size_t newProgress = progress * tic;
-                if (newProgress % tic > nextTic)
-                {
-                    loadingProgress += newProgress - nextTic;
-                    nextTic = newProgress;
-                }
+                loadingProgress += newProgress - nextTic;
+                nextTic = newProgress;
             }
         };
 
@@ -1047,6 +1160,12 @@ private:
 
     Timer _renderTimer;
     std::atomic<double> _lastFPS;
+    FrameScheduler _frameScheduler;
+
+    Timer _startupTimer;
+    PhaseTimings _startupTimings;
+    double _timeToFirstFrame{0.};
+    strings _arguments;
 
 #ifdef BRAYNS_USE_LUNCHBOX
     // it is important to perform loading and unloading in the same thread,
@@ -1120,6 +1239,21 @@ Engine& Brayns::getEngine()
     return _impl->getEngine();
 }
 
+const PhaseTimings& Brayns::getStartupTimings() const
+{
+    return _impl->getStartupTimings();
+}
+
+double Brayns::getTimeToFirstFrame() const
+{
+    return _impl->getTimeToFirstFrame();
+}
+
+FrameScheduler& Brayns::getFrameScheduler()
+{
+    return _impl->getFrameScheduler();
+}
+
 ParametersManager& Brayns::getParametersManager()
 {
     return _impl->getParametersManager();
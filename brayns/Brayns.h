@@ -136,6 +136,24 @@ public:
     */
     BRAYNS_API Engine& getEngine();
 
+    /**
+       @return the duration of the startup phases, from the parsing of the
+       parameters to the first rendered frame
+    */
+    BRAYNS_API const PhaseTimings& getStartupTimings() const;
+
+    /**
+       @return the time in seconds from the construction to the end of the
+       first render(), 0 until then
+    */
+    BRAYNS_API double getTimeToFirstFrame() const;
+
+    /**
+       @return the scheduler limiting the frame rate of render(), which also
+       records the jitter of the frame times
+    */
+    BRAYNS_API FrameScheduler& getFrameScheduler();
+
     /**
      * @return The parameter manager
      */
@@ -0,0 +1,119 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "FrameScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace brayns
+{
+void FrameScheduler::setMaxFPS(const size_t maxFPS)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto period =
+        maxFPS == 0 ? clock::duration::zero()
+                    : std::chrono::duration_cast<clock::duration>(
+                          std::chrono::duration<double>(1. / maxFPS));
+    if (period != _period)
+    {
+        _period = period;
+        _nextDeadline = clock::now();
+    }
+}
+
+void FrameScheduler::startFrame()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto now = clock::now();
+
+    if (_started)
+    {
+        const double interval =
+            std::chrono::duration<double>(now - _lastStart).count();
+        ++_intervals;
+        const double delta = interval - _mean;
+        _mean += delta / _intervals;
+        _m2 += delta * (interval - _mean);
+        if (_period != clock::duration::zero())
+        {
+            const double period =
+                std::chrono::duration<double>(_period).count();
+            _maxDeviation =
+                std::max(_maxDeviation, std::abs(interval - period));
+        }
+    }
+    _lastStart = now;
+    _started = true;
+
+    // changes committed before this frame are rendered by it, only the ones
+    // made while it renders or waits end its wait
+    _wakeUp = false;
+
+    // Keep the deadlines on the grid of periods while frames are on time or
+    // slightly late, start over from now if a whole period was missed.
+    _nextDeadline += _period;
+    if (_nextDeadline < now)
+        _nextDeadline = now + _period;
+}
+
+void FrameScheduler::waitForNextFrame()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_period != clock::duration::zero())
+        _condition.wait_until(lock, _nextDeadline, [this] { return _wakeUp; });
+
+    // the next frame starts now, schedule the following ones from it
+    if (_wakeUp)
+        _nextDeadline = clock::now();
+    _wakeUp = false;
+}
+
+void FrameScheduler::wakeUp()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _wakeUp = true;
+    }
+    _condition.notify_all();
+}
+
+FrameScheduler::Jitter FrameScheduler::getJitter() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Jitter jitter;
+    jitter.intervals = _intervals;
+    jitter.meanInterval = _mean;
+    jitter.standardDeviation =
+        _intervals > 1 ? std::sqrt(_m2 / (_intervals - 1)) : 0.;
+    jitter.maxDeviation = _maxDeviation;
+    return jitter;
+}
+
+void FrameScheduler::resetJitter()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _started = false;
+    _intervals = 0;
+    _mean = 0.;
+    _m2 = 0.;
+    _maxDeviation = 0.;
+}
+}
@@ -0,0 +1,96 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace brayns
+{
+/**
+ * Limits the frame rate with absolute frame deadlines: each frame is due one
+ * period after the deadline of the previous one, so the waiting time adapts
+ * to the duration of the rendering and does not drift. The wait ends early on
+ * wakeUp(), e.g. when the camera or the scene changed.
+ *
+ * Also records the intervals between frame starts to measure the jitter of
+ * the frame times.
+ */
+class FrameScheduler
+{
+public:
+    /** Statistics of the intervals between frame starts, in seconds */
+    struct Jitter
+    {
+        size_t intervals{0};
+        double meanInterval{0.};
+        double standardDeviation{0.};
+        /** Largest difference to the period of the max FPS, 0 if unlimited */
+        double maxDeviation{0.};
+    };
+
+    /** Limits the frame rate, 0 for no limit. */
+    BRAYNS_API void setMaxFPS(size_t maxFPS);
+
+    /**
+     * Records the start of a frame and schedules the next one. Discards the
+     * wake-ups received before.
+     */
+    BRAYNS_API void startFrame();
+
+    /**
+     * Blocks until the deadline of the next frame or until wakeUp(). Do not
+     * call with locks held that other threads need in the meantime.
+     */
+    BRAYNS_API void waitForNextFrame();
+
+    /**
+     * Ends the current wait for the next frame, or the next one if the current
+     * frame already started.
+     */
+    BRAYNS_API void wakeUp();
+
+    BRAYNS_API Jitter getJitter() const;
+    BRAYNS_API void resetJitter();
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _wakeUp{false};
+
+    clock::duration _period{clock::duration::zero()};
+    clock::time_point _nextDeadline;
+    clock::time_point _lastStart;
+    bool _started{false};
+
+    // running mean and variance of the intervals (Welford)
+    size_t _intervals{0};
+    double _mean{0.};
+    double _m2{0.};
+    double _maxDeviation{0.};
+};
+}
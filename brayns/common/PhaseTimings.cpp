@@ -0,0 +1,79 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "PhaseTimings.h"
+
+#include <brayns/common/log.h>
+
+#include <iomanip>
+#include <sstream>
+
+namespace brayns
+{
+void PhaseTimings::start(const std::string& name)
+{
+    stop();
+    _phases.emplace_back(name, 0.);
+    _running = true;
+    _timer.start();
+}
+
+void PhaseTimings::stop()
+{
+    if (!_running)
+        return;
+    _phases.back().second = _timer.elapsed();
+    _running = false;
+}
+
+void PhaseTimings::append(const PhaseTimings& other, const std::string& prefix)
+{
+    const auto count = other._phases.size() - (other._running ? 1 : 0);
+    for (size_t i = 0; i < count; ++i)
+        _phases.emplace_back(prefix + other._phases[i].first,
+                             other._phases[i].second);
+}
+
+double PhaseTimings::getTotal() const
+{
+    double total = 0.;
+    const auto count = _phases.size() - (_running ? 1 : 0);
+    for (size_t i = 0; i < count; ++i)
+        total += _phases[i].second;
+    return total;
+}
+
+void PhaseTimings::print(const std::string& title) const
+{
+    // format on a separate stream to not alter the state of the log stream
+    const auto line = [](const std::string& name, const double seconds) {
+        std::ostringstream os;
+        os << "[PERF]   " << std::left << std::setw(40) << name << std::right
+           << std::fixed << std::setprecision(3) << seconds << " s";
+        return os.str();
+    };
+
+    BRAYNS_INFO << "[PERF] " << title << std::endl;
+    const auto count = _phases.size() - (_running ? 1 : 0);
+    for (size_t i = 0; i < count; ++i)
+        BRAYNS_INFO << line(_phases[i].first, _phases[i].second) << std::endl;
+    BRAYNS_INFO << line("Total", getTotal()) << std::endl;
+}
+}
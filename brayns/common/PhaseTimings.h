@@ -0,0 +1,67 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/Timer.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace brayns
+{
+/**
+ * Records the duration of consecutive named phases, for instance of the
+ * startup of the application.
+ */
+class PhaseTimings
+{
+public:
+    /** Name and duration in seconds of a phase */
+    using Phase = std::pair<std::string, double>;
+
+    /** Ends the current phase, if any, and starts a new one */
+    BRAYNS_API void start(const std::string& name);
+
+    /** Ends the current phase, if any */
+    BRAYNS_API void stop();
+
+    /** @return true if a phase was started and not stopped yet */
+    bool isRunning() const { return _running; }
+    /** Appends the finished phases of other, with their names prefixed */
+    BRAYNS_API void append(const PhaseTimings& other,
+                           const std::string& prefix);
+
+    /** @return the finished phases, in the order they were started */
+    const std::vector<Phase>& getPhases() const { return _phases; }
+    /** @return the sum of the durations of the finished phases in seconds */
+    BRAYNS_API double getTotal() const;
+
+    /** Logs the duration of each finished phase and the total */
+    BRAYNS_API void print(const std::string& title) const;
+
+private:
+    std::vector<Phase> _phases;
+    Timer _timer;
+    bool _running{false};
+};
+}
@@ -20,10 +20,16 @@
 
 #pragma once
 
-#include <boost/any.hpp>
 #include <boost/static_assert.hpp>
+#include <boost/variant.hpp>
+
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -32,6 +38,11 @@ namespace brayns
 /**
  * Container class for holding properties that are mapped by name to a supported
  * C++ type and their respective value.
+ *
+ * Values are stored typed, without allocation for the numeric types, and the
+ * properties are found by name through an index. Each property tracks if it
+ * was changed since the last resetModified(), so that consumers like the
+ * engines only update what changed.
  */
 class PropertyMap
 {
@@ -58,15 +69,22 @@ public:
             Vec4f
         };
 
+        /** Storage of the values, alternatives in the order of Type */
+        using Value =
+            boost::variant<int32_t, double, std::string, bool,
+                           std::array<int32_t, 2>, std::array<double, 2>,
+                           std::array<int32_t, 3>, std::array<double, 3>,
+                           std::array<double, 4>>;
+
         template <typename T>
         Property(const std::string& name_, const std::string& label_,
                  const T& value)
             : name(name_)
             , label(label_)
             , type(_getType<T>())
-            , _data(value)
-            , _min(T())
-            , _max(T())
+            , _data(_toValue(value))
+            , _min(_toValue(T()))
+            , _max(_toValue(T()))
         {
         }
 
@@ -76,9 +94,9 @@ public:
             : name(name_)
             , label(label_)
             , type(_getType<T>())
-            , _data(value)
-            , _min(limit.first)
-            , _max(limit.second)
+            , _data(_toValue(value))
+            , _min(_toValue(limit.first))
+            , _max(_toValue(limit.second))
         {
         }
 
@@ -97,8 +115,8 @@ public:
             , type(_getType<T>())
             , enums(enums_)
             , _data(value)
-            , _min(0)
-            , _max(enums_.size())
+            , _min(int32_t(0))
+            , _max(int32_t(enums_.size()))
         {
         }
 
@@ -115,29 +133,39 @@ public:
         template <typename T>
         void set(const T& v)
         {
-            _data = v;
+            auto value = _toValue(v);
+            if (!(value == _data))
+            {
+                _data = std::move(value);
+                _modified = true;
+            }
             if (_modifiedCallback)
                 _modifiedCallback(*this);
         }
 
+        /** @throw std::runtime_error if T is not the type of the property */
         template <typename T>
         T get() const
         {
-            return boost::any_cast<T>(_data);
+            return _get<T>(_data);
         }
 
         template <typename T>
         T min() const
         {
-            return boost::any_cast<T>(_min);
+            return _get<T>(_min);
         }
 
         template <typename T>
         T max() const
         {
-            return boost::any_cast<T>(_max);
+            return _get<T>(_max);
         }
 
+        /** @return true if the value changed since the last resetModified() */
+        bool isModified() const { return _modified; }
+        void resetModified() { _modified = false; }
+
         /**
          * Read-only property shall not be modified from the outside aka web API
          * via JSON.
@@ -156,26 +184,68 @@ public:
 
     private:
         friend class PropertyMap;
-        boost::any _data;
-        const boost::any _min;
-        const boost::any _max;
+        Value _data;
+        const Value _min;
+        const Value _max;
         bool _readOnly{false};
+        bool _modified{true};
         ModifiedCallback _modifiedCallback;
         template <typename T>
         Type _getType();
+
+        template <typename T>
+        static Value _toValue(const T& value)
+        {
+            return value;
+        }
+        static Value _toValue(const char* value)
+        {
+            return std::string(value ? value : "");
+        }
+
+        template <typename T>
+        T _get(const Value& value) const
+        {
+            if (const auto typed = boost::get<T>(&value))
+                return *typed;
+            throw std::runtime_error("Property " + name +
+                                     " does not have the requested type");
+        }
     };
 
+    /** Index of no property, returned by getIndex() for unknown names */
+    static const size_t NO_INDEX = std::numeric_limits<size_t>::max();
+
+    /**
+     * @return the index of the property of the given name, or NO_INDEX. The
+     *         properties are only ever added, so the index stays valid for
+     *         the lifetime of the map and avoids the lookups by name in hot
+     *         paths.
+     */
+    size_t getIndex(const std::string& name) const
+    {
+        const auto i = _indices.find(name);
+        if (i == _indices.end())
+            return NO_INDEX;
+        return i->second;
+    }
+
     /** Update the property of the given name */
     template <typename T>
     inline void updateProperty(const std::string& name, const T& t)
     {
         if (auto property = findProperty(name))
-        {
-            if (property->type != property->_getType<T>())
-                throw std::runtime_error(
-                    "updateProperty does not allow for changing the type");
-            property->set(t);
-        }
+            _update(*property, t);
+    }
+
+    /**
+     * Update the property at the given index, see getIndex()
+     * @throw std::runtime_error if there is no property at the index
+     */
+    template <typename T>
+    inline void updatePropertyAt(const size_t index, const T& t)
+    {
+        _update(_at(index), t);
     }
 
     /** Update or add the given property. */
@@ -186,10 +256,18 @@ public:
             if (property->type != newProperty.type)
                 throw std::runtime_error(
                     "setProperty does not allow for changing the type");
-            property->_data = newProperty._data;
+            if (!(property->_data == newProperty._data))
+            {
+                property->_data = newProperty._data;
+                property->_modified = true;
+            }
         }
         else
+        {
+            _indices[newProperty.name] = _properties.size();
             _properties.push_back(std::make_shared<Property>(newProperty));
+            _properties.back()->_modified = true;
+        }
     }
 
     /**
@@ -215,6 +293,16 @@ public:
         throw std::runtime_error("No property found with name " + name);
     }
 
+    /**
+     * @return the property value at the given index, see getIndex()
+     * @throw std::runtime_error if there is no property at the index
+     */
+    template <typename T>
+    inline T getPropertyAt(const size_t index) const
+    {
+        return _at(index).get<T>();
+    }
+
     /** @return true if the property with the given name exists. */
     bool hasProperty(const std::string& name) const
     {
@@ -242,18 +330,56 @@ public:
 
     /** @return all the registered properties. */
     const auto& getProperties() const { return _properties; }
+    /**
+     * @return true if a property was added or changed since the last
+     *         resetModified().
+     */
+    bool isModified() const
+    {
+        return std::any_of(_properties.begin(), _properties.end(),
+                           [](const auto& p) { return p->isModified(); });
+    }
+
+    /** Marks all the properties as unchanged. */
+    void resetModified()
+    {
+        for (auto& property : _properties)
+            property->resetModified();
+    }
+
+    /** Marks all the properties as changed. */
+    void markModified()
+    {
+        for (auto& property : _properties)
+            property->_modified = true;
+    }
+
 private:
     Property* findProperty(const std::string& name) const
     {
-        auto foundProperty =
-            std::find_if(_properties.begin(), _properties.end(),
-                         [&](const auto& p) { return p->name == name; });
+        const auto index = getIndex(name);
+        return index != NO_INDEX ? _properties[index].get() : nullptr;
+    }
+
+    Property& _at(const size_t index) const
+    {
+        if (index >= _properties.size())
+            throw std::runtime_error("No property found at index " +
+                                     std::to_string(index));
+        return *_properties[index];
+    }
 
-        return foundProperty != _properties.end() ? foundProperty->get()
-                                                  : nullptr;
+    template <typename T>
+    static void _update(Property& property, const T& t)
+    {
+        if (property.type != property._getType<T>())
+            throw std::runtime_error(
+                "updateProperty does not allow for changing the type");
+        property.set(t);
     }
 
     std::vector<std::shared_ptr<Property>> _properties;
+    std::map<std::string, size_t> _indices;
 };
 
 template <>
@@ -313,6 +439,15 @@ inline PropertyMap::Property::Type
 {
     return PropertyMap::Property::Type::Vec4f;
 }
+template <>
+inline const char* PropertyMap::Property::_get<const char*>(
+    const Value& value) const
+{
+    if (const auto typed = boost::get<std::string>(&value))
+        return typed->c_str();
+    throw std::runtime_error("Property " + name +
+                             " does not have the requested type");
+}
 template <typename T>
 inline PropertyMap::Property::Type PropertyMap::Property::_getType()
 {
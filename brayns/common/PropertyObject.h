@@ -24,6 +24,7 @@
 #include <brayns/common/PropertyMap.h>
 #include <brayns/common/types.h>
 
+#include <atomic>
 #include <map>
 
 namespace brayns
@@ -35,6 +36,49 @@ namespace brayns
 class PropertyObject : public BaseObject
 {
 public:
+    /**
+     * Handle of a property of the current type, looked up by name again only
+     * when the current type or the property maps of the object change. For
+     * the properties read or updated in hot paths, e.g. on every frame.
+     */
+    class PropertyHandle
+    {
+    public:
+        explicit PropertyHandle(const std::string& name)
+            : _name(name)
+        {
+        }
+
+    private:
+        friend class PropertyObject;
+
+        PropertyMap::Property* _get(const PropertyObject& object) const
+        {
+            if (_version != object._propertiesVersion || _object != &object ||
+                _type != object._currentType)
+            {
+                _property = nullptr;
+                if (object.hasProperties())
+                {
+                    const auto& properties = object.getPropertyMap();
+                    const auto index = properties.getIndex(_name);
+                    if (index != PropertyMap::NO_INDEX)
+                        _property = properties.getProperties()[index].get();
+                }
+                _object = &object;
+                _version = object._propertiesVersion;
+                _type = object._currentType;
+            }
+            return _property;
+        }
+
+        std::string _name;
+        mutable const PropertyObject* _object{nullptr};
+        mutable uint64_t _version{0};
+        mutable std::string _type;
+        mutable PropertyMap::Property* _property{nullptr};
+    };
+
     /** Set the current type to use for 'type-less' queries and updates. */
     void setCurrentType(const std::string& type)
     {
@@ -56,6 +100,39 @@ public:
         }
     }
 
+    /** Update the value of the given property for the current type. */
+    template <typename T>
+    inline void updateProperty(const PropertyHandle& index, const T& value)
+    {
+        if (auto property = index._get(*this))
+        {
+            if (!_isEqual(property->get<T>(), value))
+            {
+                property->set(value);
+                markModified();
+            }
+        }
+    }
+
+    /** @return true if the given property exists for the current type. */
+    bool hasProperty(const PropertyHandle& index) const
+    {
+        return index._get(*this) != nullptr;
+    }
+
+    /**
+     * @return the value of the given property for the current type.
+     * @throw std::runtime_error if the current type does not have it
+     */
+    template <typename T>
+    inline T getProperty(const PropertyHandle& index) const
+    {
+        if (auto property = index._get(*this))
+            return property->get<T>();
+        throw std::runtime_error("No property found with name " +
+                                 index._name);
+    }
+
     /**
      * @return true if the property with the given name exists for the current
      *         type.
@@ -79,6 +156,8 @@ public:
     void setProperties(const PropertyMap& properties)
     {
         _properties[_currentType] = properties;
+        _properties[_currentType].markModified();
+        _propertiesVersion = _newPropertiesVersion();
         markModified();
     }
 
@@ -86,6 +165,8 @@ public:
     void setProperties(const std::string& type, const PropertyMap& properties)
     {
         _properties[type] = properties;
+        _properties[type].markModified();
+        _propertiesVersion = _newPropertiesVersion();
         markModified();
     }
 
@@ -109,6 +190,16 @@ public:
         return _properties.at(type);
     }
 
+    /**
+     * Marks the properties of the current type as unchanged, for instance once
+     * they have been passed on to the engine.
+     */
+    void resetModifiedProperties()
+    {
+        if (hasProperties())
+            _properties.at(_currentType).resetModified();
+    }
+
     /** @return the list of all registered types. */
     strings getTypes() const
     {
@@ -123,6 +214,7 @@ public:
     {
         _currentType = obj._currentType;
         _properties.clear();
+        _propertiesVersion = _newPropertiesVersion();
         for (const auto& kv : obj._properties)
         {
             const auto& key = kv.first;
@@ -139,5 +231,15 @@ public:
 protected:
     std::string _currentType;
     std::map<std::string, PropertyMap> _properties;
+
+private:
+    // unique among all objects, changed when the property maps are replaced,
+    // see PropertyHandle
+    static uint64_t _newPropertiesVersion()
+    {
+        static std::atomic<uint64_t> version{0};
+        return ++version;
+    }
+    uint64_t _propertiesVersion{_newPropertiesVersion()};
 };
 }
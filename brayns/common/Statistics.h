@@ -38,10 +38,23 @@ public:
     {
         _updateValue(_sceneSizeInBytes, sceneSizeInBytes);
     }
+    size_t getTextureSizeInBytes() const { return _textureSizeInBytes; }
+    void setTextureSizeInBytes(const size_t textureSizeInBytes)
+    {
+        _updateValue(_textureSizeInBytes, textureSizeInBytes);
+    }
+    /** @return standard deviation of the frame intervals in milliseconds */
+    double getFrameTimeJitter() const { return _frameTimeJitter; }
+    void setFrameTimeJitter(const double jitter)
+    {
+        _updateValue(_frameTimeJitter, jitter);
+    }
 
 private:
     double _fps{0.0};
     size_t _sceneSizeInBytes{0};
+    size_t _textureSizeInBytes{0};
+    double _frameTimeJitter{0.0};
 
     SERIALIZATION_FRIEND(Statistics)
 };
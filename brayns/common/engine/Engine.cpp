@@ -42,8 +42,8 @@ void Engine::reshape(const Vector2ui& frameSize)
     const auto size = getSupportedFrameSize(frameSize);
 
     _frameBuffer->resize(size);
-    _camera->updateProperty("aspect", static_cast<double>(size.x()) /
-                                          static_cast<double>(size.y()));
+    _camera->updateProperty(_aspect, static_cast<double>(size.x()) /
+                                         static_cast<double>(size.y()));
 }
 
 void Engine::commit()
@@ -92,6 +92,6 @@ void Engine::setDefaultCamera()
 {
     const auto frameSize = Vector2d(_frameBuffer->getSize());
     _camera->setInitialState(_scene->getBounds());
-    _camera->updateProperty("aspect", frameSize.x() / frameSize.y());
+    _camera->updateProperty(_aspect, frameSize.x() / frameSize.y());
 }
 }
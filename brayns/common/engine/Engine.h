@@ -21,6 +21,8 @@
 #ifndef ENGINE_H
 #define ENGINE_H
 
+#include <brayns/common/PhaseTimings.h>
+#include <brayns/common/PropertyObject.h>
 #include <brayns/common/Statistics.h>
 
 #include <functional>
@@ -132,6 +134,12 @@ public:
      */
     bool getKeepRunning() const { return _keepRunning; }
     Statistics& getStatistics() { return _statistics; }
+    /** @return the duration of the phases of the engine initialization. */
+    const PhaseTimings& getInitializationTimings() const
+    {
+        return _initializationTimings;
+    }
+
     /**
      * @return true if render() calls shall be continued, based on current
      *         accumulation settings.
@@ -168,9 +176,13 @@ protected:
     Vector2i _frameSize;
     FrameBufferPtr _frameBuffer;
     Statistics _statistics;
+    PhaseTimings _initializationTimings;
 
     bool _keepRunning{true};
     bool _rebuildScene{false};
+
+private:
+    PropertyObject::PropertyHandle _aspect{"aspect"};
 };
 }
 
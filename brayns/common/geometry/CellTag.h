@@ -0,0 +1,46 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+// A cell tag is a 32-bit value attached to a primitive that identifies the
+// cell it belongs to (lower 28 bits) and its morphology section type (upper 4
+// bits, using the MorphologySectionType flags). Tags are looked up in the
+// per-cell visibility mask by the intersection kernels.
+#define CELL_TAG_INDEX_BITS 28
+#define CELL_TAG_INDEX_MASK 0x0FFFFFFF
+#define CELL_TAG_SECTION_MASK 0x0F
+
+// Primitives that do not belong to any cell are always visible
+#define CELL_TAG_NONE 0xFFFFFFFF
+
+#if __cplusplus
+#include <cstdint>
+
+namespace brayns
+{
+inline uint32_t makeCellTag(const uint32_t cellIndex,
+                            const uint32_t sectionType)
+{
+    return ((sectionType & CELL_TAG_SECTION_MASK) << CELL_TAG_INDEX_BITS) |
+           (cellIndex & CELL_TAG_INDEX_MASK);
+}
+} // brayns
+#endif
@@ -41,8 +41,45 @@ struct SDFGeometry
     float radius = -1.f;
     float radius_tip = -1.f;
     float timestamp = 0.0f;
-    uint64_t neighboursIndex = 0;
-    uint8_t numNeighbours = 0;
+    SDFType type;
+};
+
+// The model stores each SDF geometry in packed form: the shape in the array of
+// its type and the data common to all types in SDFGeometryInfo.
+// NOTE: These layouts must match exactly the structs in
+// 'ExtendedSDFGeometries.ispc'
+
+struct SDFSphere
+{
+    Vector3f center;
+    float radius;
+};
+
+struct SDFPill
+{
+    Vector3f p0;
+    Vector3f p1;
+    float radius;
+};
+
+/** Cone pills and cone pills with sigmoid, radius is at p0 and the larger */
+struct SDFConePill
+{
+    Vector3f p0;
+    Vector3f p1;
+    float radius;
+    float radiusTip;
+};
+
+struct SDFGeometryInfo
+{
+    Vector2f textureCoords;
+    float timestamp;
+    // Index of the shape in the array of its type
+    uint32_t index;
+    // Index of the first neighbour in the neighbour array
+    uint32_t neighboursIndex;
+    uint8_t numNeighbours;
     SDFType type;
 };
 
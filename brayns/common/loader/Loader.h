@@ -68,6 +68,13 @@ public:
         const std::string& filename, const size_t index = 0,
         const size_t defaultMaterialId = NO_MATERIAL) = 0;
 
+    /**
+     * @return false if the loader can only import from files. Archives are
+     *         loaded from memory only if all their entries can be imported
+     *         from blobs.
+     */
+    virtual bool canImportFromBlob() const { return true; }
+
     /**
      * The callback for each progress update with the signature (message,
      * fraction of progress in 0..1 range)
@@ -80,9 +87,16 @@ public:
         _progressUpdate = func;
     }
 
+    /** @return the callback to publish the progress of a ProgressAggregator */
+    const UpdateCallback& getProgressCallback() const
+    {
+        return _progressUpdate;
+    }
+
     /**
      * Update the current progress of an operation. Will call the provided
-     * callback from setProgressUpdate().
+     * callback from setProgressUpdate(). Loops running on several threads
+     * should count their progress with a ProgressAggregator instead.
      */
     void updateProgress(const std::string& message, const size_t current,
                         const size_t expected)
@@ -94,10 +108,30 @@ public:
                 _progressUpdate(message, float(current) / expected);
     }
 
+    /**
+     * The callback for each phase boundary of an import, with the name of the
+     * phase that starts, e.g. "Parse" or "Build geometry".
+     */
+    using PhaseCallback = std::function<void(const std::string&)>;
+
+    /** Set a new callback function which is called on each startPhase(). */
+    void setPhaseCallback(const PhaseCallback& func) { _phaseStart = func; }
+
+    /**
+     * Mark the start of a phase of the current import, ending the previous
+     * one. Will call the provided callback from setPhaseCallback().
+     */
+    void startPhase(const std::string& name)
+    {
+        if (_phaseStart)
+            _phaseStart(name);
+    }
+
 protected:
     Scene& _scene;
 
 private:
     UpdateCallback _progressUpdate;
+    PhaseCallback _phaseStart;
 };
 }
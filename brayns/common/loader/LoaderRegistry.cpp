@@ -30,6 +30,9 @@ namespace brayns
 {
 void LoaderRegistry::registerLoader(LoaderInfo loaderInfo)
 {
+    // query once, so archive entries can be checked without creating loaders
+    loaderInfo.canImportFromBlob =
+        loaderInfo.createLoader()->canImportFromBlob();
     _loaders.insert(_loaders.begin(), loaderInfo);
 }
 
@@ -43,6 +46,17 @@ bool LoaderRegistry::isSupported(const std::string& type) const
     return false;
 }
 
+bool LoaderRegistry::isSupportedFromBlob(const std::string& type) const
+{
+    // same loader as createLoader()
+    for (const auto& entry : _loaders)
+    {
+        if (_isSupported(entry, type))
+            return entry.canImportFromBlob;
+    }
+    return false;
+}
+
 std::set<std::string> LoaderRegistry::supportedTypes() const
 {
     std::set<std::string> result;
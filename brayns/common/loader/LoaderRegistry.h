@@ -43,6 +43,9 @@ public:
 
         /** The function to create the loader. */
         std::function<LoaderPtr()> createLoader;
+
+        /** Set on registration from Loader::canImportFromBlob(). */
+        bool canImportFromBlob{true};
     };
 
     /** Register the given loader. */
@@ -54,6 +57,12 @@ public:
      */
     bool isSupported(const std::string& type) const;
 
+    /**
+     * @return true if the loader chosen for the given type can import it from
+     *         a blob, without creating the loader.
+     */
+    bool isSupportedFromBlob(const std::string& type) const;
+
     /** @return supported types from all registered loaders. */
     std::set<std::string> supportedTypes() const;
 
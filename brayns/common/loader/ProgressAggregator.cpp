@@ -0,0 +1,100 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ProgressAggregator.h"
+
+#include <algorithm>
+
+namespace brayns
+{
+ProgressAggregator::ProgressAggregator(const UpdateCallback& callback,
+                                       const std::string& message,
+                                       const size_t expected,
+                                       const std::chrono::milliseconds period)
+    : _callback(callback)
+    , _message(message)
+    , _expected(expected)
+    , _period(period)
+{
+    if (!_callback)
+        return;
+
+    _thread = std::thread([this] {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_condition.wait_for(lock, _period, [this] { return _stopped; }))
+        {
+            try
+            {
+                _publish();
+            }
+            catch (...)
+            {
+                _exception = std::current_exception();
+                _failed.store(true, std::memory_order_release);
+                return;
+            }
+        }
+    });
+}
+
+ProgressAggregator::~ProgressAggregator()
+{
+    _stop();
+}
+
+size_t ProgressAggregator::getCurrent() const
+{
+    size_t current = 0;
+    for (size_t i = 0; i < MAX_COUNTERS; ++i)
+        current += _counters[i].value.load(std::memory_order_relaxed);
+    return current;
+}
+
+void ProgressAggregator::finish()
+{
+    _stop();
+    if (_failed.load(std::memory_order_acquire))
+        std::rethrow_exception(_exception);
+    if (_callback)
+        _publish();
+}
+
+void ProgressAggregator::_stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _condition.notify_one();
+    if (_thread.joinable())
+        _thread.join();
+}
+
+void ProgressAggregator::_publish()
+{
+    const auto current = getCurrent();
+    if (current == _published)
+        return;
+    _published = current;
+    _callback(_message, _expected == 0
+                            ? 1.f
+                            : std::min(1.f, float(current) / _expected));
+}
+}
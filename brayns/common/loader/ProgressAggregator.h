@@ -0,0 +1,121 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace brayns
+{
+/**
+ * Collects the progress of work done by many threads and publishes it at a
+ * bounded rate. Each thread counts in its own cache line, so reporting
+ * progress never blocks; a single publisher thread samples the counters and
+ * calls the progress callback.
+ *
+ * An exception thrown by the callback, e.g. to cancel a loading task, is
+ * rethrown by the next call to increment() on any thread, and by finish().
+ */
+class ProgressAggregator
+{
+public:
+    /** Progress callback with the signature (message, progress in 0..1) */
+    using UpdateCallback = std::function<void(const std::string&, float)>;
+
+    /**
+     * @param callback called from the publisher thread, may be empty
+     * @param message the message published with the progress
+     * @param expected the amount of work for a progress of 1
+     * @param period the minimum time between two updates
+     */
+    BRAYNS_API ProgressAggregator(
+        const UpdateCallback& callback, const std::string& message,
+        size_t expected,
+        std::chrono::milliseconds period = std::chrono::milliseconds(100));
+
+    /** Stops the publisher thread, without publishing the last progress */
+    BRAYNS_API ~ProgressAggregator();
+
+    ProgressAggregator(const ProgressAggregator&) = delete;
+    ProgressAggregator& operator=(const ProgressAggregator&) = delete;
+
+    /** Adds work done by the calling thread; safe to call from any thread */
+    void increment(const size_t count = 1)
+    {
+        _counters[_slot()].value.fetch_add(count, std::memory_order_relaxed);
+        if (_failed.load(std::memory_order_acquire))
+            std::rethrow_exception(_exception);
+    }
+
+    /** @return the sum of the work done by all threads */
+    BRAYNS_API size_t getCurrent() const;
+
+    /**
+     * Stops the publisher thread and publishes the last progress from the
+     * calling thread. Rethrows the exception thrown by the callback, if any.
+     */
+    BRAYNS_API void finish();
+
+private:
+    // padded so that two counters never share a cache line
+    struct Counter
+    {
+        std::atomic<size_t> value{0};
+        char padding[64 - sizeof(std::atomic<size_t>)];
+    };
+
+    static constexpr size_t MAX_COUNTERS = 64;
+
+    static size_t _slot()
+    {
+        static std::atomic<size_t> nextSlot{0};
+        static thread_local const size_t slot = nextSlot++ % MAX_COUNTERS;
+        return slot;
+    }
+
+    void _stop();
+    void _publish();
+
+    const UpdateCallback _callback;
+    const std::string _message;
+    const size_t _expected;
+    const std::chrono::milliseconds _period;
+
+    Counter _counters[MAX_COUNTERS];
+    size_t _published{0};
+
+    std::atomic<bool> _failed{false};
+    std::exception_ptr _exception;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stopped{false};
+    std::thread _thread;
+};
+}
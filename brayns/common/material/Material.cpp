@@ -20,7 +20,7 @@
 
 #include "Material.h"
 
-#include <brayns/common/ImageManager.h>
+#include <brayns/common/material/TextureCache.h>
 
 namespace brayns
 {
@@ -33,25 +33,19 @@ Texture2DPtr Material::getTexture(const TextureType& type) const
     return it->second;
 }
 
-bool Material::_loadTexture(const std::string& fileName)
+void Material::setTexture(TextureCache& cache, const std::string& fileName,
+                          const TextureType& type)
 {
-    if (_textures.find(fileName) != _textures.end())
-        return true;
-
-    auto texture = ImageManager::importTextureFromFile(fileName);
+    const auto texture = cache.get(fileName);
     if (!texture)
-        return false;
-
-    _textures[fileName] = texture;
-    return true;
+        throw std::runtime_error("Failed to load texture from " + fileName);
+    setTexture(texture, type);
 }
 
-void Material::setTexture(const std::string& fileName, const TextureType& type)
+void Material::setTexture(const Texture2DPtr& texture, const TextureType& type)
 {
-    if (_textures.find(fileName) == _textures.end())
-        if (!_loadTexture(fileName))
-            throw std::runtime_error("Failed to load texture from " + fileName);
-    _textureDescriptors[type] = _textures[fileName];
+    _textures[texture->getFilename()] = texture;
+    _textureDescriptors[type] = texture;
     markModified();
 }
 }
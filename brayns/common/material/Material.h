@@ -31,6 +31,8 @@ SERIALIZATION_ACCESS(Material)
 
 namespace brayns
 {
+class TextureCache;
+
 enum TextureType
 {
     TT_DIFFUSE = 0,
@@ -111,14 +113,19 @@ public:
     {
         return _textureDescriptors;
     }
-    BRAYNS_API void setTexture(const std::string& fileName,
+    /**
+     * Sets the texture of the given file, loaded through the cache so it is
+     * shared with other materials. Throws if the file cannot be loaded.
+     */
+    BRAYNS_API void setTexture(TextureCache& cache, const std::string& fileName,
+                               const TextureType& type);
+    /** Sets a texture shared with other materials, see TextureCache */
+    BRAYNS_API void setTexture(const Texture2DPtr& texture,
                                const TextureType& type);
 
     BRAYNS_API Texture2DPtr getTexture(const TextureType& type) const;
 
 protected:
-    bool _loadTexture(const std::string& fileName);
-
     std::string _name{"undefined"};
     Vector3d _diffuseColor{1., 1., 1.};
     Vector3d _specularColor{1., 1., 1.};
@@ -45,6 +45,10 @@ public:
     BRAYNS_API unsigned char* getRawData() { return _rawData.data(); }
     BRAYNS_API void setRawData(unsigned char* data, size_t size);
 
+    const std::vector<unsigned char>& getData() const { return _rawData; }
+    /** @return the size in bytes of the texels */
+    size_t getSizeInBytes() const { return _rawData.size(); }
+
 private:
     std::string _filename;
     size_t _nbChannels;                  // Number of color channels per pixel
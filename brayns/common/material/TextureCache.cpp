@@ -0,0 +1,180 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "TextureCache.h"
+
+#include <brayns/common/ImageManager.h>
+#include <brayns/common/log.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+
+namespace
+{
+std::string canonicalPath(const std::string& filename)
+{
+    boost::system::error_code error;
+    const auto path = boost::filesystem::canonical(filename, error);
+    return error ? filename : path.string();
+}
+
+bool sameContent(const brayns::Texture2D& a, const brayns::Texture2D& b)
+{
+    return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight() &&
+           a.getNbChannels() == b.getNbChannels() &&
+           a.getDepth() == b.getDepth() && a.getData() == b.getData();
+}
+
+/** FNV-1a hash of the texture format and texels */
+uint64_t contentHash(brayns::Texture2D& texture)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const auto combine = [&hash](const uint64_t value) {
+        hash = (hash ^ value) * 1099511628211ull;
+    };
+    combine(texture.getWidth());
+    combine(texture.getHeight());
+    combine(texture.getNbChannels());
+    combine(texture.getDepth());
+
+    const size_t size = texture.getWidth() * texture.getHeight() *
+                        texture.getNbChannels() * texture.getDepth();
+    const auto data = texture.getRawData();
+    for (size_t i = 0; i < size; ++i)
+        combine(data[i]);
+    return hash;
+}
+
+brayns::Texture2DPtr decode(const std::string& path, uint64_t& hash)
+{
+    auto texture = brayns::ImageManager::importTextureFromFile(path);
+    if (!texture)
+        return nullptr;
+    texture->setFilename(path);
+    hash = contentHash(*texture);
+    return texture;
+}
+}
+
+namespace brayns
+{
+Texture2DPtr TextureCache::get(const std::string& filename)
+{
+    return get(strings{filename})[0];
+}
+
+std::vector<Texture2DPtr> TextureCache::get(const strings& filenames)
+{
+    std::vector<Texture2DPtr> textures(filenames.size());
+    strings paths(filenames.size());
+    for (size_t i = 0; i < filenames.size(); ++i)
+    {
+        paths[i] = canonicalPath(filenames[i]);
+        textures[i] = _find(paths[i]);
+    }
+
+    // decode each missing file once
+    strings missingPaths;
+    for (size_t i = 0; i < paths.size(); ++i)
+        if (!textures[i])
+            missingPaths.push_back(paths[i]);
+    std::sort(missingPaths.begin(), missingPaths.end());
+    missingPaths.erase(std::unique(missingPaths.begin(), missingPaths.end()),
+                       missingPaths.end());
+
+    std::vector<Texture2DPtr> decoded(missingPaths.size());
+    std::vector<uint64_t> hashes(missingPaths.size(), 0);
+#pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < missingPaths.size(); ++i)
+        decoded[i] = decode(missingPaths[i], hashes[i]);
+
+    for (size_t i = 0; i < missingPaths.size(); ++i)
+    {
+        if (decoded[i])
+            decoded[i] = _insert(missingPaths[i], decoded[i], hashes[i]);
+        else
+            BRAYNS_ERROR << "Failed to load texture " << missingPaths[i]
+                         << std::endl;
+    }
+
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        if (textures[i])
+            continue;
+        const auto missing = std::lower_bound(missingPaths.begin(),
+                                              missingPaths.end(), paths[i]);
+        textures[i] = decoded[missing - missingPaths.begin()];
+    }
+    return textures;
+}
+
+size_t TextureCache::getSizeInBytes() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t size = 0;
+    for (const auto& i : _contentTextures)
+        if (const auto texture = i.second.lock())
+            size += texture->getSizeInBytes();
+    return size;
+}
+
+Texture2DPtr TextureCache::_find(const std::string& path) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto i = _pathTextures.find(path);
+    return i == _pathTextures.end() ? nullptr : i->second.lock();
+}
+
+Texture2DPtr TextureCache::_insert(const std::string& path,
+                                   Texture2DPtr texture, const uint64_t hash)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // forget the textures that are not used anymore
+    for (auto i = _pathTextures.begin(); i != _pathTextures.end();)
+        i = i->second.expired() ? _pathTextures.erase(i) : std::next(i);
+    for (auto i = _contentTextures.begin(); i != _contentTextures.end();)
+        i = i->second.expired() ? _contentTextures.erase(i) : std::next(i);
+
+    // same image from another file, or decoded concurrently. The hash only
+    // selects the candidates, the texels are compared to rule out collisions.
+    bool shared = false;
+    const auto candidates = _contentTextures.equal_range(hash);
+    for (auto i = candidates.first; i != candidates.second; ++i)
+    {
+        auto existing = i->second.lock();
+        if (existing && sameContent(*existing, *texture))
+        {
+            texture = existing;
+            shared = true;
+            break;
+        }
+    }
+    if (!shared)
+        _contentTextures.emplace(hash, texture);
+
+    _pathTextures[path] = texture;
+    BRAYNS_DEBUG << path << ": " << texture->getWidth() << "x"
+                 << texture->getHeight() << "x" << texture->getNbChannels()
+                 << std::endl;
+    return texture;
+}
+}
@@ -0,0 +1,65 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/material/Texture2D.h>
+#include <brayns/common/types.h>
+
+#include <mutex>
+
+namespace brayns
+{
+/**
+ * Scene-wide cache of the textures loaded from files. Textures are shared by
+ * canonical path, and by content for identical images stored in different
+ * files. The cache does not own the textures: a texture is released when the
+ * last material using it is destroyed.
+ */
+class TextureCache
+{
+public:
+    /**
+     * @return the texture of the given file, decoded if it is not in use yet,
+     *         nullptr if the file cannot be loaded
+     */
+    BRAYNS_API Texture2DPtr get(const std::string& filename);
+
+    /**
+     * Decodes the files that are not in use yet in parallel.
+     * @return the textures in the order of the given files, nullptr for the
+     *         files that cannot be loaded
+     */
+    BRAYNS_API std::vector<Texture2DPtr> get(const strings& filenames);
+
+    /** @return the size in bytes of the textures in use */
+    BRAYNS_API size_t getSizeInBytes() const;
+
+private:
+    Texture2DPtr _find(const std::string& path) const;
+    Texture2DPtr _insert(const std::string& path, Texture2DPtr texture,
+                         const uint64_t hash);
+
+    std::map<std::string, std::weak_ptr<Texture2D>> _pathTextures;
+    std::multimap<uint64_t, std::weak_ptr<Texture2D>> _contentTextures;
+    mutable std::mutex _mutex;
+};
+}
@@ -0,0 +1,135 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "CellMask.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace brayns
+{
+void CellMask::resize(const size_t nbCells)
+{
+    const auto allSections = static_cast<uint8_t>(MorphologySectionType::all);
+    _selection.assign(nbCells, allSections);
+    _data.assign(nbCells, allSections);
+    _simulationValues.clear();
+    markModified();
+}
+
+void CellMask::setCellIds(uint64_ts ids)
+{
+    if (!ids.empty() && ids.size() != _selection.size())
+        throw std::runtime_error("Number of cell ids does not match the mask");
+    _cellIds = std::move(ids);
+}
+
+void CellMask::setSimulationOffsets(uint64_ts offsets)
+{
+    if (!offsets.empty() && offsets.size() != _selection.size())
+        throw std::runtime_error(
+            "Number of simulation offsets does not match the mask");
+    _simulationOffsets = std::move(offsets);
+    _simulationValues.clear();
+}
+
+size_t CellMask::setVisibleSections(const uint64_ts& ids,
+                                    const uint8_t sectionTypes,
+                                    const bool isolate)
+{
+    size_t unknownIds = 0;
+    if (ids.empty())
+        std::fill(_selection.begin(), _selection.end(), sectionTypes);
+    else
+    {
+        if (isolate)
+            std::fill(_selection.begin(), _selection.end(), 0);
+
+        for (const auto id : ids)
+        {
+            size_t index = id;
+            if (!_cellIds.empty())
+            {
+                const auto i =
+                    std::lower_bound(_cellIds.begin(), _cellIds.end(), id);
+                if (i == _cellIds.end() || *i != id)
+                {
+                    ++unknownIds;
+                    continue;
+                }
+                index = std::distance(_cellIds.begin(), i);
+            }
+
+            if (index >= _selection.size())
+            {
+                ++unknownIds;
+                continue;
+            }
+            _selection[index] = sectionTypes;
+        }
+    }
+
+    _update();
+    return unknownIds;
+}
+
+void CellMask::setSimulationRange(const bool enabled, const Vector2f& range)
+{
+    _useSimulationRange = enabled;
+    _simulationRange = range;
+    _update();
+}
+
+void CellMask::applySimulationFrame(const float* frame,
+                                    const uint64_t frameSize)
+{
+    if (!frame || _simulationOffsets.empty())
+        return;
+
+    _simulationValues.resize(_simulationOffsets.size());
+    for (size_t i = 0; i < _simulationOffsets.size(); ++i)
+    {
+        const auto offset = _simulationOffsets[i];
+        _simulationValues[i] = offset < frameSize
+                                   ? frame[offset]
+                                   : std::numeric_limits<float>::quiet_NaN();
+    }
+
+    if (_useSimulationRange)
+        _update();
+}
+
+void CellMask::_update()
+{
+    const bool useRange =
+        _useSimulationRange && _simulationValues.size() == _selection.size();
+
+    for (size_t i = 0; i < _selection.size(); ++i)
+    {
+        // NaN values (cells without simulation data) fail the range test
+        const bool inRange = !useRange ||
+                             (_simulationValues[i] >= _simulationRange.x() &&
+                              _simulationValues[i] <= _simulationRange.y());
+        _data[i] = inRange ? _selection[i] : 0;
+    }
+    markModified();
+}
+}
@@ -0,0 +1,109 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/BaseObject.h>
+#include <brayns/common/geometry/CellTag.h>
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * Per-primitive cell tags (see CellTag.h). For a given material, the tags are
+ * either empty or indexed like the primitives of that material. SDF geometry
+ * tags are indexed like the global SDF geometries.
+ */
+struct CellTags
+{
+    std::map<size_t, uint32_ts> spheres;
+    std::map<size_t, uint32_ts> cylinders;
+    std::map<size_t, uint32_ts> cones;
+    uint32_ts sdfGeometries;
+};
+
+/**
+ * The CellMask holds one byte per cell of a model, where each bit tells if the
+ * corresponding MorphologySectionType of the cell is visible. The buffer is
+ * shared with the intersection kernels of the renderer, so updating the mask
+ * does not require the geometry, nor the acceleration structures, to be
+ * rebuilt.
+ *
+ * The mask is the combination of a selection, set by the user, and an optional
+ * simulation range: when enabled, only cells whose current simulation value
+ * (at the first compartment of the cell) is within the range are visible.
+ */
+class CellMask : public BaseObject
+{
+public:
+    /** Resets the mask for the given number of cells, all being visible */
+    BRAYNS_API void resize(const size_t nbCells);
+
+    size_t getNbCells() const { return _selection.size(); }
+    /**
+     * Sets the identifiers (typically GIDs) of the cells, in mask order. Ids
+     * must be sorted. If no ids are set, cells are selected by index.
+     */
+    BRAYNS_API void setCellIds(uint64_ts ids);
+
+    /** Sets the offsets of the cells in the simulation frames */
+    BRAYNS_API void setSimulationOffsets(uint64_ts offsets);
+
+    /**
+     * Sets the visible section types of the given cells.
+     * @param ids Ids, or indices, of the cells. All cells if empty
+     * @param sectionTypes Bitmask of visible MorphologySectionType, 0 hides the
+     *        cells
+     * @param isolate If true, the cells that are not selected are hidden
+     * @return the number of ids that do not match any cell
+     */
+    BRAYNS_API size_t setVisibleSections(const uint64_ts& ids,
+                                         const uint8_t sectionTypes,
+                                         const bool isolate);
+
+    /**
+     * Enables or disables the simulation range. The range is applied to the
+     * values of the last frame given to applySimulationFrame().
+     */
+    BRAYNS_API void setSimulationRange(const bool enabled,
+                                       const Vector2f& range);
+    bool getUseSimulationRange() const { return _useSimulationRange; }
+    /**
+     * Gathers the values of the cells from the given simulation frame and
+     * updates the mask if a simulation range is enabled.
+     */
+    BRAYNS_API void applySimulationFrame(const float* frame,
+                                         const uint64_t frameSize);
+
+    /** @return the buffer read by the intersection kernels */
+    const uint8_ts& getData() const { return _data; }
+private:
+    void _update();
+
+    uint8_ts _selection;
+    uint8_ts _data;
+    uint64_ts _cellIds;
+    uint64_ts _simulationOffsets;
+    floats _simulationValues;
+    bool _useSimulationRange{false};
+    Vector2f _simulationRange;
+};
+}
@@ -28,8 +28,144 @@
 
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <set>
 
+#include <omp.h>
+
+namespace
+{
+using namespace brayns;
+
+/**
+ * Below this number of elements, starting the threads costs more than the
+ * loops they share, e.g. for a single fibre or a section of a morphology
+ */
+const size_t MIN_PARALLEL_SIZE = 4096;
+
+void mergeBounds(Boxd& bounds, const Sphere& sphere)
+{
+    bounds.merge(sphere.center + sphere.radius);
+    bounds.merge(sphere.center - sphere.radius);
+}
+
+void mergeBounds(Boxd& bounds, const Cylinder& cylinder)
+{
+    bounds.merge(cylinder.center);
+    bounds.merge(cylinder.up);
+}
+
+void mergeBounds(Boxd& bounds, const Cone& cone)
+{
+    bounds.merge(cone.center);
+    bounds.merge(cone.up);
+}
+
+void mergeBounds(Boxd& bounds, const Vector3f& vertex)
+{
+    bounds.merge(vertex);
+}
+
+void mergeBounds(Boxd& bounds, const SDFGeometry& geom)
+{
+    bounds.merge(getSDFBoundingBox(geom));
+}
+
+/** Streamline vertex with its radius in w */
+void mergeBounds(Boxd& bounds, const Vector4f& vertex)
+{
+    const Vector3f position(vertex.x(), vertex.y(), vertex.z());
+    bounds.merge(position + vertex.w());
+    bounds.merge(position - vertex.w());
+}
+
+void mergeBounds(Boxd& bounds, const SDFSphere& sphere)
+{
+    bounds.merge(sphere.center + sphere.radius);
+    bounds.merge(sphere.center - sphere.radius);
+}
+
+void mergeBounds(Boxd& bounds, const SDFPill& pill)
+{
+    bounds.merge(pill.p0 + pill.radius);
+    bounds.merge(pill.p0 - pill.radius);
+    bounds.merge(pill.p1 + pill.radius);
+    bounds.merge(pill.p1 - pill.radius);
+}
+
+void mergeBounds(Boxd& bounds, const SDFConePill& cone)
+{
+    bounds.merge(cone.p0 + cone.radius);
+    bounds.merge(cone.p0 - cone.radius);
+    bounds.merge(cone.p1 + cone.radiusTip);
+    bounds.merge(cone.p1 - cone.radiusTip);
+}
+
+/** @return the union of the bounds computed by each thread */
+Boxd mergeThreadBounds(const std::vector<Boxd>& threadBounds)
+{
+    Boxd bounds;
+    for (const auto& box : threadBounds)
+        bounds.merge(box);
+    return bounds;
+}
+
+/**
+ * Parallel reduction of the bounds of the given primitives. The bounds of each
+ * thread are merged after the parallel region rather than in a critical
+ * section: the primitives are also added from critical sections of the
+ * loaders, and the unnamed critical sections share the same lock.
+ */
+template <typename PrimitivesT>
+Boxd computeBounds(const PrimitivesT& primitives)
+{
+    std::vector<Boxd> threadBounds(omp_get_max_threads());
+#pragma omp parallel if (primitives.size() > MIN_PARALLEL_SIZE)
+    {
+        auto& bounds = threadBounds[omp_get_thread_num()];
+#pragma omp for
+        for (size_t i = 0; i < primitives.size(); ++i)
+            mergeBounds(bounds, primitives[i]);
+    }
+    return mergeThreadBounds(threadBounds);
+}
+
+/**
+ * Computes the bounds of the dirty materials again, and returns the bounds of
+ * all materials.
+ */
+template <typename MaterialBoundsT, typename PrimitivesMapT>
+Boxd updateMaterialBounds(MaterialBoundsT& materialBounds,
+                          const PrimitivesMapT& primitivesMap)
+{
+    if (materialBounds.allDirty)
+    {
+        materialBounds.materials.clear();
+        for (const auto& primitives : primitivesMap)
+            materialBounds.dirtyMaterials.insert(primitives.first);
+    }
+
+    for (const auto materialId : materialBounds.dirtyMaterials)
+    {
+        const auto primitives = primitivesMap.find(materialId);
+        if (primitives == primitivesMap.end())
+            materialBounds.materials.erase(materialId);
+        else
+            materialBounds.materials[materialId] =
+                computeBounds(primitives->second);
+    }
+    materialBounds.dirtyMaterials.clear();
+    materialBounds.allDirty = false;
+
+    Boxd bounds;
+    for (const auto& i : materialBounds.materials)
+        if (i.first != BOUNDINGBOX_MATERIAL_ID)
+            bounds.merge(i.second);
+    return bounds;
+}
+}
+
 namespace brayns
 {
 ModelParams::ModelParams(const std::string& path)
@@ -144,54 +280,154 @@ bool Model::empty() const
            _streamlines.empty() && _volumes.empty() && _bounds.isEmpty();
 }
 
+bool Model::isCacheable() const
+{
+    if (!_sdf.geometries.empty() || !_streamlines.empty() ||
+        !_volumes.empty() || _cellMask.getNbCells() != 0 ||
+        !_cellTags.spheres.empty() || !_cellTags.cylinders.empty() ||
+        !_cellTags.cones.empty() || !_cellTags.sdfGeometries.empty())
+    {
+        return false;
+    }
+    return std::all_of(_materials.begin(), _materials.end(),
+                       [](const auto& material) {
+                           return material.second->getTextureDescriptors()
+                               .empty();
+                       });
+}
+
 uint64_t Model::addSphere(const size_t materialId, const Sphere& sphere)
 {
     _spheresDirty = true;
+    mergeBounds(_sphereBounds.materials[materialId], sphere);
     _spheres[materialId].push_back(sphere);
     return _spheres[materialId].size() - 1;
 }
 
+uint64_t Model::addSpheres(const size_t materialId, const Spheres& spheres)
+{
+    _spheresDirty = true;
+    _sphereBounds.materials[materialId].merge(computeBounds(spheres));
+    auto& modelSpheres = _spheres[materialId];
+    const uint64_t index = modelSpheres.size();
+    modelSpheres.insert(modelSpheres.end(), spheres.begin(), spheres.end());
+    return index;
+}
+
 uint64_t Model::addCylinder(const size_t materialId, const Cylinder& cylinder)
 {
     _cylindersDirty = true;
+    mergeBounds(_cylindersBounds.materials[materialId], cylinder);
     _cylinders[materialId].push_back(cylinder);
     return _cylinders[materialId].size() - 1;
 }
 
+uint64_t Model::addCylinders(const size_t materialId,
+                             const Cylinders& cylinders)
+{
+    _cylindersDirty = true;
+    _cylindersBounds.materials[materialId].merge(computeBounds(cylinders));
+    auto& modelCylinders = _cylinders[materialId];
+    const uint64_t index = modelCylinders.size();
+    modelCylinders.insert(modelCylinders.end(), cylinders.begin(),
+                          cylinders.end());
+    return index;
+}
+
 uint64_t Model::addCone(const size_t materialId, const Cone& cone)
 {
     _conesDirty = true;
+    mergeBounds(_conesBounds.materials[materialId], cone);
     _cones[materialId].push_back(cone);
     return _cones[materialId].size() - 1;
 }
 
+uint64_t Model::addCones(const size_t materialId, const Cones& cones)
+{
+    _conesDirty = true;
+    _conesBounds.materials[materialId].merge(computeBounds(cones));
+    auto& modelCones = _cones[materialId];
+    const uint64_t index = modelCones.size();
+    modelCones.insert(modelCones.end(), cones.begin(), cones.end());
+    return index;
+}
+
 void Model::addStreamline(const size_t materialId, const Streamline& streamline)
 {
-    if (streamline.position.size() < 2)
-        throw std::runtime_error(
-            "Number of vertices is less than two which is minimum needed for a "
-            "streamline.");
+    addStreamlines(materialId, streamline.position, streamline.color,
+                   streamline.radius, {0});
+}
+
+void Model::addStreamlines(const size_t materialId, const Vector3fs& vertices,
+                           const Vector4fs& colors, const floats& radii,
+                           const uint64_ts& offsets)
+{
+    if (offsets.empty())
+        return;
 
-    if (streamline.position.size() != streamline.color.size())
+    if (offsets.front() != 0)
+        throw std::runtime_error("First streamline does not start at 0.");
+
+    for (size_t i = 0; i < offsets.size(); ++i)
+    {
+        const uint64_t end =
+            i + 1 < offsets.size() ? offsets[i + 1] : vertices.size();
+        if (end < offsets[i] + 2)
+            throw std::runtime_error(
+                "Number of vertices is less than two which is minimum needed "
+                "for a streamline.");
+    }
+
+    if (vertices.size() != colors.size())
         throw std::runtime_error("Number of vertices and colors do not match.");
 
-    if (streamline.position.size() != streamline.radius.size())
+    if (vertices.size() != radii.size())
         throw std::runtime_error("Number of vertices and radii do not match.");
 
     auto& streamlinesData = _streamlines[materialId];
 
-    const size_t startIndex = streamlinesData.vertex.size();
-    const size_t endIndex = startIndex + streamline.position.size() - 1;
-
-    for (size_t index = startIndex; index < endIndex; ++index)
-        streamlinesData.indices.push_back(index);
-
-    for (size_t i = 0; i < streamline.position.size(); i++)
-        streamlinesData.vertex.push_back(
-            Vector4f(streamline.position[i], streamline.radius[i]));
+    const size_t startVertex = streamlinesData.vertex.size();
+    const size_t startIndex = streamlinesData.indices.size();
+    if (startVertex + vertices.size() >
+        size_t(std::numeric_limits<int32_t>::max()))
+        throw std::runtime_error("Too many streamline vertices for material " +
+                                 std::to_string(materialId));
+
+    streamlinesData.vertex.resize(startVertex + vertices.size());
+    streamlinesData.vertexColor.insert(streamlinesData.vertexColor.end(),
+                                       colors.begin(), colors.end());
+    streamlinesData.indices.resize(startIndex + vertices.size() -
+                                   offsets.size());
+
+    // reduced without a critical section, see computeBounds()
+    std::vector<Boxd> threadBounds(omp_get_max_threads());
+#pragma omp parallel if (vertices.size() > MIN_PARALLEL_SIZE)
+    {
+        auto& bounds = threadBounds[omp_get_thread_num()];
+#pragma omp for nowait
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const auto& pos = vertices[i];
+            const float radius = radii[i];
+            bounds.merge(pos + radius);
+            bounds.merge(pos - radius);
+            streamlinesData.vertex[startVertex + i] = Vector4f(pos, radius);
+        }
 
-    for (const auto& color : streamline.color)
-        streamlinesData.vertexColor.push_back(color);
+        // streamline i has offsets[i] - i links before it, one less than its
+        // number of vertices for each previous streamline
+#pragma omp for nowait
+        for (size_t i = 0; i < offsets.size(); ++i)
+        {
+            const uint64_t end =
+                i + 1 < offsets.size() ? offsets[i + 1] : vertices.size();
+            auto index = streamlinesData.indices.begin() + startIndex +
+                         (offsets[i] - i);
+            for (uint64_t j = offsets[i]; j + 1 < end; ++j)
+                *index++ = startVertex + j;
+        }
+    }
+    _streamlinesBounds.merge(mergeThreadBounds(threadBounds));
 
     _streamlinesDirty = true;
 }
@@ -200,9 +436,39 @@ uint64_t Model::addSDFGeometry(const size_t materialId, const SDFGeometry& geom,
                                const std::vector<size_t>& neighbourIndices)
 {
     const uint64_t geomIdx = _sdf.geometries.size();
+    if (geomIdx >= std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error("Too many SDF geometries in model");
+
+    SDFGeometryInfo info;
+    info.textureCoords = geom.textureCoords;
+    info.timestamp = geom.timestamp;
+    info.neighboursIndex = 0;
+    info.numNeighbours = 0;
+    info.type = geom.type;
+    switch (geom.type)
+    {
+    case SDFType::Sphere:
+        info.index = _sdf.spheres.size();
+        _sdf.spheres.push_back({geom.center, geom.radius});
+        break;
+    case SDFType::Pill:
+        info.index = _sdf.pills.size();
+        _sdf.pills.push_back({geom.p0, geom.p1, geom.radius});
+        break;
+    case SDFType::ConePill:
+    case SDFType::ConePillSigmoid:
+        info.index = _sdf.conePills.size();
+        _sdf.conePills.push_back(
+            {geom.p0, geom.p1, geom.radius, geom.radius_tip});
+        break;
+    default:
+        throw std::runtime_error("Unknown SDF type.");
+    }
+    _setSDFGeometryNeighbours(info, neighbourIndices);
+
     _sdf.geometryIndices[materialId].push_back(geomIdx);
-    _sdf.neighbours.push_back(neighbourIndices);
-    _sdf.geometries.push_back(geom);
+    _sdf.geometries.push_back(info);
+    _sdfGeometriesBounds.merge(getSDFBoundingBox(geom));
     _sdfGeometriesDirty = true;
     return geomIdx;
 }
@@ -210,8 +476,35 @@ uint64_t Model::addSDFGeometry(const size_t materialId, const SDFGeometry& geom,
 void Model::updateSDFGeometryNeighbours(
     size_t geometryIdx, const std::vector<size_t>& neighbourIndices)
 {
-    _sdf.neighbours[geometryIdx] = neighbourIndices;
+    _setSDFGeometryNeighbours(_sdf.geometries[geometryIdx], neighbourIndices);
+    _sdfGeometriesDirty = true;
+}
+
+void Model::clearSDFGeometries()
+{
+    _sdf = SDFGeometryData();
+    _cellTags.sdfGeometries.clear();
     _sdfGeometriesDirty = true;
+    _sdfGeometriesBoundsDirty = true;
+}
+
+void Model::_setSDFGeometryNeighbours(
+    SDFGeometryInfo& geometry, const std::vector<size_t>& neighbourIndices)
+{
+    const auto numNeighbours =
+        std::min<size_t>(neighbourIndices.size(),
+                         std::numeric_limits<uint8_t>::max());
+
+    // reuse the range of the previous neighbours if the new ones fit in,
+    // otherwise append them
+    if (numNeighbours > geometry.numNeighbours)
+        geometry.neighboursIndex = _sdf.neighbours.size();
+    if (geometry.neighboursIndex + numNeighbours > _sdf.neighbours.size())
+        _sdf.neighbours.resize(geometry.neighboursIndex + numNeighbours);
+
+    for (size_t i = 0; i < numNeighbours; ++i)
+        _sdf.neighbours[geometry.neighboursIndex + i] = neighbourIndices[i];
+    geometry.numNeighbours = numNeighbours;
 }
 
 void Model::addVolume(VolumePtr volume)
@@ -396,50 +689,62 @@ void Model::updateSizeInBytes()
         _sizeInBytes += mesh.indices.size() * sizeof(Vector3ui);
         _sizeInBytes += mesh.textureCoordinates.size() * sizeof(Vector2f);
     }
+    for (const auto& streamlines : _streamlines)
+    {
+        const auto& data = streamlines.second;
+        _sizeInBytes += data.vertex.size() * sizeof(Vector4f);
+        _sizeInBytes += data.vertexColor.size() * sizeof(Vector4f);
+        _sizeInBytes += data.indices.size() * sizeof(int32_t);
+    }
     for (const auto& volume : _volumes)
         _sizeInBytes += volume->getSizeInBytes();
+
+    const auto tagsSize = [](const std::map<size_t, uint32_ts>& tags) {
+        size_t size = 0;
+        for (const auto& materialTags : tags)
+            size += materialTags.second.size() * sizeof(uint32_t);
+        return size;
+    };
+    _sizeInBytes += tagsSize(_cellTags.spheres);
+    _sizeInBytes += tagsSize(_cellTags.cylinders);
+    _sizeInBytes += tagsSize(_cellTags.cones);
+    _sizeInBytes += _cellTags.sdfGeometries.size() * sizeof(uint32_t);
+    _sizeInBytes += _sdf.geometries.size() * sizeof(SDFGeometryInfo);
+    _sizeInBytes += _sdf.spheres.size() * sizeof(SDFSphere);
+    _sizeInBytes += _sdf.pills.size() * sizeof(SDFPill);
+    _sizeInBytes += _sdf.conePills.size() * sizeof(SDFConePill);
+    _sizeInBytes += tagsSize(_sdf.geometryIndices);
+    _sizeInBytes += _sdf.neighbours.size() * sizeof(uint32_t);
+    _sizeInBytes += _cellMask.getNbCells() * sizeof(uint8_t);
 }
 
 void Model::_updateBounds()
 {
-    if (_spheresDirty)
+    // appended streamlines and SDF geometries merge their bounds right away,
+    // they are only computed again after some were modified or removed
+    if (_streamlinesBoundsDirty)
     {
-        _spheresDirty = false;
-        _sphereBounds.reset();
-        for (const auto& spheres : _spheres)
-            if (spheres.first != BOUNDINGBOX_MATERIAL_ID)
-                for (const auto& sphere : spheres.second)
-                {
-                    _sphereBounds.merge(sphere.center + sphere.radius);
-                    _sphereBounds.merge(sphere.center - sphere.radius);
-                }
+        _streamlinesBoundsDirty = false;
+        _streamlinesBounds.reset();
+        for (const auto& streamlines : _streamlines)
+            _streamlinesBounds.merge(
+                computeBounds(streamlines.second.vertex));
     }
 
-    if (_cylindersDirty)
+    if (_sdfGeometriesBoundsDirty)
     {
-        _cylindersDirty = false;
-        _cylindersBounds.reset();
-        for (const auto& cylinders : _cylinders)
-            if (cylinders.first != BOUNDINGBOX_MATERIAL_ID)
-                for (const auto& cylinder : cylinders.second)
-                {
-                    _cylindersBounds.merge(cylinder.center);
-                    _cylindersBounds.merge(cylinder.up);
-                }
+        _sdfGeometriesBoundsDirty = false;
+        _sdfGeometriesBounds.reset();
+        _sdfGeometriesBounds.merge(computeBounds(_sdf.spheres));
+        _sdfGeometriesBounds.merge(computeBounds(_sdf.pills));
+        _sdfGeometriesBounds.merge(computeBounds(_sdf.conePills));
     }
 
-    if (_conesDirty)
-    {
-        _conesDirty = false;
-        _conesBounds.reset();
-        for (const auto& cones : _cones)
-            if (cones.first != BOUNDINGBOX_MATERIAL_ID)
-                for (const auto& cone : cones.second)
-                {
-                    _conesBounds.merge(cone.center);
-                    _conesBounds.merge(cone.up);
-                }
-    }
+    _spheresDirty = false;
+    _cylindersDirty = false;
+    _conesDirty = false;
+    _streamlinesDirty = false;
+    _sdfGeometriesDirty = false;
 
     if (_trianglesMeshesDirty)
     {
@@ -447,33 +752,8 @@ void Model::_updateBounds()
         _trianglesMeshesBounds.reset();
         for (const auto& mesh : _trianglesMeshes)
             if (mesh.first != BOUNDINGBOX_MATERIAL_ID)
-                for (const auto& vertex : mesh.second.vertices)
-                    _trianglesMeshesBounds.merge(vertex);
-    }
-
-    if (_streamlinesDirty)
-    {
-        _streamlinesDirty = false;
-        _streamlinesBounds.reset();
-        for (const auto& streamline : _streamlines)
-            for (size_t index = 0; index < streamline.second.vertex.size();
-                 ++index)
-            {
-                const auto& pos =
-                    streamline.second.vertex[index].get_sub_vector<3, 0>();
-                const float radius = streamline.second.vertex[index][3];
-                const auto radiusVec = Vector3f(radius, radius, radius);
-                _streamlinesBounds.merge(pos + radiusVec);
-                _streamlinesBounds.merge(pos - radiusVec);
-            }
-    }
-
-    if (_sdfGeometriesDirty)
-    {
-        _sdfGeometriesDirty = false;
-        _sdfGeometriesBounds.reset();
-        for (const auto& geom : _sdf.geometries)
-            _sdfGeometriesBounds.merge(getSDFBoundingBox(geom));
+                _trianglesMeshesBounds.merge(
+                    computeBounds(mesh.second.vertices));
     }
 
     if (_volumesDirty)
@@ -485,9 +765,9 @@ void Model::_updateBounds()
     }
 
     _bounds.reset();
-    _bounds.merge(_sphereBounds);
-    _bounds.merge(_cylindersBounds);
-    _bounds.merge(_conesBounds);
+    _bounds.merge(updateMaterialBounds(_sphereBounds, _spheres));
+    _bounds.merge(updateMaterialBounds(_cylindersBounds, _cylinders));
+    _bounds.merge(updateMaterialBounds(_conesBounds, _cones));
     _bounds.merge(_trianglesMeshesBounds);
     _bounds.merge(_streamlinesBounds);
     _bounds.merge(_sdfGeometriesBounds);
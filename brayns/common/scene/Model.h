@@ -31,8 +31,11 @@
 #include <brayns/common/geometry/Sphere.h>
 #include <brayns/common/geometry/Streamline.h>
 #include <brayns/common/geometry/TrianglesMesh.h>
+#include <brayns/common/scene/CellMask.h>
 #include <brayns/common/types.h>
 
+#include <set>
+
 SERIALIZATION_ACCESS(Model)
 SERIALIZATION_ACCESS(ModelParams)
 SERIALIZATION_ACCESS(ModelDescriptor)
@@ -198,6 +201,13 @@ public:
      */
     BRAYNS_API bool empty() const;
 
+    /**
+     * @return true if the model only holds what Scene::saveToCacheFile()
+     *         writes: spheres, cylinders, cones, meshes and untextured
+     *         materials
+     */
+    BRAYNS_API bool isCacheable() const;
+
     /** @return true if the geometry Model is dirty, false otherwise */
     BRAYNS_API bool dirty() const;
 
@@ -212,8 +222,19 @@ public:
     SpheresMap& getSpheres()
     {
         _spheresDirty = true;
+        _sphereBounds.allDirty = true;
         return _spheres;
     }
+    /**
+        Returns the spheres of one material. Only the bounds of that material
+        are computed again on the next commit.
+    */
+    Spheres& getSpheres(const size_t materialId)
+    {
+        _spheresDirty = true;
+        _sphereBounds.dirtyMaterials.insert(materialId);
+        return _spheres[materialId];
+    }
     /**
       Adds a sphere to the model
       @param materialId Id of the material for the sphere
@@ -223,6 +244,15 @@ public:
     BRAYNS_API uint64_t addSphere(const size_t materialId,
                                   const Sphere& sphere);
 
+    /**
+      Appends spheres to the model
+      @param materialId Id of the material for the spheres
+      @param spheres Spheres to add
+      @return Index of the first added sphere for the specified material
+      */
+    BRAYNS_API uint64_t addSpheres(const size_t materialId,
+                                   const Spheres& spheres);
+
     /**
         Returns cylinders handled by the model
       */
@@ -230,8 +260,15 @@ public:
     CylindersMap& getCylinders()
     {
         _cylindersDirty = true;
+        _cylindersBounds.allDirty = true;
         return _cylinders;
     }
+    Cylinders& getCylinders(const size_t materialId)
+    {
+        _cylindersDirty = true;
+        _cylindersBounds.dirtyMaterials.insert(materialId);
+        return _cylinders[materialId];
+    }
     /**
       Adds a cylinder to the model
       @param materialId Id of the material for the cylinder
@@ -240,6 +277,14 @@ public:
       */
     BRAYNS_API uint64_t addCylinder(const size_t materialId,
                                     const Cylinder& cylinder);
+    /**
+      Appends cylinders to the model
+      @param materialId Id of the material for the cylinders
+      @param cylinders Cylinders to add
+      @return Index of the first added cylinder for the specified material
+      */
+    BRAYNS_API uint64_t addCylinders(const size_t materialId,
+                                     const Cylinders& cylinders);
     /**
         Returns cones handled by the model
     */
@@ -247,8 +292,15 @@ public:
     ConesMap& getCones()
     {
         _conesDirty = true;
+        _conesBounds.allDirty = true;
         return _cones;
     }
+    Cones& getCones(const size_t materialId)
+    {
+        _conesDirty = true;
+        _conesBounds.dirtyMaterials.insert(materialId);
+        return _cones[materialId];
+    }
     /**
       Adds a cone to the model
       @param materialId Id of the material for thecone
@@ -257,6 +309,14 @@ public:
       */
     BRAYNS_API uint64_t addCone(const size_t materialId, const Cone& cone);
 
+    /**
+      Appends cones to the model
+      @param materialId Id of the material for the cones
+      @param cones Cones to add
+      @return Index of the first added cone for the specified material
+      */
+    BRAYNS_API uint64_t addCones(const size_t materialId, const Cones& cones);
+
     /**
       Adds a streamline to the model
       @param materialId Id of the material for the streamline
@@ -265,6 +325,37 @@ public:
     BRAYNS_API void addStreamline(const size_t materialId,
                                   const Streamline& streamline);
 
+    /**
+      Appends streamlines stored in flat arrays to the model. The storage of
+      the material is grown once and filled in parallel.
+      @param materialId Id of the material for the streamlines
+      @param vertices Positions of the vertices of all streamlines
+      @param colors Color of each vertex
+      @param radii Radius of each vertex
+      @param offsets Index of the first vertex of each streamline, in
+             increasing order starting with 0. A streamline ends where the
+             next one starts, the last one at the end of the vertices.
+      */
+    BRAYNS_API void addStreamlines(const size_t materialId,
+                                   const Vector3fs& vertices,
+                                   const Vector4fs& colors, const floats& radii,
+                                   const uint64_ts& offsets);
+
+    /**
+        Returns the streamlines handled by the model
+    */
+    const StreamlinesDataMap& getStreamlines() const { return _streamlines; }
+    /**
+        Returns the streamlines for modification. Their bounds are computed
+        again on the next commit, so removed streamlines no longer count.
+    */
+    StreamlinesDataMap& getStreamlines()
+    {
+        _streamlinesDirty = true;
+        _streamlinesBoundsDirty = true;
+        return _streamlines;
+    }
+
     /**
       Adds a SDFGeometry to the scene
       @param materialId Material of the geometry
@@ -284,6 +375,12 @@ public:
     void updateSDFGeometryNeighbours(
         size_t geometryIdx, const std::vector<size_t>& neighbourIndices);
 
+    /**
+      Removes all SDF geometries of the model. Geometries cannot be removed
+      one by one as neighbours refer to them by their global index.
+      */
+    void clearSDFGeometries();
+
     /**
         Returns triangle meshes handled by the model
     */
@@ -352,6 +449,19 @@ public:
 
     BRAYNS_API virtual void buildBoundingBox() = 0;
 
+    /**
+     * @return the cell tags of the primitives, used to hide primitives with
+     * the cell mask. Tags are optional and only created by loaders of cells.
+     */
+    const CellTags& getCellTags() const { return _cellTags; }
+    CellTags& getCellTags() { return _cellTags; }
+    /**
+     * @return the per-cell visibility mask of the model. Updating the mask does
+     * not require the geometry to be committed again.
+     */
+    const CellMask& getCellMask() const { return _cellMask; }
+    CellMask& getCellMask() { return _cellMask; }
+
     /** @return the size in bytes of all geometries. */
     size_t getSizeInBytes() const { return _sizeInBytes; }
     void markInstancesDirty() { _instancesDirty = true; }
@@ -363,21 +473,34 @@ public:
     void updateSizeInBytes();
 
 protected:
+    /**
+     * Bounds of the primitives of one geometry type, cached per material.
+     * Primitives appended with the add methods merge their bounds right away,
+     * only the materials modified through the non-const getters are computed
+     * again by _updateBounds().
+     */
+    struct MaterialBounds
+    {
+        std::map<size_t, Boxd> materials;
+        std::set<size_t> dirtyMaterials;
+        bool allDirty{false};
+    };
+
     void _updateBounds();
 
     MaterialMap _materials;
 
     SpheresMap _spheres;
     bool _spheresDirty{true};
-    Boxd _sphereBounds;
+    MaterialBounds _sphereBounds;
 
     CylindersMap _cylinders;
     bool _cylindersDirty{true};
-    Boxd _cylindersBounds;
+    MaterialBounds _cylindersBounds;
 
     ConesMap _cones;
     bool _conesDirty{true};
-    Boxd _conesBounds;
+    MaterialBounds _conesBounds;
 
     TrianglesMeshMap _trianglesMeshes;
     bool _trianglesMeshesDirty{true};
@@ -385,6 +508,7 @@ protected:
 
     StreamlinesDataMap _streamlines;
     bool _streamlinesDirty{true};
+    bool _streamlinesBoundsDirty{false};
     Boxd _streamlinesBounds;
 
     Boxd _bounds;
@@ -392,15 +516,23 @@ protected:
 
     struct SDFGeometryData
     {
-        std::vector<SDFGeometry> geometries;
-        std::map<size_t, std::vector<uint64_t>> geometryIndices;
-
-        std::vector<std::vector<size_t>> neighbours;
-        std::vector<uint64_t> neighboursFlat;
+        MappedVector<SDFGeometryInfo> geometries;
+        MappedVector<SDFSphere> spheres;
+        MappedVector<SDFPill> pills;
+        MappedVector<SDFConePill> conePills;
+        std::map<size_t, uint32_ts> geometryIndices;
+
+        // Global indices of the neighbours of all geometries, the neighbours
+        // of a geometry are contiguous
+        uint32_ts neighbours;
     };
 
+    void _setSDFGeometryNeighbours(SDFGeometryInfo& geometry,
+                                   const std::vector<size_t>& neighbourIndices);
+
     SDFGeometryData _sdf;
     bool _sdfGeometriesDirty{false};
+    bool _sdfGeometriesBoundsDirty{false};
     Boxd _sdfGeometriesBounds;
 
     bool _instancesDirty{true};
@@ -409,6 +541,9 @@ protected:
     bool _volumesDirty{true};
     Boxd _volumesBounds;
 
+    CellTags _cellTags;
+    CellMask _cellMask;
+
     size_t _sizeInBytes{0};
 
     SERIALIZATION_FRIEND(Model)
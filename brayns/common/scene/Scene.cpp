@@ -21,6 +21,7 @@
 #include "Scene.h"
 
 #include <brayns/common/Transformation.h>
+#include <brayns/common/loader/ProgressAggregator.h>
 #include <brayns/common/log.h>
 #include <brayns/common/material/Material.h>
 #include <brayns/common/scene/Model.h>
@@ -30,7 +31,12 @@
 
 #include <boost/filesystem.hpp>
 namespace fs = boost::filesystem;
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <mutex>
+#include <omp.h>
+#include <thread>
 
 namespace
 {
@@ -287,6 +293,87 @@ ModelDescriptorPtr Scene::load(const std::string& path, const size_t materialID,
     return modelDescriptor;
 }
 
+ModelDescriptorPtr Scene::load(std::vector<Blob>&& blobs,
+                               const size_t materialID,
+                               Loader::UpdateCallback cb)
+{
+    if (blobs.empty())
+        throw std::runtime_error("No supported file found to load");
+
+    const size_t numBlobs = blobs.size();
+    ModelDescriptors modelDescriptors(numBlobs);
+
+    // each blob counts for PROGRESS_STEPS in the total progress; the
+    // progress of a blob is only updated by the thread importing it
+    const size_t PROGRESS_STEPS = 1000;
+    const auto message = "Loading " + std::to_string(numBlobs) + " files ...";
+    ProgressAggregator progress(cb, message, numBlobs * PROGRESS_STEPS);
+    std::vector<size_t> blobsProgress(numBlobs, 0);
+
+    // the loaders are parallel themselves: the OpenMP threads are shared
+    // among the importing threads to not oversubscribe the machine. The
+    // calling thread imports as well.
+    // The engine serializes the creation of its objects in createModel(),
+    // Model::createMaterial() and the volume factories.
+    const size_t maxThreads = std::max(omp_get_max_threads(), 1);
+    const size_t numThreads = std::min(numBlobs, maxThreads);
+    const int loaderThreads = std::max<size_t>(maxThreads / numThreads, 1);
+
+    std::mutex errorMutex;
+    std::atomic<bool> failed{false};
+    std::atomic<size_t> nextBlob{0};
+    std::exception_ptr error;
+    auto importBlobs = [&] {
+        const int previousThreads = omp_get_max_threads();
+        omp_set_num_threads(loaderThreads);
+        for (size_t i = nextBlob++; i < numBlobs && !failed; i = nextBlob++)
+        {
+            try
+            {
+                auto loader = _loaderRegistry.createLoader(blobs[i].type);
+                loader->setProgressCallback([&, i](const std::string&,
+                                                   const float amount) {
+                    const size_t steps = amount * PROGRESS_STEPS;
+                    if (steps > blobsProgress[i])
+                    {
+                        progress.increment(steps - blobsProgress[i]);
+                        blobsProgress[i] = steps;
+                    }
+                });
+                modelDescriptors[i] =
+                    loader->importFromBlob(std::move(blobs[i]), i, materialID);
+                if (!modelDescriptors[i])
+                    throw std::runtime_error("No model returned by loader");
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!failed.exchange(true))
+                    error = std::current_exception();
+            }
+        }
+        omp_set_num_threads(previousThreads);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i)
+        threads.emplace_back(importBlobs);
+    importBlobs();
+    for (auto& thread : threads)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+    progress.finish();
+
+    for (const auto& modelDescriptor : modelDescriptors)
+        addModel(modelDescriptor);
+
+    saveToCacheFile();
+    buildEnvironmentMap();
+    return modelDescriptors.back();
+}
+
 void Scene::saveToCacheFile()
 {
     const auto& geometryParameters = _parametersManager.getGeometryParameters();
@@ -296,13 +383,34 @@ void Scene::saveToCacheFile()
         return;
     }
 
-    const auto& filename = geometryParameters.getSaveCacheFile();
+    saveToCacheFile(geometryParameters.getSaveCacheFile());
+}
+
+bool Scene::saveToCacheFile(const std::string& filename)
+{
+    // the cache would load as a different scene
+    std::shared_lock<std::shared_timed_mutex> lock(_modelMutex);
+    const bool cacheable =
+        !_simulationHandler &&
+        std::all_of(_modelDescriptors.begin(), _modelDescriptors.end(),
+                    [](const auto& modelDescriptor) {
+                        return modelDescriptor->getModel().isCacheable();
+                    });
+    if (!cacheable)
+    {
+        BRAYNS_ERROR << "Not saving the scene to " << filename << ": the "
+                     << "cache does not hold simulations, volumes, "
+                     << "streamlines, SDF geometries, cell tags or textures"
+                     << std::endl;
+        return false;
+    }
+
     BRAYNS_INFO << "Saving scene to binary file: " << filename << std::endl;
     std::ofstream file(filename, std::ios::out | std::ios::binary);
     if (!file.good())
     {
         BRAYNS_ERROR << "Could not open cache file " << filename << std::endl;
-        return;
+        return false;
     }
 
     const size_t version = CACHE_VERSION;
@@ -310,7 +418,6 @@ void Scene::saveToCacheFile()
     BRAYNS_INFO << "Version: " << version << std::endl;
 
     // Save geometry
-    std::shared_lock<std::shared_timed_mutex> lock(_modelMutex);
     size_t nbElements = _modelDescriptors.size();
     file.write((char*)&nbElements, sizeof(size_t));
     for (auto modelDescriptor : _modelDescriptors)
@@ -460,19 +567,29 @@ void Scene::saveToCacheFile()
     }
 
     file.close();
+    if (!file)
+    {
+        BRAYNS_ERROR << "Could not write cache file " << filename << std::endl;
+        return false;
+    }
     BRAYNS_INFO << "Scene successfully saved" << std::endl;
+    return true;
 }
 
 void Scene::loadFromCacheFile()
 {
     const auto& geomParams = _parametersManager.getGeometryParameters();
-    const auto& filename = geomParams.getLoadCacheFile();
+    loadFromCacheFile(geomParams.getLoadCacheFile());
+}
+
+bool Scene::loadFromCacheFile(const std::string& filename)
+{
     BRAYNS_INFO << "Loading scene from binary file: " << filename << std::endl;
     std::ifstream file(filename, std::ios::in | std::ios::binary);
     if (!file.good())
     {
         BRAYNS_ERROR << "Could not open cache file " << filename << std::endl;
-        return;
+        return false;
     }
 
     // File version
@@ -484,7 +601,7 @@ void Scene::loadFromCacheFile()
     {
         BRAYNS_ERROR << "Only version " << CACHE_VERSION << " is supported"
                      << std::endl;
-        return;
+        return false;
     }
 
     // Geometry
@@ -561,7 +678,7 @@ void Scene::loadFromCacheFile()
             bufferSize = nbElements * sizeof(Sphere);
             BRAYNS_DEBUG << "[" << materialId << "] " << nbElements
                          << " spheres" << std::endl;
-            auto& spheres = model->getSpheres()[materialId];
+            auto& spheres = model->getSpheres(materialId);
             spheres.resize(nbElements);
             file.read((char*)spheres.data(), bufferSize);
         }
@@ -575,7 +692,7 @@ void Scene::loadFromCacheFile()
             bufferSize = nbElements * sizeof(Cylinder);
             BRAYNS_DEBUG << "[" << materialId << "] " << nbElements
                          << " cylinders" << std::endl;
-            auto& cylinders = model->getCylinders()[materialId];
+            auto& cylinders = model->getCylinders(materialId);
             cylinders.resize(nbElements);
             file.read((char*)cylinders.data(), bufferSize);
         }
@@ -589,7 +706,7 @@ void Scene::loadFromCacheFile()
             bufferSize = nbElements * sizeof(Cone);
             BRAYNS_DEBUG << "[" << materialId << "] " << nbElements << " cones"
                          << std::endl;
-            auto& cones = model->getCones()[materialId];
+            auto& cones = model->getCones(materialId);
             cones.resize(nbElements);
             file.read((char*)cones.data(), bufferSize);
         }
@@ -656,6 +773,7 @@ void Scene::loadFromCacheFile()
 
     file.close();
     BRAYNS_INFO << "Scene successfully loaded" << std::endl;
+    return true;
 }
 
 void Scene::buildDefault()
@@ -786,17 +904,22 @@ void Scene::setMaterialsColorMap(MaterialsColorMap colorMap)
 
 void Scene::_computeBounds()
 {
+    // the model bounds are cached and updated on commit, only transform them
+    // here. The descriptors are updated under the lock as addModel() and
+    // removeModel() may run concurrently.
     std::unique_lock<std::shared_timed_mutex> lock(_modelMutex);
-    _bounds.reset();
+    Boxd bounds;
     for (auto modelDescriptor : _modelDescriptors)
     {
         modelDescriptor->computeBounds();
-        _bounds.merge(modelDescriptor->getBounds());
+        bounds.merge(modelDescriptor->getBounds());
     }
 
-    if (_bounds.isEmpty())
+    if (bounds.isEmpty())
         // If no model is enabled. return empty bounding box
-        _bounds.merge({0, 0, 0});
+        bounds.merge({0, 0, 0});
+
+    _bounds = bounds;
 }
 
 void Scene::buildEnvironmentMap()
@@ -804,6 +927,12 @@ void Scene::buildEnvironmentMap()
     const auto& environmentMap =
         _parametersManager.getSceneParameters().getEnvironmentMap();
     if (!environmentMap.empty())
-        _backgroundMaterial->setTexture(environmentMap, TT_DIFFUSE);
+    {
+        const auto texture = _textureCache.get(environmentMap);
+        if (!texture)
+            throw std::runtime_error("Failed to load texture from " +
+                                     environmentMap);
+        _backgroundMaterial->setTexture(texture, TT_DIFFUSE);
+    }
 }
 }
@@ -24,6 +24,7 @@
 #include <brayns/api.h>
 #include <brayns/common/BaseObject.h>
 #include <brayns/common/loader/LoaderRegistry.h>
+#include <brayns/common/material/TextureCache.h>
 #include <brayns/common/simulation/AbstractSimulationHandler.h>
 #include <brayns/common/transferFunction/TransferFunction.h>
 #include <brayns/common/types.h>
@@ -219,12 +220,27 @@ public:
     */
     BRAYNS_API void loadFromCacheFile();
 
+    /**
+        Loads geometry from the given binary cache file, see above for the file
+        structure.
+        @return false if the file could not be read or has another version
+    */
+    BRAYNS_API bool loadFromCacheFile(const std::string& filename);
+
     /**
         Saves geometry a binary cache file defined by the --save-cache-file
        command line parameter. See loadFromCacheFile for file structure
     */
     BRAYNS_API void saveToCacheFile();
 
+    /**
+        Saves geometry to the given binary cache file
+        @return false if the file could not be written, or if the scene holds
+                data that the cache does not store, like simulations, see
+                Model::isCacheable()
+    */
+    BRAYNS_API bool saveToCacheFile(const std::string& filename);
+
     /** @return the current size in bytes of the loaded geometry. */
     size_t getSizeInBytes() const;
 
@@ -262,8 +278,24 @@ public:
     ModelDescriptorPtr load(const std::string& path, const size_t materialID,
                             Loader::UpdateCallback cb);
 
+    /**
+     * Load the data from the given blobs, typically the entries of an archive.
+     * The blobs are imported concurrently, the models are added to the scene
+     * in the order of the blobs.
+     *
+     * @param blobs the blobs containing the data to import
+     * @param materialID the default material ot use
+     * @param cb the callback for progress updates from the loaders
+     * @return the last model that has been added to the scene
+     */
+    ModelDescriptorPtr load(std::vector<Blob>&& blobs, const size_t materialID,
+                            Loader::UpdateCallback cb);
+
     /** @return the registry for all supported loaders of this scene. */
     LoaderRegistry& getLoaderRegistry() { return _loaderRegistry; }
+    /** @return the textures shared by the materials of this scene. */
+    TextureCache& getTextureCache() { return _textureCache; }
+    const TextureCache& getTextureCache() const { return _textureCache; }
     /** @internal not safe w/o modelMutex() */
     ModelDescriptors& getModelDescriptors() { return _modelDescriptors; }
     auto& modelMutex() const { return _modelMutex; }
@@ -292,6 +324,7 @@ protected:
     CADiffusionSimulationHandlerPtr _caDiffusionSimulationHandler{nullptr};
 
     LoaderRegistry _loaderRegistry;
+    TextureCache _textureCache;
     Boxd _bounds;
 
 private:
@@ -21,12 +21,11 @@
 #include "AbstractSimulationHandler.h"
 
 #include <brayns/common/log.h>
+#include <brayns/common/simulation/FrameReader.h>
 #include <brayns/parameters/GeometryParameters.h>
 
-#include <fcntl.h>
+#include <algorithm>
 #include <fstream>
-#include <sys/mman.h>
-#include <sys/stat.h>
 
 namespace brayns
 {
@@ -39,14 +38,6 @@ AbstractSimulationHandler::AbstractSimulationHandler(
 
 AbstractSimulationHandler::~AbstractSimulationHandler()
 {
-    if (_memoryMapPtr)
-    {
-        const uint64_t size =
-            _headerSize + _frameSize * _nbFrames * sizeof(float);
-        ::munmap((void*)_memoryMapPtr, size);
-    }
-    if (_cacheFileDescriptor != -1)
-        ::close(_cacheFileDescriptor);
 }
 
 AbstractSimulationHandler& AbstractSimulationHandler::operator=(
@@ -69,7 +60,7 @@ AbstractSimulationHandler& AbstractSimulationHandler::operator=(
 bool AbstractSimulationHandler::attachSimulationToCacheFile(
     const std::string& cacheFile)
 {
-    if (_cacheFileDescriptor > -1)
+    if (_frameReader)
     {
         BRAYNS_ERROR << "Cache already opened, not attaching " << cacheFile
                      << std::endl;
@@ -78,35 +69,21 @@ bool AbstractSimulationHandler::attachSimulationToCacheFile(
 
     BRAYNS_INFO << "Attaching " << cacheFile << " to current scene"
                 << std::endl;
-    _cacheFileDescriptor = open(cacheFile.c_str(), O_RDONLY);
-    if (_cacheFileDescriptor == -1)
+    try
     {
-        BRAYNS_ERROR << "Failed to open " << cacheFile << std::endl;
-        return false;
+        _frameReader =
+            FrameReader::create(_geometryParameters.getSimulationFrameReader(),
+                                cacheFile);
     }
-
-    struct stat sb;
-    if (::fstat(_cacheFileDescriptor, &sb) == -1)
+    catch (const std::runtime_error& e)
     {
-        BRAYNS_ERROR << "Failed to get stats from " << cacheFile << std::endl;
-        return false;
-    }
-
-    _memoryMapPtr =
-        ::mmap(0, sb.st_size, PROT_READ, MAP_PRIVATE, _cacheFileDescriptor, 0);
-    if (_memoryMapPtr == MAP_FAILED)
-    {
-        _memoryMapPtr = 0;
-        BRAYNS_ERROR << "Failed to attach " << cacheFile << std::endl;
-        ::close(_cacheFileDescriptor);
+        BRAYNS_ERROR << "Failed to attach " << cacheFile << ": " << e.what()
+                     << std::endl;
         return false;
     }
 
-    _headerSize = 2 * sizeof(uint64_t);
-
-    strncpy((char*)&_nbFrames, (char*)_memoryMapPtr, sizeof(_nbFrames));
-    strncpy((char*)&_frameSize, ((char*)_memoryMapPtr + sizeof(_nbFrames)),
-            sizeof(_frameSize));
+    _nbFrames = _frameReader->getNbFrames();
+    _frameSize = _frameReader->getFrameSize();
 
     BRAYNS_INFO << "Nb Frames: " << _nbFrames << std::endl;
     BRAYNS_INFO << "Frame size: " << _frameSize << std::endl;
@@ -117,8 +94,8 @@ bool AbstractSimulationHandler::attachSimulationToCacheFile(
 
 void AbstractSimulationHandler::writeHeader(std::ofstream& stream)
 {
-    stream.write((char*)&_nbFrames, sizeof(_nbFrames));
-    stream.write((char*)&_frameSize, sizeof(_frameSize));
+    const uint64_t header[2] = {_nbFrames, _frameSize};
+    stream.write((const char*)header, sizeof(header));
 }
 
 void AbstractSimulationHandler::writeFrame(std::ofstream& stream,
@@ -127,14 +104,94 @@ void AbstractSimulationHandler::writeFrame(std::ofstream& stream,
     stream.write((char*)values.data(), values.size() * sizeof(float));
 }
 
+void* AbstractSimulationHandler::getInterpolatedFrameData(
+    const uint32_t frame, double fraction,
+    const SimulationInterpolation interpolation)
+{
+    fraction = fraction > 0 ? std::min(fraction, 1.) : 0.;
+    if (interpolation == SimulationInterpolation::none || fraction == 0 ||
+        _nbFrames < 2)
+    {
+        _keyFrames.clear();
+        auto data = getFrameData(frame);
+        _currentPosition = _currentFrame;
+        _currentInterpolation = interpolation;
+        return data;
+    }
+
+    // the animation loops, so do the frames around the position
+    const auto first = _getBoundedFrame(frame);
+    std::vector<uint32_t> frames;
+    if (interpolation == SimulationInterpolation::cubic)
+        frames.push_back((first + _nbFrames - 1) % _nbFrames);
+    frames.push_back(first);
+    frames.push_back((first + 1) % _nbFrames);
+    if (interpolation == SimulationInterpolation::cubic)
+        frames.push_back((first + 2) % _nbFrames);
+
+    for (auto i = _keyFrames.begin(); i != _keyFrames.end();)
+        if (std::find(frames.begin(), frames.end(), i->first) == frames.end())
+            i = _keyFrames.erase(i);
+        else
+            ++i;
+
+    for (const auto keyFrame : frames)
+    {
+        if (_keyFrames.count(keyFrame))
+            continue;
+        auto& values = _keyFrames[keyFrame];
+        if (!_readFrame(keyFrame, values) || values.size() < _frameSize)
+        {
+            _keyFrames.erase(keyFrame);
+            return nullptr;
+        }
+    }
+
+    const float t = fraction;
+    float weights[4] = {1.f - t, t, 0.f, 0.f};
+    if (interpolation == SimulationInterpolation::cubic)
+    {
+        weights[0] = 0.5f * t * ((2.f - t) * t - 1.f);
+        weights[1] = 0.5f * (t * t * (3.f * t - 5.f) + 2.f);
+        weights[2] = 0.5f * t * ((4.f - 3.f * t) * t + 1.f);
+        weights[3] = 0.5f * t * t * (t - 1.f);
+    }
+    const float* values[4];
+    for (size_t i = 0; i < frames.size(); ++i)
+        values[i] = _keyFrames[frames[i]].data();
+
+    _interpolatedData.resize(_frameSize);
+    float* result = _interpolatedData.data();
+    const int64_t size = _frameSize;
+    if (frames.size() == 2)
+    {
+#pragma omp parallel for
+        for (int64_t i = 0; i < size; ++i)
+            result[i] = weights[0] * values[0][i] + weights[1] * values[1][i];
+    }
+    else
+    {
+#pragma omp parallel for
+        for (int64_t i = 0; i < size; ++i)
+            result[i] = weights[0] * values[0][i] + weights[1] * values[1][i] +
+                        weights[2] * values[2][i] + weights[3] * values[3][i];
+    }
+
+    _currentPosition = first + fraction;
+    _currentInterpolation = interpolation;
+    return result;
+}
+
 Histogram& AbstractSimulationHandler::getHistogram()
 {
     if (!histogramChanged())
         return _histogram;
 
-    float* data = (float*)getFrameData(_currentFrame);
-    if (!data)
+    // the current frame is already loaded, reading it through getFrameData()
+    // would move the playback and prefetch frames
+    if (_frameData.size() < _frameSize)
         return _histogram;
+    const float* data = _frameData.data();
 
     // Determine range
     Vector2f range(std::numeric_limits<float>::max(),
@@ -177,4 +234,20 @@ uint32_t AbstractSimulationHandler::_getBoundedFrame(const uint32_t frame) const
 {
     return _nbFrames == 0 ? frame : frame % _nbFrames;
 }
+
+bool AbstractSimulationHandler::_readFrame(const uint32_t frame,
+                                           floats& values)
+{
+    if (_frameReader)
+    {
+        const float* data = _frameReader->getFrame(frame, true);
+        values.assign(data, data + _frameSize);
+        return true;
+    }
+
+    if (frame != _currentFrame || _frameData.size() < _frameSize)
+        return false;
+    values.assign(_frameData.begin(), _frameData.begin() + _frameSize);
+    return true;
+}
 }
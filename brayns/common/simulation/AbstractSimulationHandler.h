@@ -47,11 +47,9 @@ public:
     AbstractSimulationHandler& operator=(const AbstractSimulationHandler& rhs);
 
     /**
-    * @brief Attaches a memory mapped file to the scene so that renderers can
-    * access the data
-    *        as if it was in memory. The OS is in charge of dealing with the map
-    * file in system
-    *        memory.
+    * @brief Attaches a simulation cache file to the scene so that renderers
+    * can access the data. Frames are read ahead of the playback by the frame
+    * reader selected with --simulation-frame-reader.
     * @param cacheFile File containing the simulation values
     * @return True if the file was successfully attached, false otherwise
     */
@@ -83,6 +81,38 @@ public:
         return _frameData.data();
     }
 
+    /**
+     * @brief returns the simulation data at a fractional frame, interpolated
+     * between the frames read by _readFrame(). The frames needed by the
+     * interpolation are kept in memory so that moving between two frames does
+     * not read any data.
+     * @param frame the frame before the position
+     * @param fraction the position between frame and frame + 1, clamped to
+     *        [0, 1]
+     * @param interpolation the interpolation method
+     * @return the values at the position, valid until the next call; nullptr
+     *         if the frames are not loaded yet
+     */
+    BRAYNS_API void* getInterpolatedFrameData(
+        uint32_t frame, double fraction,
+        SimulationInterpolation interpolation);
+
+    /**
+     * @return the fractional frame of the data last returned by
+     *         getInterpolatedFrameData()
+     */
+    double getCurrentPosition() const { return _currentPosition; }
+    /** @return the frame wrapped in the frames of the simulation */
+    uint32_t getBoundedFrame(const uint32_t frame) const
+    {
+        return _getBoundedFrame(frame);
+    }
+    /** @return the interpolation of the data last returned */
+    SimulationInterpolation getCurrentInterpolation() const
+    {
+        return _currentInterpolation;
+    }
+
     /**
      * @brief getFrameSize return the size of the current simulation frame
      */
@@ -130,6 +160,17 @@ public:
 protected:
     uint32_t _getBoundedFrame(const uint32_t frame) const;
 
+    /**
+     * Reads a frame for the interpolation, without moving the current frame
+     * or reading ahead as getFrameData() does.
+     * @param frame the bounded frame to read
+     * @param values the values of the frame
+     * @return false if the frame can not be read now, for instance while it
+     *         is loaded in the background; it is requested again by the next
+     *         getInterpolatedFrameData()
+     */
+    virtual bool _readFrame(uint32_t frame, floats& values);
+
     const GeometryParameters& _geometryParameters;
     uint32_t _currentFrame{std::numeric_limits<uint32_t>::max()};
     uint32_t _nbFrames{0};
@@ -137,11 +178,16 @@ protected:
     double _dt{0};
     std::string _unit;
 
-    uint64_t _headerSize{0};
-    void* _memoryMapPtr{nullptr};
-    int _cacheFileDescriptor{-1};
+    FrameReaderPtr _frameReader;
     Histogram _histogram;
     floats _frameData;
+
+private:
+    double _currentPosition{-1};
+    SimulationInterpolation _currentInterpolation{
+        SimulationInterpolation::none};
+    std::map<uint32_t, floats> _keyFrames;
+    floats _interpolatedData;
 };
 }
 #endif // ABSTRACTSIMULATIONHANDLER_H
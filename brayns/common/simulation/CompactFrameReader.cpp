@@ -0,0 +1,201 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "CompactFrameReader.h"
+
+#include <brayns/common/simulation/SimulationCacheWriter.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace
+{
+#ifdef IOV_MAX
+const size_t MAX_IOVECS = IOV_MAX;
+#else
+const size_t MAX_IOVECS = 1024;
+#endif
+
+std::string errorString(const std::string& message)
+{
+    return message + ": " + strerror(errno);
+}
+}
+
+namespace brayns
+{
+CompactFrameReader::CompactFrameReader(const std::string& filename,
+                                       const FrameRanges& ranges,
+                                       const uint64_t frameSize,
+                                       const uint64_t maxGap)
+    : _frameSize(frameSize)
+    , _maxGap(maxGap)
+{
+    _fd = ::open(filename.c_str(), O_RDONLY);
+    if (_fd == -1)
+        throw std::runtime_error(errorString("Could not open " + filename));
+
+    try
+    {
+        uint64_t header[2];
+        if (::pread(_fd, header, sizeof(header), 0) != sizeof(header))
+            throw std::runtime_error(filename + " is not a simulation cache");
+        if (header[0] == COMPRESSED_SIMULATION_CACHE_MAGIC)
+            throw std::runtime_error(filename + " is compressed, only raw "
+                                                "caches can be partially read");
+        _nbFrames = header[0];
+        _cacheFrameSize = header[1];
+
+        struct stat sb;
+        if (::fstat(_fd, &sb) == -1 ||
+            uint64_t(sb.st_size) < SIMULATION_CACHE_HEADER_SIZE +
+                                       _nbFrames * _cacheFrameSize *
+                                           sizeof(float))
+        {
+            throw std::runtime_error(filename + " is truncated");
+        }
+
+        FrameRanges sorted;
+        sorted.reserve(ranges.size());
+        for (const auto& range : ranges)
+        {
+            // empty ranges may have any offset, e.g. unreported sections
+            if (range.count == 0)
+                continue;
+            if (range.source + range.count > _cacheFrameSize ||
+                range.target + range.count > _frameSize)
+            {
+                throw std::runtime_error(
+                    "Simulation range out of the frames of " + filename);
+            }
+            sorted.push_back(range);
+        }
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const FrameRange& a, const FrameRange& b) {
+                      return a.source < b.source;
+                  });
+
+        // ranges overlapping in the file start a new read, the values are
+        // read once per range
+        uint64_t end = 0;
+        for (const auto& range : sorted)
+        {
+            if (_reads.empty() || range.source < end ||
+                range.source - end > _maxGap)
+            {
+                _reads.push_back({range.source, {}});
+            }
+            else if (range.source > end)
+                _reads.back().pieces.push_back({0, range.source - end, true});
+
+            auto& pieces = _reads.back().pieces;
+            if (!pieces.empty() && !pieces.back().gap &&
+                pieces.back().target + pieces.back().count == range.target)
+            {
+                pieces.back().count += range.count;
+            }
+            else
+                pieces.push_back({range.target, range.count, false});
+
+            end = range.source + range.count;
+        }
+
+        for (const auto& read : _reads)
+            for (const auto& piece : read.pieces)
+                _nbReadValues += piece.count;
+    }
+    catch (...)
+    {
+        ::close(_fd);
+        throw;
+    }
+}
+
+CompactFrameReader::~CompactFrameReader()
+{
+    ::close(_fd);
+}
+
+void CompactFrameReader::read(const uint64_t frame, float* values) const
+{
+    if (frame >= _nbFrames)
+        throw std::runtime_error("Invalid simulation frame " +
+                                 std::to_string(frame));
+
+    floats gap(_maxGap);
+    std::vector<iovec> iovecs;
+    const uint64_t frameOffset = SIMULATION_CACHE_HEADER_SIZE +
+                                 frame * _cacheFrameSize * sizeof(float);
+    for (const auto& read : _reads)
+    {
+        off_t offset = frameOffset + read.source * sizeof(float);
+        for (size_t first = 0; first < read.pieces.size();
+             first += MAX_IOVECS)
+        {
+            const size_t last =
+                std::min(read.pieces.size(), first + MAX_IOVECS);
+            iovecs.clear();
+            size_t remaining = 0;
+            for (size_t i = first; i < last; ++i)
+            {
+                const auto& piece = read.pieces[i];
+                void* base = piece.gap ? gap.data() : values + piece.target;
+                iovecs.push_back({base, piece.count * sizeof(float)});
+                remaining += piece.count * sizeof(float);
+            }
+
+            // short reads only happen on interruptions, resume after the
+            // bytes already read
+            auto iovec = iovecs.data();
+            while (remaining > 0)
+            {
+                const auto size =
+                    ::preadv(_fd, iovec, iovecs.data() + iovecs.size() - iovec,
+                             offset);
+                if (size == -1 && errno == EINTR)
+                    continue;
+                if (size <= 0)
+                    throw std::runtime_error(errorString(
+                        "Could not read simulation frame " +
+                        std::to_string(frame)));
+                offset += size;
+                remaining -= size;
+                size_t done = size;
+                while (done > 0 && done >= iovec->iov_len)
+                    done -= (iovec++)->iov_len;
+                if (done > 0)
+                {
+                    iovec->iov_base =
+                        static_cast<char*>(iovec->iov_base) + done;
+                    iovec->iov_len -= done;
+                }
+            }
+        }
+    }
+}
+}
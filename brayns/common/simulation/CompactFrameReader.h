@@ -0,0 +1,108 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/** Values copied from a simulation cache frame into a compact frame */
+struct FrameRange
+{
+    uint64_t source; // offset in the frames of the cache file
+    uint64_t target; // offset in the compact frame
+    uint64_t count;
+};
+typedef std::vector<FrameRange> FrameRanges;
+
+/**
+ * Reads a subset of the values of each frame of a simulation cache file into
+ * a compact frame, see SimulationCacheWriter. Used when only some cells of the
+ * cached report are loaded: the I/O scales with the number of loaded values
+ * rather than with the size of the report.
+ *
+ * Ranges adjacent in the file are coalesced into a single read, gaps up to
+ * maxGap values included; the values of the gaps are read and dropped.
+ */
+class CompactFrameReader
+{
+public:
+    static const uint64_t DEFAULT_MAX_GAP = 1024;
+
+    /**
+     * @param filename the simulation cache file
+     * @param ranges the values to read from each frame
+     * @param frameSize the number of values of the compact frames
+     * @param maxGap maximum number of values between two ranges read at once
+     * @throw std::runtime_error if the file is not a valid cache or a range is
+     *        out of the frames
+     */
+    BRAYNS_API CompactFrameReader(const std::string& filename,
+                                  const FrameRanges& ranges,
+                                  uint64_t frameSize,
+                                  uint64_t maxGap = DEFAULT_MAX_GAP);
+    BRAYNS_API ~CompactFrameReader();
+
+    uint64_t getNbFrames() const { return _nbFrames; }
+    /** @return the number of values of the frames in the cache file */
+    uint64_t getCacheFrameSize() const { return _cacheFrameSize; }
+    /** @return the number of values of the compact frames */
+    uint64_t getFrameSize() const { return _frameSize; }
+    /** @return the number of reads per frame after coalescing */
+    size_t getNbReads() const { return _reads.size(); }
+    /** @return the number of values read per frame, gaps included */
+    uint64_t getNbReadValues() const { return _nbReadValues; }
+
+    /**
+     * Reads the compact frame; can be called concurrently.
+     * @param frame the frame in the cache file
+     * @param values getFrameSize() values, the values not covered by the
+     *        ranges are left untouched
+     * @throw std::runtime_error if the frame could not be read
+     */
+    BRAYNS_API void read(uint64_t frame, float* values) const;
+
+private:
+    /** Part of a read, copied to the compact frame or dropped if a gap */
+    struct Piece
+    {
+        uint64_t target;
+        uint64_t count;
+        bool gap;
+    };
+
+    /** Values contiguous in the file, read with a single system call */
+    struct Read
+    {
+        uint64_t source;
+        std::vector<Piece> pieces;
+    };
+
+    int _fd{-1};
+    uint64_t _nbFrames{0};
+    uint64_t _cacheFrameSize{0};
+    uint64_t _frameSize{0};
+    uint64_t _maxGap{0};
+    uint64_t _nbReadValues{0};
+    std::vector<Read> _reads;
+};
+}
@@ -0,0 +1,902 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "FrameReader.h"
+
+#include <brayns/common/log.h>
+#include <brayns/common/simulation/SimulationCacheWriter.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#ifdef __NR_io_uring_setup
+#define BRAYNS_HAS_IO_URING
+#endif
+#endif
+#endif
+
+namespace brayns
+{
+namespace
+{
+// alignment of the reads, as required by O_DIRECT
+const uint64_t READ_ALIGNMENT = 4096;
+
+std::string systemError(const int error)
+{
+    return std::strerror(error);
+}
+
+/** A file descriptor closed on destruction */
+class File
+{
+public:
+    explicit File(const int fd)
+        : fd(fd)
+    {
+    }
+    ~File()
+    {
+        if (fd != -1)
+            ::close(fd);
+    }
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    const int fd;
+};
+
+/**
+ * Base of the readers using buffers: each buffer holds the aligned range of
+ * the file around one frame. Buffers are recycled in least recently used
+ * order.
+ */
+class BufferedFrameReader : public FrameReader
+{
+public:
+    BufferedFrameReader(const std::string& filename, const uint64_t nbFrames,
+                        const uint64_t frameSize, const size_t queueDepth)
+        : FrameReader(nbFrames, frameSize, queueDepth)
+        , _file(_open(filename))
+        , _slots(new Slot[queueDepth])
+    {
+        const uint64_t frameBytes = _frameSize * sizeof(float);
+        // a frame not aligned on the block size spans one more block
+        _bufferSize =
+            (frameBytes + 2 * READ_ALIGNMENT - 1) / READ_ALIGNMENT *
+            READ_ALIGNMENT;
+        for (size_t i = 0; i < _queueDepth; ++i)
+        {
+            void* buffer = nullptr;
+            if (posix_memalign(&buffer, READ_ALIGNMENT, _bufferSize) != 0)
+                throw std::runtime_error("Could not allocate frame buffers");
+            _slots[i].buffer.reset(static_cast<char*>(buffer));
+            // best effort, limited by RLIMIT_MEMLOCK
+            ::mlock(buffer, _bufferSize);
+        }
+    }
+
+    ~BufferedFrameReader()
+    {
+        for (size_t i = 0; i < _queueDepth; ++i)
+            ::munlock(_slots[i].buffer.get(), _bufferSize);
+    }
+
+    void prefetch(const uint64_t frame) final
+    {
+        if (frame < _nbFrames && !_find(frame))
+            _request(frame);
+    }
+
+    const float* getFrame(const uint64_t frame, const bool wait) final
+    {
+        if (frame >= _nbFrames)
+            throw std::runtime_error("Invalid frame " + std::to_string(frame));
+
+        Slot* slot = _find(frame);
+        while (!slot)
+        {
+            slot = _request(frame);
+            if (slot)
+                break;
+            // all buffers are busy, wait for one of them
+            if (!wait)
+                return nullptr;
+            _reap(true);
+        }
+
+        _reap(false);
+        while (slot->state == Slot::reading)
+        {
+            if (!wait)
+                return nullptr;
+            _reap(true);
+        }
+
+        if (slot->state == Slot::failed)
+        {
+            slot->state = Slot::empty;
+            throw std::runtime_error("Could not read simulation frame " +
+                                     std::to_string(frame) + ": " +
+                                     systemError(slot->error));
+        }
+        slot->lastUse = ++_clock;
+        return reinterpret_cast<const float*>(slot->buffer.get() +
+                                              slot->frameOffset);
+    }
+
+protected:
+    struct Slot
+    {
+        enum State
+        {
+            empty,
+            reading,
+            ready,
+            failed
+        };
+
+        struct FreeDeleter
+        {
+            void operator()(char* ptr) const { free(ptr); }
+        };
+        std::unique_ptr<char, FreeDeleter> buffer;
+        uint64_t frame{0};
+        uint64_t offset{0};      // aligned file offset of the buffer
+        size_t frameOffset{0};   // offset of the frame in the buffer
+        size_t size{0};          // bytes to read for the frame
+        size_t done{0};          // bytes read so far
+        std::atomic<int> state{empty};
+        int error{0};
+        uint64_t lastUse{0};
+    };
+
+    /** Starts reading slot.size - slot.done bytes at slot.done */
+    virtual void _submit(Slot& slot) = 0;
+
+    /** Updates the state of the slots read since the last call */
+    virtual void _reap(bool wait) = 0;
+
+    /**
+     * Called by the backends with the result of a read of a slot, a negative
+     * errno on failure.
+     * @return true if the frame is partially read and the rest must be read
+     */
+    bool _complete(Slot& slot, const ssize_t result)
+    {
+        if (result <= 0)
+        {
+            // no data means the end of file before the end of the frame
+            slot.error = result < 0 ? -result : EIO;
+            slot.state = Slot::failed;
+            return false;
+        }
+        slot.done += result;
+        if (slot.done < slot.size)
+            return true;
+        slot.state = Slot::ready;
+        return false;
+    }
+
+    /** @return the size to read for the slot, aligned if needed */
+    size_t _getReadSize(const Slot& slot) const
+    {
+        const size_t size = slot.size - slot.done;
+        if (!_direct)
+            return size;
+        return std::min(_bufferSize - slot.done,
+                        (size + READ_ALIGNMENT - 1) / READ_ALIGNMENT *
+                            READ_ALIGNMENT);
+    }
+
+    Slot& _getSlot(const size_t index) { return _slots[index]; }
+    size_t _getIndex(const Slot& slot) const { return &slot - _slots.get(); }
+    int _getFd() const { return _file.fd; }
+    bool _isDirect() const { return _direct; }
+
+private:
+    int _open(const std::string& filename)
+    {
+        // bypass the page cache when the filesystem supports it, the frames
+        // are buffered here
+        int fd = ::open(filename.c_str(), O_RDONLY | O_DIRECT);
+        _direct = fd != -1;
+        if (fd == -1)
+            fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw std::runtime_error("Could not open " + filename + ": " +
+                                     systemError(errno));
+        return fd;
+    }
+
+    Slot* _find(const uint64_t frame)
+    {
+        for (size_t i = 0; i < _queueDepth; ++i)
+            if (_slots[i].state != Slot::empty && _slots[i].frame == frame)
+                return &_slots[i];
+        return nullptr;
+    }
+
+    Slot* _request(const uint64_t frame)
+    {
+        Slot* victim = nullptr;
+        for (size_t i = 0; i < _queueDepth; ++i)
+        {
+            auto& slot = _slots[i];
+            if (slot.state == Slot::reading)
+                continue;
+            if (!victim || slot.lastUse < victim->lastUse)
+                victim = &slot;
+        }
+        if (!victim)
+            return nullptr;
+
+        const uint64_t frameBytes = _frameSize * sizeof(float);
+        const uint64_t position =
+            SIMULATION_CACHE_HEADER_SIZE + frame * frameBytes;
+        victim->frame = frame;
+        victim->offset = position / READ_ALIGNMENT * READ_ALIGNMENT;
+        victim->frameOffset = position - victim->offset;
+        victim->size = victim->frameOffset + frameBytes;
+        victim->done = 0;
+        victim->error = 0;
+        // keep a prefetched frame until it is used
+        victim->lastUse = _clock;
+        victim->state = Slot::reading;
+        _submit(*victim);
+        return victim;
+    }
+
+    bool _direct{false}; // set by _open(), declared before _file
+    File _file;
+    std::unique_ptr<Slot[]> _slots;
+    size_t _bufferSize{0};
+    uint64_t _clock{0};
+};
+
+/** Reads with pread() from a pool of threads, one per buffer */
+class PreadFrameReader : public BufferedFrameReader
+{
+public:
+    PreadFrameReader(const std::string& filename, const uint64_t nbFrames,
+                     const uint64_t frameSize, const size_t queueDepth)
+        : BufferedFrameReader(filename, nbFrames, frameSize, queueDepth)
+    {
+        for (size_t i = 0; i < queueDepth; ++i)
+            _threads.emplace_back([this] { _run(); });
+    }
+
+    ~PreadFrameReader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopped = true;
+        }
+        _condition.notify_all();
+        for (auto& thread : _threads)
+            thread.join();
+    }
+
+    FrameReaderType getType() const final { return FrameReaderType::pread; }
+
+private:
+    void _submit(Slot& slot) final
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back(&slot);
+        }
+        _condition.notify_all();
+    }
+
+    void _reap(const bool wait) final
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (wait)
+            _condition.wait(lock, [this] { return _nbCompleted > _nbReaped; });
+        _nbReaped = _nbCompleted;
+    }
+
+    void _run()
+    {
+        for (;;)
+        {
+            Slot* slot = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock,
+                                [this] { return _stopped || !_queue.empty(); });
+                if (_stopped)
+                    return;
+                slot = _queue.front();
+                _queue.pop_front();
+            }
+
+            // the rest of a partial read is read by this thread as well
+            for (;;)
+            {
+                const auto result =
+                    ::pread(_getFd(), slot->buffer.get() + slot->done,
+                            _getReadSize(*slot), slot->offset + slot->done);
+                if (result < 0 && errno == EINTR)
+                    continue;
+                if (!_complete(*slot, result < 0 ? -errno : result))
+                    break;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                ++_nbCompleted;
+            }
+            _condition.notify_all();
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<Slot*> _queue;
+    uint64_t _nbCompleted{0};
+    uint64_t _nbReaped{0};
+    bool _stopped{false};
+    std::vector<std::thread> _threads;
+};
+
+#ifdef BRAYNS_HAS_IO_URING
+/** Reads with io_uring, using the raw system calls */
+class IoUringFrameReader : public BufferedFrameReader
+{
+public:
+    IoUringFrameReader(const std::string& filename, const uint64_t nbFrames,
+                       const uint64_t frameSize, const size_t queueDepth)
+        : BufferedFrameReader(filename, nbFrames, frameSize, queueDepth)
+        , _iovecs(queueDepth)
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        _ring = ::syscall(__NR_io_uring_setup, queueDepth, &params);
+        if (_ring == -1)
+            throw std::runtime_error("io_uring not available: " +
+                                     systemError(errno));
+
+        _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(__u32);
+        _cqRingSize = params.cq_off.cqes +
+                      params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+        singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap)
+            _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+#endif
+        _sqRing = _map(_sqRingSize, IORING_OFF_SQ_RING);
+        _cqRing = singleMap ? _sqRing : _map(_cqRingSize, IORING_OFF_CQ_RING);
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        _sqes = static_cast<io_uring_sqe*>(_map(_sqesSize, IORING_OFF_SQES));
+
+        auto sq = static_cast<char*>(_sqRing);
+        _sqHead = reinterpret_cast<__u32*>(sq + params.sq_off.head);
+        _sqTail = reinterpret_cast<__u32*>(sq + params.sq_off.tail);
+        _sqMask = *reinterpret_cast<__u32*>(sq + params.sq_off.ring_mask);
+        _sqArray = reinterpret_cast<__u32*>(sq + params.sq_off.array);
+        auto cq = static_cast<char*>(_cqRing);
+        _cqHead = reinterpret_cast<__u32*>(cq + params.cq_off.head);
+        _cqTail = reinterpret_cast<__u32*>(cq + params.cq_off.tail);
+        _cqMask = *reinterpret_cast<__u32*>(cq + params.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    ~IoUringFrameReader()
+    {
+        // wait for the reads in flight, they write to the buffers
+        while (_inFlight > 0)
+            _reap(true);
+        _unmap();
+    }
+
+    FrameReaderType getType() const final { return FrameReaderType::io_uring; }
+
+private:
+    void* _map(const size_t size, const off_t offset)
+    {
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, _ring, offset);
+        if (ptr == MAP_FAILED)
+        {
+            const auto error = errno;
+            _unmap();
+            throw std::runtime_error("Could not map io_uring: " +
+                                     systemError(error));
+        }
+        return ptr;
+    }
+
+    void _unmap()
+    {
+        if (_sqes)
+            ::munmap(_sqes, _sqesSize);
+        if (_cqRing && _cqRing != _sqRing)
+            ::munmap(_cqRing, _cqRingSize);
+        if (_sqRing)
+            ::munmap(_sqRing, _sqRingSize);
+        if (_ring != -1)
+            ::close(_ring);
+        _sqes = nullptr;
+        _cqRing = _sqRing = nullptr;
+        _ring = -1;
+    }
+
+    void _submit(Slot& slot) final
+    {
+        const size_t index = _getIndex(slot);
+        _iovecs[index].iov_base = slot.buffer.get() + slot.done;
+        _iovecs[index].iov_len = _getReadSize(slot);
+
+        // a slot has at most one read in flight, the queue never overflows
+        const __u32 tail = *_sqTail;
+        const __u32 sqIndex = tail & _sqMask;
+        io_uring_sqe& sqe = _sqes[sqIndex];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = _getFd();
+        sqe.off = slot.offset + slot.done;
+        sqe.addr = reinterpret_cast<__u64>(&_iovecs[index]);
+        sqe.len = 1;
+        sqe.user_data = index;
+        _sqArray[sqIndex] = sqIndex;
+        __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++_inFlight;
+
+        while (::syscall(__NR_io_uring_enter, _ring, 1, 0, 0, nullptr, 0) < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+
+            // The kernel only reads the queue in io_uring_enter. An entry it
+            // has consumed completes with a CQE, the slot stays in flight
+            // until then. Otherwise the entry is withdrawn, so that the next
+            // submission does not send it for a slot that is reused.
+            if (__atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) != tail)
+                break;
+            __atomic_store_n(_sqTail, tail, __ATOMIC_RELEASE);
+            --_inFlight;
+            slot.error = errno;
+            slot.state = Slot::failed;
+            break;
+        }
+    }
+
+    void _reap(const bool wait) final
+    {
+        __u32 head = *_cqHead;
+        if (wait && _inFlight > 0 &&
+            head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+        {
+            while (::syscall(__NR_io_uring_enter, _ring, 0, 1,
+                             IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+                   errno == EINTR)
+            {
+            }
+        }
+
+        while (head != __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+        {
+            const io_uring_cqe& cqe = _cqes[head & _cqMask];
+            auto& slot = _getSlot(cqe.user_data);
+            const auto result = cqe.res;
+            ++head;
+            __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+            --_inFlight;
+            if (result == -EINTR || result == -EAGAIN ||
+                _complete(slot, result))
+            {
+                _submit(slot);
+            }
+        }
+    }
+
+    int _ring{-1};
+    void* _sqRing{nullptr};
+    void* _cqRing{nullptr};
+    size_t _sqRingSize{0};
+    size_t _cqRingSize{0};
+    size_t _sqesSize{0};
+    io_uring_sqe* _sqes{nullptr};
+    __u32* _sqHead{nullptr};
+    __u32* _sqTail{nullptr};
+    __u32 _sqMask{0};
+    __u32* _sqArray{nullptr};
+    __u32* _cqHead{nullptr};
+    __u32* _cqTail{nullptr};
+    __u32 _cqMask{0};
+    io_uring_cqe* _cqes{nullptr};
+    std::vector<iovec> _iovecs;
+    size_t _inFlight{0};
+};
+#endif
+
+/** Reads through a memory mapping of the file, prefetching with madvise */
+class MmapFrameReader : public FrameReader
+{
+public:
+    MmapFrameReader(const std::string& filename, const uint64_t nbFrames,
+                    const uint64_t frameSize, const size_t queueDepth)
+        : FrameReader(nbFrames, frameSize, queueDepth)
+    {
+        File file(::open(filename.c_str(), O_RDONLY));
+        struct stat sb;
+        if (file.fd == -1 || ::fstat(file.fd, &sb) == -1)
+            throw std::runtime_error("Could not open " + filename + ": " +
+                                     systemError(errno));
+        _size = sb.st_size;
+        _data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (_data == MAP_FAILED)
+            throw std::runtime_error("Could not map " + filename + ": " +
+                                     systemError(errno));
+    }
+
+    ~MmapFrameReader() { ::munmap(_data, _size); }
+
+    FrameReaderType getType() const final { return FrameReaderType::mmap; }
+
+    void prefetch(const uint64_t frame) final
+    {
+        if (frame >= _nbFrames)
+            return;
+        static const uint64_t pageSize = ::sysconf(_SC_PAGESIZE);
+        const uint64_t position = _getPosition(frame);
+        const uint64_t start = position / pageSize * pageSize;
+        ::madvise(static_cast<char*>(_data) + start,
+                  position - start + _frameSize * sizeof(float),
+                  MADV_WILLNEED);
+    }
+
+    const float* getFrame(const uint64_t frame, bool) final
+    {
+        if (frame >= _nbFrames)
+            throw std::runtime_error("Invalid frame " + std::to_string(frame));
+        return reinterpret_cast<const float*>(static_cast<char*>(_data) +
+                                              _getPosition(frame));
+    }
+
+private:
+    uint64_t _getPosition(const uint64_t frame) const
+    {
+        return SIMULATION_CACHE_HEADER_SIZE +
+               frame * _frameSize * sizeof(float);
+    }
+
+    void* _data{nullptr};
+    size_t _size{0};
+};
+
+/**
+ * Reader of compressed caches: a thread reads and decodes the requested
+ * frames in order. Delta encoded frames are decoded on the last decoded
+ * frame when they follow it, from the previous key frame otherwise.
+ */
+class CompressedFrameReader : public FrameReader
+{
+public:
+    CompressedFrameReader(const std::string& filename,
+                          const CompressedSimulationCacheHeader& header,
+                          std::vector<uint64_t> offsets,
+                          const size_t queueDepth)
+        : FrameReader(header.nbFrames, header.frameSize, queueDepth)
+        , _file(::open(filename.c_str(), O_RDONLY))
+        , _bits(header.bits)
+        , _keyFrameInterval(header.keyFrameInterval)
+        , _offsets(std::move(offsets))
+        , _slots(queueDepth)
+    {
+        if (_file.fd == -1)
+            throw std::runtime_error("Could not open " + filename);
+        for (auto& slot : _slots)
+            slot.values.resize(_frameSize);
+        _chain.resize(_frameSize);
+        _thread = std::thread([this] { _run(); });
+    }
+
+    ~CompressedFrameReader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopped = true;
+        }
+        _condition.notify_all();
+        _thread.join();
+    }
+
+    FrameReaderType getType() const final { return FrameReaderType::pread; }
+
+    void prefetch(const uint64_t frame) final
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (frame < _nbFrames && !_findSlot(frame))
+            _request(frame, false);
+    }
+
+    const float* getFrame(const uint64_t frame, const bool wait) final
+    {
+        if (frame >= _nbFrames)
+            throw std::runtime_error("Invalid frame " + std::to_string(frame));
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _current = nullptr;
+        Slot* slot = _findSlot(frame);
+        if (!slot)
+            slot = _request(frame, true);
+        if (!slot)
+            return nullptr;
+        if (wait)
+            _condition.wait(lock, [slot] { return !slot->queued; });
+        else if (slot->queued)
+            return nullptr;
+
+        slot->lastUse = ++_time;
+        if (!slot->error.empty())
+        {
+            const auto error = slot->error;
+            slot->frame = NO_FRAME;
+            throw std::runtime_error(error);
+        }
+        _current = slot;
+        return slot->values.data();
+    }
+
+private:
+    static const uint64_t NO_FRAME = std::numeric_limits<uint64_t>::max();
+
+    struct Slot
+    {
+        uint64_t frame{NO_FRAME};
+        bool queued{false};
+        uint64_t lastUse{0};
+        std::string error;
+        floats values;
+    };
+
+    Slot* _findSlot(const uint64_t frame)
+    {
+        for (auto& slot : _slots)
+            if (slot.frame == frame)
+                return &slot;
+        return nullptr;
+    }
+
+    /** Queues the frame in the least recently used slot, if any */
+    Slot* _request(const uint64_t frame, const bool urgent)
+    {
+        Slot* slot = nullptr;
+        for (auto& candidate : _slots)
+            if (!candidate.queued && &candidate != _current &&
+                (!slot || candidate.lastUse < slot->lastUse))
+            {
+                slot = &candidate;
+            }
+        if (!slot)
+            return nullptr;
+
+        slot->frame = frame;
+        slot->queued = true;
+        slot->error.clear();
+        if (urgent)
+            _queue.push_front(slot);
+        else
+            _queue.push_back(slot);
+        _condition.notify_all();
+        return slot;
+    }
+
+    void _run()
+    {
+        for (;;)
+        {
+            Slot* slot = nullptr;
+            uint64_t frame = 0;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock,
+                                [this] { return _stopped || !_queue.empty(); });
+                if (_stopped)
+                    return;
+                slot = _queue.front();
+                frame = slot->frame;
+                _queue.pop_front();
+            }
+
+            std::string error;
+            try
+            {
+                _decode(frame);
+                std::copy(_chain.begin(), _chain.end(), slot->values.begin());
+            }
+            catch (const std::runtime_error& e)
+            {
+                error = e.what();
+                _chainFrame = NO_FRAME;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                slot->queued = false;
+                slot->error = error;
+            }
+            _condition.notify_all();
+        }
+    }
+
+    void _decode(const uint64_t frame)
+    {
+        const uint64_t interval = std::max(_keyFrameInterval, 1u);
+        uint64_t first = frame - frame % interval;
+        if (_chainFrame != NO_FRAME && _chainFrame >= first &&
+            _chainFrame < frame)
+        {
+            first = _chainFrame + 1;
+        }
+        else if (_chainFrame == frame)
+            return;
+
+        for (uint64_t i = first; i <= frame; ++i)
+        {
+            const uint64_t size = _offsets[i + 1] - _offsets[i];
+            _encoded.resize(size + SIMULATION_FRAME_PADDING);
+            size_t done = 0;
+            while (done < size)
+            {
+                const auto result = ::pread(_file.fd, _encoded.data() + done,
+                                            size - done, _offsets[i] + done);
+                if (result < 0 && errno == EINTR)
+                    continue;
+                if (result <= 0)
+                    throw std::runtime_error(
+                        "Could not read frame " + std::to_string(i) + ": " +
+                        systemError(result < 0 ? errno : EIO));
+                done += result;
+            }
+            _chainFrame = NO_FRAME;
+            decodeSimulationFrame(_encoded.data(), size, _frameSize, _bits,
+                                  !isSimulationKeyFrame(i, _keyFrameInterval),
+                                  _chain.data());
+            _chainFrame = i;
+        }
+    }
+
+    File _file;
+    const uint32_t _bits;
+    const uint32_t _keyFrameInterval;
+    const std::vector<uint64_t> _offsets;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<Slot> _slots;
+    std::deque<Slot*> _queue;
+    Slot* _current{nullptr};
+    uint64_t _time{0};
+    bool _stopped{false};
+
+    // owned by the decoding thread
+    floats _chain;
+    uint64_t _chainFrame{NO_FRAME};
+    std::vector<uint8_t> _encoded;
+
+    std::thread _thread;
+};
+}
+
+FrameReaderPtr FrameReader::create(const FrameReaderType type,
+                                   const std::string& filename,
+                                   const size_t queueDepth)
+{
+    uint64_t header[2] = {0, 0};
+    struct stat sb;
+    {
+        File file(::open(filename.c_str(), O_RDONLY));
+        if (file.fd == -1 || ::fstat(file.fd, &sb) == -1 ||
+            ::pread(file.fd, header, sizeof(header), 0) != sizeof(header))
+        {
+            throw std::runtime_error("Could not read " + filename);
+        }
+
+        if (header[0] == COMPRESSED_SIMULATION_CACHE_MAGIC)
+        {
+            if (type != FrameReaderType::pread)
+                BRAYNS_INFO << filename << " is compressed, using pread"
+                            << std::endl;
+            CompressedSimulationCacheHeader compressed;
+            std::vector<uint64_t> offsets;
+            if (::pread(file.fd, &compressed, sizeof(compressed), 0) ==
+                    sizeof(compressed) &&
+                compressed.nbFrames < uint64_t(sb.st_size) / sizeof(uint64_t))
+            {
+                offsets.resize(compressed.nbFrames + 1);
+            }
+            const ssize_t indexSize = offsets.size() * sizeof(uint64_t);
+            if (offsets.empty() ||
+                ::pread(file.fd, offsets.data(), indexSize,
+                        sizeof(compressed)) != indexSize ||
+                !std::is_sorted(offsets.begin(), offsets.end()) ||
+                offsets.back() > uint64_t(sb.st_size))
+            {
+                throw std::runtime_error(filename +
+                                         " is not a complete cache file");
+            }
+            return FrameReaderPtr(
+                new CompressedFrameReader(filename, compressed,
+                                          std::move(offsets),
+                                          std::max(queueDepth, size_t(1))));
+        }
+    }
+
+    const uint64_t nbFrames = header[0];
+    const uint64_t frameSize = header[1];
+    if (uint64_t(sb.st_size) < SIMULATION_CACHE_HEADER_SIZE +
+                                   nbFrames * frameSize * sizeof(float))
+    {
+        throw std::runtime_error(filename + " is not a complete cache file");
+    }
+
+    const size_t depth = std::max(queueDepth, size_t(1));
+    switch (type)
+    {
+    case FrameReaderType::mmap:
+        return FrameReaderPtr(
+            new MmapFrameReader(filename, nbFrames, frameSize, depth));
+    case FrameReaderType::io_uring:
+#ifdef BRAYNS_HAS_IO_URING
+        try
+        {
+            return FrameReaderPtr(
+                new IoUringFrameReader(filename, nbFrames, frameSize, depth));
+        }
+        catch (const std::runtime_error& e)
+        {
+            BRAYNS_WARN << e.what() << ", using pread" << std::endl;
+        }
+#else
+        BRAYNS_WARN << "io_uring not supported, using pread" << std::endl;
+#endif
+    // fall through
+    case FrameReaderType::pread:
+    default:
+        return FrameReaderPtr(
+            new PreadFrameReader(filename, nbFrames, frameSize, depth));
+    }
+}
+}
@@ -0,0 +1,91 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * Reads the frames of a simulation cache file, see SimulationCacheWriter.
+ *
+ * Frames are prefetched ahead of their use: up to getQueueDepth() frames are
+ * read concurrently and kept in memory. The backends are:
+ * - mmap: page faults in a memory mapping of the file, with read-ahead hints
+ * - pread: a pool of threads reading into buffers pinned in memory
+ * - io_uring: asynchronous reads submitted in batches to the kernel; falls
+ *   back to pread if io_uring is not supported by the system
+ *
+ * A reader must be used from a single thread.
+ */
+class FrameReader
+{
+public:
+    static const size_t DEFAULT_QUEUE_DEPTH = 8;
+
+    /**
+     * @param type the backend used to read the frames
+     * @param filename the simulation cache file
+     * @param queueDepth maximum number of frames read at once
+     * @throw std::runtime_error if the file is not a valid cache
+     */
+    BRAYNS_API static FrameReaderPtr create(
+        FrameReaderType type, const std::string& filename,
+        size_t queueDepth = DEFAULT_QUEUE_DEPTH);
+
+    virtual ~FrameReader() = default;
+
+    /** @return the backend actually used by this reader */
+    virtual FrameReaderType getType() const = 0;
+
+    uint64_t getNbFrames() const { return _nbFrames; }
+    uint64_t getFrameSize() const { return _frameSize; }
+    size_t getQueueDepth() const { return _queueDepth; }
+
+    /**
+     * Starts reading the frame if it is not in memory yet; does not block.
+     * Does nothing if all buffers are busy reading.
+     */
+    virtual void prefetch(uint64_t frame) = 0;
+
+    /**
+     * @param frame the frame to get, read if not prefetched
+     * @param wait block until the frame is read
+     * @return the values of the frame, valid until the next call to the
+     *         reader; nullptr if the frame is not read yet and wait is false
+     * @throw std::runtime_error if the frame could not be read
+     */
+    virtual const float* getFrame(uint64_t frame, bool wait) = 0;
+
+protected:
+    FrameReader(uint64_t nbFrames, uint64_t frameSize, size_t queueDepth)
+        : _nbFrames(nbFrames)
+        , _frameSize(frameSize)
+        , _queueDepth(queueDepth)
+    {
+    }
+
+    const uint64_t _nbFrames;
+    const uint64_t _frameSize;
+    const size_t _queueDepth;
+};
+}
@@ -0,0 +1,238 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "SimulationCacheCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace brayns
+{
+namespace
+{
+// values packed together with the same number of bits
+const uint64_t BLOCK_SIZE = 128;
+const uint32_t MAX_BITS = 16;
+
+uint64_t getNbBlocks(const uint64_t frameSize)
+{
+    return (frameSize + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+/** @return the size of the offset, step, bases and widths of a frame */
+uint64_t getFrameHeaderSize(const uint64_t frameSize)
+{
+    return 2 * sizeof(float) + getNbBlocks(frameSize) * 3;
+}
+
+inline float dequantize(const uint32_t value, const float offset,
+                        const float step)
+{
+    return offset + float(value) * step;
+}
+
+/** Appends the values of a block minus the base, width bits each */
+void pack(const uint32_t* values, const uint32_t base, const uint32_t width,
+          std::vector<uint8_t>& data)
+{
+    uint64_t buffer = 0;
+    uint32_t nbBits = 0;
+    for (uint64_t i = 0; i < BLOCK_SIZE; ++i)
+    {
+        buffer |= uint64_t(values[i] - base) << nbBits;
+        nbBits += width;
+        for (; nbBits >= 8; nbBits -= 8)
+        {
+            data.push_back(buffer & 0xff);
+            buffer >>= 8;
+        }
+    }
+}
+
+/**
+ * Unpacks a block with a width known at compile time, so that the shifts
+ * and masks are constants and the loop can be unrolled and vectorized.
+ * Reads up to 8 bytes after the block.
+ */
+template <uint32_t Width>
+void unpack(const uint8_t* data, uint32_t* values)
+{
+    const uint64_t mask = (uint64_t(1) << Width) - 1;
+    for (uint32_t i = 0; i < BLOCK_SIZE; ++i)
+    {
+        const uint32_t bit = i * Width;
+        uint64_t word;
+        std::memcpy(&word, data + bit / 8, sizeof(word));
+        values[i] = (word >> (bit % 8)) & mask;
+    }
+}
+
+template <>
+void unpack<0>(const uint8_t*, uint32_t* values)
+{
+    std::fill(values, values + BLOCK_SIZE, 0);
+}
+
+typedef void (*Unpacker)(const uint8_t*, uint32_t*);
+const Unpacker UNPACKERS[MAX_BITS + 1] = {
+    unpack<0>,  unpack<1>,  unpack<2>,  unpack<3>,  unpack<4>,  unpack<5>,
+    unpack<6>,  unpack<7>,  unpack<8>,  unpack<9>,  unpack<10>, unpack<11>,
+    unpack<12>, unpack<13>, unpack<14>, unpack<15>, unpack<16>};
+}
+
+SimulationFrameEncoder::SimulationFrameEncoder(
+    const uint64_t frameSize, const SimulationCacheFormat& format)
+    : _frameSize(frameSize)
+    , _format(format)
+    , _decoded(frameSize, 0.f)
+    , _signal(frameSize)
+    , _quantized(getNbBlocks(frameSize) * BLOCK_SIZE)
+{
+    if (format.bits != 8 && format.bits != 16)
+        throw std::runtime_error("Simulation values can only be quantized on "
+                                 "8 or 16 bits");
+}
+
+void SimulationFrameEncoder::encode(const float* values,
+                                    std::vector<uint8_t>& data)
+{
+    const bool delta = !isSimulationKeyFrame(_frame++,
+                                             _format.keyFrameInterval);
+
+    float minValue = std::numeric_limits<float>::max();
+    float maxValue = std::numeric_limits<float>::lowest();
+    for (uint64_t i = 0; i < _frameSize; ++i)
+    {
+        _signal[i] = delta ? values[i] - _decoded[i] : values[i];
+        minValue = std::min(minValue, _signal[i]);
+        maxValue = std::max(maxValue, _signal[i]);
+    }
+    if (_frameSize == 0)
+        minValue = maxValue = 0.f;
+
+    const uint32_t levels = (1u << _format.bits) - 1;
+    float step = (maxValue - minValue) / levels;
+    if (!std::isfinite(step) || step <= 0.f)
+        step = 0.f;
+    const float scale = step > 0.f ? 1.f / step : 0.f;
+
+    float magnitude = 0.f;
+    for (uint64_t i = 0; i < _frameSize; ++i)
+    {
+        const float position = (_signal[i] - minValue) * scale + 0.5f;
+        const uint32_t value =
+            std::min<float>(levels, std::max(0.f, position));
+        const float decoded =
+            delta ? _decoded[i] + dequantize(value, minValue, step)
+                  : dequantize(value, minValue, step);
+        _maxError = std::max(_maxError, std::abs(decoded - values[i]));
+        magnitude = std::max({magnitude, std::abs(values[i]),
+                              std::abs(decoded)});
+        _decoded[i] = decoded;
+        _quantized[i] = value;
+    }
+    // the values are rounded to floats around their magnitude, not the step
+    _errorBound = std::max(_errorBound,
+                           step / 2.f + getSimulationRoundingError(magnitude));
+
+    const uint64_t nbBlocks = getNbBlocks(_frameSize);
+    data.resize(getFrameHeaderSize(_frameSize));
+    std::memcpy(data.data(), &minValue, sizeof(float));
+    std::memcpy(data.data() + sizeof(float), &step, sizeof(float));
+    uint8_t* bases = data.data() + 2 * sizeof(float);
+    uint8_t* widths = bases + nbBlocks * sizeof(uint16_t);
+
+    for (uint64_t block = 0; block < nbBlocks; ++block)
+    {
+        // the end of the last block repeats its base, packed on no bits
+        uint32_t* blockValues = _quantized.data() + block * BLOCK_SIZE;
+        const uint64_t count =
+            std::min(BLOCK_SIZE, _frameSize - block * BLOCK_SIZE);
+        const auto range =
+            std::minmax_element(blockValues, blockValues + count);
+        const uint16_t base = *range.first;
+        std::fill(blockValues + count, blockValues + BLOCK_SIZE, base);
+
+        uint32_t width = 0;
+        while ((*range.second - base) >> width)
+            ++width;
+
+        std::memcpy(bases + block * sizeof(uint16_t), &base, sizeof(base));
+        widths[block] = width;
+        pack(blockValues, base, width, data);
+        // pack() may reallocate the data
+        bases = data.data() + 2 * sizeof(float);
+        widths = bases + nbBlocks * sizeof(uint16_t);
+    }
+}
+
+void decodeSimulationFrame(const uint8_t* data, const uint64_t size,
+                           const uint64_t frameSize, const uint32_t bits,
+                           const bool delta, float* values)
+{
+    const uint64_t nbBlocks = getNbBlocks(frameSize);
+    const uint64_t headerSize = getFrameHeaderSize(frameSize);
+    if (size < headerSize)
+        throw std::runtime_error("Invalid simulation frame");
+
+    float offset;
+    float step;
+    std::memcpy(&offset, data, sizeof(float));
+    std::memcpy(&step, data + sizeof(float), sizeof(float));
+    const uint8_t* bases = data + 2 * sizeof(float);
+    const uint8_t* widths = bases + nbBlocks * sizeof(uint16_t);
+
+    uint64_t packedSize = 0;
+    for (uint64_t block = 0; block < nbBlocks; ++block)
+    {
+        if (widths[block] > bits || widths[block] > MAX_BITS)
+            throw std::runtime_error("Invalid simulation frame");
+        packedSize += widths[block] * BLOCK_SIZE / 8;
+    }
+    if (headerSize + packedSize != size)
+        throw std::runtime_error("Invalid simulation frame");
+
+    const uint8_t* packed = data + headerSize;
+    uint32_t blockValues[BLOCK_SIZE];
+    for (uint64_t block = 0; block < nbBlocks; ++block)
+    {
+        const uint32_t width = widths[block];
+        UNPACKERS[width](packed, blockValues);
+        packed += width * BLOCK_SIZE / 8;
+
+        uint16_t base;
+        std::memcpy(&base, bases + block * sizeof(uint16_t), sizeof(base));
+        float* blockOutput = values + block * BLOCK_SIZE;
+        const uint64_t count =
+            std::min(BLOCK_SIZE, frameSize - block * BLOCK_SIZE);
+        if (delta)
+            for (uint64_t i = 0; i < count; ++i)
+                blockOutput[i] +=
+                    dequantize(blockValues[i] + base, offset, step);
+        else
+            for (uint64_t i = 0; i < count; ++i)
+                blockOutput[i] =
+                    dequantize(blockValues[i] + base, offset, step);
+    }
+}
+}
@@ -0,0 +1,142 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace brayns
+{
+/** First bytes of compressed simulation caches, "BRSIMZ01" */
+const uint64_t COMPRESSED_SIMULATION_CACHE_MAGIC = 0x31305a4d49535242ull;
+
+/**
+ * Header of compressed simulation caches. It is followed by the offsets in
+ * the file of the nbFrames encoded frames and of the end of the last one,
+ * as uint64_t, then by the encoded frames.
+ */
+struct CompressedSimulationCacheHeader
+{
+    uint64_t magic{COMPRESSED_SIMULATION_CACHE_MAGIC};
+    uint64_t nbFrames{0};
+    uint64_t frameSize{0};
+    uint32_t bits{0};
+    uint32_t keyFrameInterval{0};
+    float errorBound{0}; // maximum difference with the original values
+    uint32_t reserved{0};
+};
+
+/** Encoding of the frames of simulation caches */
+struct SimulationCacheFormat
+{
+    /** 32 for raw floats, 16 or 8 to quantize the values of each frame */
+    uint32_t bits{32};
+    /**
+     * Frames between two frames encoded on their own, the others are encoded
+     * as the difference with the previous frame; 0 or 1 to disable the
+     * temporal delta encoding.
+     */
+    uint32_t keyFrameInterval{0};
+
+    bool isCompressed() const { return bits != 32; }
+};
+
+/**
+ * Encodes the successive frames of a simulation. Each frame, or its
+ * difference with the previous decoded frame, is quantized on the given
+ * number of bits against its range of values. The quantized values are then
+ * packed in blocks of 128 values with the bits needed by the spread of each
+ * block. Differences are taken with the decoded frames so that the
+ * quantization errors do not accumulate.
+ */
+class SimulationFrameEncoder
+{
+public:
+    /** @throw std::runtime_error if the format is not 8 or 16 bits */
+    BRAYNS_API SimulationFrameEncoder(uint64_t frameSize,
+                                      const SimulationCacheFormat& format);
+
+    /**
+     * Encodes the next frame.
+     * @param values frameSize values
+     * @param data receives the encoded frame
+     */
+    BRAYNS_API void encode(const float* values, std::vector<uint8_t>& data);
+
+    /** @return the largest difference between a decoded and original value */
+    float getMaxError() const { return _maxError; }
+    /**
+     * @return the largest error allowed by the quantization steps and the
+     *         rounding of the values
+     */
+    float getErrorBound() const { return _errorBound; }
+
+private:
+    const uint64_t _frameSize;
+    const SimulationCacheFormat _format;
+    uint64_t _frame{0};
+    std::vector<float> _decoded;
+    std::vector<float> _signal;
+    std::vector<uint32_t> _quantized;
+    float _maxError{0};
+    float _errorBound{0};
+};
+
+/** Bytes readable after an encoded frame given to decodeSimulationFrame */
+const size_t SIMULATION_FRAME_PADDING = 8;
+
+/**
+ * Decodes a frame encoded by SimulationFrameEncoder.
+ * @param data the encoded frame, followed by SIMULATION_FRAME_PADDING bytes
+ * @param size the size of the encoded frame
+ * @param frameSize number of values of the frame
+ * @param bits number of bits of the quantization
+ * @param delta true if the frame is encoded as a difference
+ * @param values the previous frame if delta, receives the frame
+ * @throw std::runtime_error if the encoded frame is invalid
+ */
+BRAYNS_API void decodeSimulationFrame(const uint8_t* data, uint64_t size,
+                                      uint64_t frameSize, uint32_t bits,
+                                      bool delta, float* values);
+
+/** @return true if the frame is encoded without the previous one */
+inline bool isSimulationKeyFrame(const uint64_t frame,
+                                 const uint32_t keyFrameInterval)
+{
+    return keyFrameInterval <= 1 || frame % keyFrameInterval == 0;
+}
+
+/**
+ * @return the largest rounding error of the float operations that encode and
+ *         decode a value of the given magnitude, a few units in the last place
+ */
+inline float getSimulationRoundingError(const float magnitude)
+{
+    const float value = std::abs(magnitude);
+    return 4.f *
+           (std::nextafter(value, std::numeric_limits<float>::max()) - value);
+}
+}
@@ -0,0 +1,224 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "SimulationCacheWriter.h"
+
+#include <brayns/common/log.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+const size_t WRITE_ALIGNMENT = 4096;
+
+std::string systemError()
+{
+    return std::strerror(errno);
+}
+}
+
+namespace brayns
+{
+SimulationCacheWriter::SimulationCacheWriter(
+    const std::string& filename, const uint64_t nbFrames,
+    const uint64_t frameSize, const bool resume, const size_t blockSize,
+    const SimulationCacheFormat& format)
+    : _filename(filename)
+    , _nbFrames(nbFrames)
+    , _frameSize(frameSize)
+    , _blockSize(std::max(blockSize / WRITE_ALIGNMENT, size_t(1)) *
+                 WRITE_ALIGNMENT)
+    , _format(format)
+{
+    if (format.isCompressed())
+    {
+        if (resume)
+            throw std::runtime_error(
+                "Compressed simulation caches can not be resumed");
+        _encoder.reset(new SimulationFrameEncoder(frameSize, format));
+    }
+
+    void* buffer = nullptr;
+    if (posix_memalign(&buffer, WRITE_ALIGNMENT, _blockSize) != 0)
+        throw std::runtime_error("Could not allocate write buffer");
+    _buffer.reset(static_cast<char*>(buffer));
+
+    _fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if (_fd == -1)
+        throw std::runtime_error("Could not open " + filename + ": " +
+                                 systemError());
+
+    uint64_t header[2] = {0, 0};
+    struct stat sb;
+    const bool hasHeader =
+        ::fstat(_fd, &sb) == 0 &&
+        uint64_t(sb.st_size) >= SIMULATION_CACHE_HEADER_SIZE &&
+        ::pread(_fd, header, sizeof(header), 0) == sizeof(header);
+
+    if (_encoder)
+    {
+        // the header and frame offsets are written on close
+        _frameOffsets.reserve(nbFrames + 1);
+        const std::vector<char> zeros(
+            sizeof(CompressedSimulationCacheHeader) +
+            (nbFrames + 1) * sizeof(uint64_t));
+        _write(zeros.data(), zeros.size());
+    }
+    else if (resume && hasHeader && header[0] == nbFrames &&
+             header[1] == frameSize)
+    {
+        // keep the complete frames only, the last one may be partial
+        const uint64_t frameBytes = frameSize * sizeof(float);
+        const uint64_t dataSize = sb.st_size - SIMULATION_CACHE_HEADER_SIZE;
+        _nbWrittenFrames =
+            frameBytes == 0 ? nbFrames
+                            : std::min(nbFrames, dataSize / frameBytes);
+        _bufferOffset =
+            SIMULATION_CACHE_HEADER_SIZE + _nbWrittenFrames * frameBytes;
+        BRAYNS_INFO << "Resuming " << filename << " after frame "
+                    << _nbWrittenFrames << std::endl;
+    }
+    else
+    {
+        if (resume && hasHeader)
+            BRAYNS_WARN << filename << " was created for another report, "
+                        << "overwriting it" << std::endl;
+        header[0] = nbFrames;
+        header[1] = frameSize;
+        _write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+
+    if (::ftruncate(_fd, _bufferOffset) != 0)
+        throw std::runtime_error("Could not truncate " + filename + ": " +
+                                 systemError());
+}
+
+SimulationCacheWriter::~SimulationCacheWriter()
+{
+    if (_fd != -1)
+        ::close(_fd);
+}
+
+void SimulationCacheWriter::append(const float* frames,
+                                   const uint64_t nbFrames)
+{
+    if (_nbWrittenFrames + nbFrames > _nbFrames)
+        throw std::runtime_error("Too many frames for " + _filename);
+    if (_encoder)
+    {
+        for (uint64_t i = 0; i < nbFrames; ++i)
+        {
+            _frameOffsets.push_back(getSizeInBytes());
+            _encoder->encode(frames + i * _frameSize, _encodedFrame);
+            _write(reinterpret_cast<const char*>(_encodedFrame.data()),
+                   _encodedFrame.size());
+        }
+    }
+    else
+        _write(reinterpret_cast<const char*>(frames),
+               nbFrames * _frameSize * sizeof(float));
+    _nbWrittenFrames += nbFrames;
+}
+
+void SimulationCacheWriter::close()
+{
+    if (_fd == -1)
+        return;
+    _flush();
+    if (_encoder)
+        _writeIndex();
+    const bool synced = ::fdatasync(_fd) == 0;
+    const bool closed = ::close(_fd) == 0;
+    _fd = -1;
+    if (!synced || !closed)
+        throw std::runtime_error("Could not write " + _filename + ": " +
+                                 systemError());
+}
+
+void SimulationCacheWriter::_writeIndex()
+{
+    if (_nbWrittenFrames != _nbFrames)
+        throw std::runtime_error("Missing frames in " + _filename);
+    _frameOffsets.push_back(getSizeInBytes());
+
+    CompressedSimulationCacheHeader header;
+    header.nbFrames = _nbFrames;
+    header.frameSize = _frameSize;
+    header.bits = _format.bits;
+    header.keyFrameInterval = _format.keyFrameInterval;
+    header.errorBound =
+        std::max(_encoder->getErrorBound(), _encoder->getMaxError());
+
+    std::vector<char> data(sizeof(header));
+    std::memcpy(data.data(), &header, sizeof(header));
+    data.insert(data.end(),
+                reinterpret_cast<const char*>(_frameOffsets.data()),
+                reinterpret_cast<const char*>(_frameOffsets.data() +
+                                              _frameOffsets.size()));
+    if (::pwrite(_fd, data.data(), data.size(), 0) != ssize_t(data.size()))
+        throw std::runtime_error("Could not write " + _filename + ": " +
+                                 systemError());
+}
+
+void SimulationCacheWriter::_write(const char* data, size_t size)
+{
+    while (size > 0)
+    {
+        // fill the buffer up to the next block boundary of the file, so that
+        // all writes but the first and last ones are aligned full blocks
+        const size_t end = _bufferOffset + _bufferSize;
+        const size_t available = _blockSize - end % _blockSize;
+        const size_t count = std::min(size, available);
+        std::memcpy(_buffer.get() + _bufferSize, data, count);
+        _bufferSize += count;
+        data += count;
+        size -= count;
+        if (count == available)
+            _flush();
+    }
+}
+
+void SimulationCacheWriter::_flush()
+{
+    size_t written = 0;
+    while (written < _bufferSize)
+    {
+        const auto result = ::pwrite(_fd, _buffer.get() + written,
+                                     _bufferSize - written,
+                                     _bufferOffset + written);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            throw std::runtime_error("Could not write " + _filename + ": " +
+                                     systemError());
+        written += result;
+    }
+    _bufferOffset += _bufferSize;
+    _bufferSize = 0;
+}
+}
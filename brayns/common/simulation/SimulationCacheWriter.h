@@ -0,0 +1,141 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/simulation/SimulationCacheCodec.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brayns
+{
+/** Size of the header of simulation cache files: number of frames and frame
+ * size, both as uint64_t */
+const uint64_t SIMULATION_CACHE_HEADER_SIZE = 2 * sizeof(uint64_t);
+
+/** Suffix of the text file next to a cache of a compartment report, holding
+ * the start time and the step between frames of the converted simulation */
+const std::string SIMULATION_CACHE_TIMES_SUFFIX = ".times";
+
+/**
+ * Writes simulation cache files, as read by
+ * AbstractSimulationHandler::attachSimulationToCacheFile, with large
+ * sequential writes aligned on the block size. Frames are appended in order.
+ *
+ * A cache can be resumed: the complete frames of an existing file with the
+ * same header are kept and appending continues after them.
+ *
+ * With a compressed format, the frames are quantized and packed by
+ * SimulationFrameEncoder, see CompressedSimulationCacheHeader for the layout.
+ * Compressed caches can not be resumed.
+ */
+class SimulationCacheWriter
+{
+public:
+    /** Default size of the writes, a multiple of the filesystem block size */
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024 * 1024;
+
+    /**
+     * Opens the cache file for writing.
+     * @param filename the cache file
+     * @param nbFrames number of frames of the complete cache
+     * @param frameSize number of values per frame
+     * @param resume keep the complete frames of an existing cache with the
+     *        same number of frames and frame size, instead of overwriting it
+     * @param blockSize size of the writes, multiple of 4096
+     * @param format encoding of the frames
+     * @throw std::runtime_error if the file can not be opened, or a
+     *        compressed cache is resumed
+     */
+    BRAYNS_API SimulationCacheWriter(
+        const std::string& filename, uint64_t nbFrames, uint64_t frameSize,
+        bool resume, size_t blockSize = DEFAULT_BLOCK_SIZE,
+        const SimulationCacheFormat& format = SimulationCacheFormat());
+
+    /** Closes the file; frames not yet flushed with close() are lost. */
+    BRAYNS_API ~SimulationCacheWriter();
+
+    /** @return the number of frames in the cache, including resumed ones */
+    uint64_t getNbFrames() const { return _nbWrittenFrames; }
+
+    /** @return the size of the file, including the pending data */
+    uint64_t getSizeInBytes() const { return _bufferOffset + _bufferSize; }
+
+    /**
+     * @return the largest difference between the cached and original values,
+     *         0 for raw frames
+     */
+    float getMaxError() const
+    {
+        return _encoder ? _encoder->getMaxError() : 0.f;
+    }
+
+    /** @return the largest error allowed by the quantization, 0 if raw */
+    float getErrorBound() const
+    {
+        return _encoder ? _encoder->getErrorBound() : 0.f;
+    }
+
+    /**
+     * Appends frames after the last one.
+     * @param frames nbFrames * frameSize values
+     * @throw std::runtime_error on write error, or if more frames than
+     *        announced are appended
+     */
+    BRAYNS_API void append(const float* frames, uint64_t nbFrames);
+
+    /**
+     * Writes the pending data and syncs the file to disk.
+     * @throw std::runtime_error on write error, or if a compressed cache
+     *        does not have all its frames
+     */
+    BRAYNS_API void close();
+
+private:
+    void _write(const char* data, size_t size);
+    void _writeIndex();
+    void _flush();
+
+    const std::string _filename;
+    const uint64_t _nbFrames;
+    const uint64_t _frameSize;
+    const size_t _blockSize;
+    const SimulationCacheFormat _format;
+
+    int _fd{-1};
+    uint64_t _nbWrittenFrames{0};
+
+    struct FreeDeleter
+    {
+        void operator()(char* ptr) const { free(ptr); }
+    };
+    std::unique_ptr<char, FreeDeleter> _buffer;
+    uint64_t _bufferOffset{0}; // position of the buffer in the file
+    size_t _bufferSize{0};
+
+    std::unique_ptr<SimulationFrameEncoder> _encoder;
+    std::vector<uint64_t> _frameOffsets;
+    std::vector<uint8_t> _encodedFrame;
+};
+}
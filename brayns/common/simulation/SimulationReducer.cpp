@@ -0,0 +1,117 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "SimulationReducer.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace brayns
+{
+SimulationReducer::SimulationReducer(const SimulationReduction reduction)
+    : _reduction(reduction)
+{
+    if (reduction == SimulationReduction::none)
+        throw std::runtime_error("No aggregation for the simulation reducer");
+}
+
+uint64_t SimulationReducer::addValue()
+{
+    _valueRanges.push_back(_ranges.size());
+    return _valueRanges.size() - 2;
+}
+
+void SimulationReducer::addRange(const uint64_t offset, const uint64_t count)
+{
+    if (_valueRanges.size() < 2)
+        throw std::runtime_error("Range added before any reduced value");
+    if (count == 0)
+        return;
+
+    // extend the last range of the value if contiguous
+    if (_ranges.size() > _valueRanges[_valueRanges.size() - 2] &&
+        _ranges.back().offset + _ranges.back().count == offset)
+        _ranges.back().count += count;
+    else
+    {
+        _ranges.push_back({offset, count});
+        _valueRanges.back() = _ranges.size();
+    }
+}
+
+uint64_t SimulationReducer::getLayoutHash() const
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    const auto combine = [&hash](const uint64_t value) {
+        hash = (hash ^ value) * 1099511628211ull;
+    };
+    combine(static_cast<uint64_t>(_reduction));
+    for (const auto valueRange : _valueRanges)
+        combine(valueRange);
+    for (const auto& range : _ranges)
+    {
+        combine(range.offset);
+        combine(range.count);
+    }
+    return hash;
+}
+
+void SimulationReducer::reduce(const float* frame, const uint64_t frameSize,
+                               float* values) const
+{
+    const bool useMax = _reduction == SimulationReduction::section_max ||
+                        _reduction == SimulationReduction::cell_max;
+    const int64_t nbValues = getFrameSize();
+
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < nbValues; ++i)
+    {
+        float max = -std::numeric_limits<float>::max();
+        double sum = 0;
+        uint64_t count = 0;
+        for (auto r = _valueRanges[i]; r < _valueRanges[i + 1]; ++r)
+        {
+            const auto& range = _ranges[r];
+            if (range.offset >= frameSize)
+                continue;
+            const auto begin = frame + range.offset;
+            const auto end =
+                frame + std::min(range.offset + range.count, frameSize);
+            if (useMax)
+                max = std::max(max, *std::max_element(begin, end));
+            else
+            {
+                float rangeSum = 0;
+                for (auto value = begin; value != end; ++value)
+                    rangeSum += *value;
+                sum += rangeSum;
+            }
+            count += end - begin;
+        }
+
+        if (count == 0)
+            values[i] = 0;
+        else
+            values[i] = useMax ? max : float(sum / count);
+    }
+}
+}
@@ -0,0 +1,82 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * Aggregates the values of simulation frames into reduced frames, with one
+ * value per group of compartments, typically a section or a cell. At the
+ * distance a whole circuit is seen from, a section covers a few pixels and
+ * its mean or maximum is all that is visible, for a fraction of the values.
+ *
+ * Each value of the reduced frames is built from one or more ranges of values
+ * of the full frames.
+ */
+class SimulationReducer
+{
+public:
+    /**
+     * @param reduction section_* or cell_*, only the aggregation (mean or max)
+     *        matters, the groups are defined by addValue() and addRange()
+     */
+    BRAYNS_API explicit SimulationReducer(SimulationReduction reduction);
+
+    /** Starts a new value of the reduced frames; @return its offset */
+    BRAYNS_API uint64_t addValue();
+
+    /** Aggregates count values of the full frames, from offset, into the last
+     * value added */
+    BRAYNS_API void addRange(uint64_t offset, uint64_t count);
+
+    SimulationReduction getReduction() const { return _reduction; }
+    /** @return the number of values of the reduced frames */
+    uint64_t getFrameSize() const { return _valueRanges.size() - 1; }
+    /** @return a hash of the aggregation and of the ranges of all values, to
+     * tell if cached reduced frames match this reducer */
+    BRAYNS_API uint64_t getLayoutHash() const;
+
+    /**
+     * Reduces a frame; can be called concurrently.
+     * @param frame the values of the full frame
+     * @param frameSize the number of values of the full frame, values out of
+     *        the frame are ignored
+     * @param values getFrameSize() values; 0 for the values without any
+     *        compartment in the frame
+     */
+    BRAYNS_API void reduce(const float* frame, uint64_t frameSize,
+                           float* values) const;
+
+private:
+    struct Range
+    {
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    const SimulationReduction _reduction;
+    std::vector<Range> _ranges;
+    uint64_ts _valueRanges{0}; // first range of each value, and end
+};
+}
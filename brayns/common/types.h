@@ -31,6 +31,7 @@
     friend void staticjson::init(type*, staticjson::ObjectHandler*);
 
 #include <brayns/common/mathTypes.h>
+#include <brayns/common/utils/MappedAllocator.h>
 
 #include <cstdint>
 #include <limits>
@@ -115,15 +116,15 @@ typedef std::shared_ptr<Material> MaterialPtr;
 typedef std::map<size_t, MaterialPtr> MaterialMap;
 
 struct Sphere;
-typedef std::vector<Sphere> Spheres;
+typedef MappedVector<Sphere> Spheres;
 typedef std::map<size_t, Spheres> SpheresMap;
 
 struct Cylinder;
-typedef std::vector<Cylinder> Cylinders;
+typedef MappedVector<Cylinder> Cylinders;
 typedef std::map<size_t, Cylinders> CylindersMap;
 
 struct Cone;
-typedef std::vector<Cone> Cones;
+typedef MappedVector<Cone> Cones;
 typedef std::map<size_t, Cones> ConesMap;
 
 struct TrianglesMesh;
@@ -166,6 +167,13 @@ class CADiffusionSimulationHandler;
 typedef std::shared_ptr<CADiffusionSimulationHandler>
     CADiffusionSimulationHandlerPtr;
 
+class FrameReader;
+typedef std::unique_ptr<FrameReader> FrameReaderPtr;
+class CompactFrameReader;
+typedef std::shared_ptr<CompactFrameReader> CompactFrameReaderPtr;
+class SimulationReducer;
+typedef std::shared_ptr<SimulationReducer> SimulationReducerPtr;
+
 class AbstractParameters;
 class AnimationParameters;
 class ApplicationParameters;
@@ -186,6 +194,8 @@ class KeyboardHandler;
 class MeshLoader;
 
 class Statistics;
+class PhaseTimings;
+class FrameScheduler;
 
 enum class EngineType
 {
@@ -273,6 +283,32 @@ enum class MemoryMode
     replicated
 };
 
+/** Backends reading the frames of simulation cache files */
+enum class FrameReaderType
+{
+    mmap,
+    pread,
+    io_uring
+};
+
+/** Interpolation of the simulation values between two frames */
+enum class SimulationInterpolation
+{
+    none,   // values of the previous frame
+    linear, // blend of the two frames
+    cubic   // Catmull-Rom spline through the four nearest frames
+};
+
+/** Aggregation of the compartment values of circuit simulation frames */
+enum class SimulationReduction
+{
+    none,         // one value per compartment
+    section_mean, // mean of the compartments of each section
+    section_max,  // maximum of the compartments of each section
+    cell_mean,    // mean of the compartments of each cell
+    cell_max      // maximum of the compartments of each cell
+};
+
 enum class MaterialsColorMap
 {
     none,           // Random colors
@@ -0,0 +1,97 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace brayns
+{
+/** Allocations from this size on get their own memory mapping */
+constexpr size_t MAPPED_ALLOCATION_THRESHOLD = 1 << 20;
+
+/**
+ * Allocator for the large geometry buffers of a model. Big allocations are
+ * served by anonymous memory mappings, so that their pages are given back to
+ * the system as soon as the buffer is released, instead of fragmenting the
+ * heap when models are unloaded. Small allocations fall back to malloc.
+ */
+template <typename T>
+class MappedAllocator
+{
+public:
+    using value_type = T;
+
+    MappedAllocator() = default;
+    template <typename U>
+    MappedAllocator(const MappedAllocator<U>&)
+    {
+    }
+
+    T* allocate(const size_t n)
+    {
+        const size_t size = n * sizeof(T);
+        void* ptr = nullptr;
+        if (size >= MAPPED_ALLOCATION_THRESHOLD)
+        {
+            ptr = ::mmap(0, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED)
+                ptr = nullptr;
+        }
+        else
+            ptr = std::malloc(size);
+
+        if (!ptr && size > 0)
+            throw std::bad_alloc();
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, const size_t n)
+    {
+        const size_t size = n * sizeof(T);
+        if (size >= MAPPED_ALLOCATION_THRESHOLD)
+            ::munmap(ptr, size);
+        else
+            std::free(ptr);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const MappedAllocator<T>&, const MappedAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const MappedAllocator<T>&, const MappedAllocator<U>&)
+{
+    return false;
+}
+
+/** A vector whose large buffers are returned to the system when released */
+template <typename T>
+using MappedVector = std::vector<T, MappedAllocator<T>>;
+}
@@ -0,0 +1,195 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "StreamDecompressor.h"
+
+#include <map>
+#include <stdexcept>
+
+#ifdef BRAYNS_USE_LIBARCHIVE
+#include <archive.h>
+#include <archive_entry.h>
+#endif
+
+namespace brayns
+{
+#ifdef BRAYNS_USE_LIBARCHIVE
+namespace
+{
+/**
+ * Enables the filter of the given compression on the reader.
+ * @return the status of libarchive, ARCHIVE_WARN if the filter runs an
+ *         external program, ARCHIVE_FATAL if the compression is unknown
+ */
+int supportFilter(archive* reader, const std::string& compression)
+{
+    using SupportFilter = int (*)(archive*);
+    const std::map<std::string, SupportFilter> filters{
+        {"gzip", archive_read_support_filter_gzip},
+        {"bzip2", archive_read_support_filter_bzip2},
+        {"xz", archive_read_support_filter_xz},
+#if ARCHIVE_VERSION_NUMBER >= 3002000
+        {"lz4", archive_read_support_filter_lz4},
+#endif
+#if ARCHIVE_VERSION_NUMBER >= 3003003
+        {"zstd", archive_read_support_filter_zstd},
+#endif
+    };
+    const auto filter = filters.find(compression);
+    if (filter == filters.end())
+        return ARCHIVE_FATAL;
+    return filter->second(reader);
+}
+}
+#endif
+
+bool StreamDecompressor::isSupported(const std::string& compression)
+{
+#ifdef BRAYNS_USE_LIBARCHIVE
+    // the filters are compiled in libarchive depending on the libraries found
+    // at build time, or need an external program
+    auto reader = archive_read_new();
+    const auto status = supportFilter(reader, compression);
+    archive_read_free(reader);
+    return status == ARCHIVE_OK || status == ARCHIVE_WARN;
+#else
+    (void)compression;
+    return false;
+#endif
+}
+
+StreamDecompressor::StreamDecompressor(const std::string& compression,
+                                       const DataCallback& dataCallback,
+                                       const ErrorCallback& errorCallback,
+                                       const EndCallback& endCallback)
+    : _compression(compression)
+    , _dataCallback(dataCallback)
+    , _errorCallback(errorCallback)
+    , _endCallback(endCallback)
+{
+#ifdef BRAYNS_USE_LIBARCHIVE
+    _thread = std::thread([this] { _decompress(); });
+#else
+    throw std::runtime_error(
+        "No support for compressed streams; missing libarchive");
+#endif
+}
+
+StreamDecompressor::~StreamDecompressor()
+{
+    close();
+    if (_thread.joinable())
+        _thread.join();
+}
+
+void StreamDecompressor::push(const std::string& chunk)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_closed)
+            return;
+        _chunks.push_back(chunk);
+    }
+    _condition.notify_one();
+}
+
+void StreamDecompressor::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _closed = true;
+    }
+    _condition.notify_one();
+}
+
+bool StreamDecompressor::_pop(std::string& chunk)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this] { return _closed || !_chunks.empty(); });
+    if (_chunks.empty())
+        return false;
+    chunk = std::move(_chunks.front());
+    _chunks.pop_front();
+    return true;
+}
+
+void StreamDecompressor::_decompress()
+{
+#ifdef BRAYNS_USE_LIBARCHIVE
+    // libarchive pulls the compressed data, block in the read callback until
+    // the next chunk arrives. An empty chunk tells the end of the data.
+    auto readCallback = [](archive*, void* clientData,
+                           const void** buffer) -> ssize_t {
+        auto& self = *static_cast<StreamDecompressor*>(clientData);
+        if (!self._pop(self._currentChunk))
+            self._currentChunk.clear();
+        *buffer = self._currentChunk.data();
+        return self._currentChunk.size();
+    };
+
+    // only the declared filter is enabled, other data fails to open
+    auto reader = archive_read_new();
+    supportFilter(reader, _compression);
+    archive_read_support_format_raw(reader);
+
+    auto errorString = [reader] {
+        const auto error = archive_error_string(reader);
+        return std::string(error ? error : "Invalid compressed data");
+    };
+
+    std::string error;
+    archive_entry* entry = nullptr;
+    if (archive_read_open(reader, this, nullptr, readCallback, nullptr) !=
+            ARCHIVE_OK ||
+        archive_read_next_header(reader, &entry) != ARCHIVE_OK)
+    {
+        error = errorString();
+    }
+    // without the declared filter, the data is read as is
+    else if (archive_filter_count(reader) < 2)
+        error = "Data is not compressed with " + _compression;
+    else
+    {
+        for (;;)
+        {
+            const void* buff;
+            size_t size;
+            int64_t offset;
+            const auto r =
+                archive_read_data_block(reader, &buff, &size, &offset);
+            if (r == ARCHIVE_EOF)
+                break;
+            if (r < ARCHIVE_WARN)
+            {
+                error = errorString();
+                break;
+            }
+            _dataCallback(static_cast<const char*>(buff), size);
+        }
+    }
+    archive_read_free(reader);
+
+    if (!error.empty())
+        _errorCallback(error);
+    else if (_endCallback)
+        _endCallback();
+#endif
+}
+}
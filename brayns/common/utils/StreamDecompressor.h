@@ -0,0 +1,95 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace brayns
+{
+/**
+ * Decompresses a stream of compressed chunks on a worker thread, as the chunks
+ * arrive. The compression is declared by the sender, among the filters of
+ * libarchive (gzip, bzip2, xz, lz4, zstd) available in the installed version.
+ */
+class StreamDecompressor
+{
+public:
+    /** Called from the worker thread with each block of decompressed data */
+    using DataCallback = std::function<void(const char* data, size_t size)>;
+
+    /** Called from the worker thread if the stream could not be decompressed */
+    using ErrorCallback = std::function<void(const std::string& message)>;
+
+    /** Called from the worker thread once all data was decompressed */
+    using EndCallback = std::function<void()>;
+
+    /**
+     * @return true if the decompressor has a filter for the given
+     *         compression
+     */
+    BRAYNS_API static bool isSupported(const std::string& compression);
+
+    /**
+     * @param compression the compression of the stream, data compressed
+     *        differently is reported as an error
+     */
+    BRAYNS_API StreamDecompressor(const std::string& compression,
+                                  const DataCallback& dataCallback,
+                                  const ErrorCallback& errorCallback,
+                                  const EndCallback& endCallback = {});
+
+    /** Closes the input and waits for the worker thread to finish */
+    BRAYNS_API ~StreamDecompressor();
+
+    /** Queues a chunk of compressed data, does not block */
+    BRAYNS_API void push(const std::string& chunk);
+
+    /**
+     * Signals the end of the compressed data. Must be called after the last
+     * chunk, the worker thread waits for more data otherwise.
+     */
+    BRAYNS_API void close();
+
+private:
+    void _decompress();
+    bool _pop(std::string& chunk);
+
+    std::string _compression;
+    DataCallback _dataCallback;
+    ErrorCallback _errorCallback;
+    EndCallback _endCallback;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::string> _chunks;
+    std::string _currentChunk;
+    bool _closed{false};
+
+    std::thread _thread;
+};
+}
@@ -25,8 +25,14 @@
 #include <boost/filesystem.hpp>
 namespace fs = boost::filesystem;
 
+#include <fstream>
+#include <memory>
 #include <set>
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 #ifdef BRAYNS_USE_LIBARCHIVE
 #include <archive.h>
 #include <archive_entry.h>
@@ -63,6 +69,66 @@ strings parseFolder(const std::string& folder, const strings& filters)
     return files;
 }
 
+namespace
+{
+std::string getFileStamp(const fs::path& path)
+{
+    boost::system::error_code error;
+    const auto size = fs::file_size(path, error);
+    const auto time = fs::last_write_time(path, error);
+    return path.string() + " " + std::to_string(size) + " " +
+           std::to_string(time);
+}
+}
+
+strings getInputStamps(const strings& arguments, const strings& outputOptions)
+{
+    const auto isOutput = [&outputOptions](const std::string& option) {
+        return std::find(outputOptions.begin(), outputOptions.end(),
+                         option) != outputOptions.end();
+    };
+
+    strings stamps = arguments;
+    for (size_t i = 0; i < arguments.size(); ++i)
+    {
+        const auto& argument = arguments[i];
+        if (isOutput(argument))
+        {
+            ++i;
+            continue;
+        }
+
+        // options may be given as --name=value
+        const auto equal = argument.find('=');
+        const bool isOption = argument.compare(0, 2, "--") == 0;
+        if (isOption && isOutput(argument.substr(0, equal)))
+            continue;
+        const fs::path path(isOption && equal != std::string::npos
+                                ? argument.substr(equal + 1)
+                                : argument);
+
+        boost::system::error_code error;
+        if (fs::is_regular_file(path, error))
+        {
+            stamps.push_back(getFileStamp(path));
+            continue;
+        }
+        if (!fs::is_directory(path, error))
+            continue;
+
+        strings files;
+        for (fs::recursive_directory_iterator file(path, error), end;
+             file != end; file.increment(error))
+        {
+            if (fs::is_regular_file(file->path(), error))
+                files.push_back(getFileStamp(file->path()));
+        }
+        std::sort(files.begin(), files.end());
+        stamps.insert(stamps.end(), files.begin(), files.end());
+    }
+    return stamps;
+}
+
 const std::string ELLIPSIS("...");
 
 std::string shortenString(const std::string& string, const size_t maxLength)
@@ -91,6 +157,9 @@ bool isSupportedArchiveType(const std::string& extension BRAYNS_UNUSED)
 }
 
 #ifdef BRAYNS_USE_LIBARCHIVE
+/** Frees the archive on all exit paths, including exceptions */
+using ArchivePtr = std::unique_ptr<archive, int (*)(archive*)>;
+
 archive* _openArchive(const std::string& filename)
 {
     auto archive = archive_read_new();
@@ -157,26 +226,34 @@ int copy_data(struct archive* ar, struct archive* aw)
     }
 }
 
+/**
+ * Extracts the remaining entries of the archive, starting with the given entry
+ * if its header was already read by the caller.
+ */
 void _extractArchive(archive* archive, const std::string& filename,
-                     const std::string& destination)
+                     const std::string& destination,
+                     archive_entry* entry = nullptr)
 {
-    auto writer = archive_write_disk_new();
+    ArchivePtr writerPtr(archive_write_disk_new(), archive_write_free);
+    auto writer = writerPtr.get();
     archive_write_disk_set_options(writer, 0);
     archive_write_disk_set_standard_lookup(writer);
 
-    for (;;)
+    for (;; entry = nullptr)
     {
-        archive_entry* entry;
-        auto r = archive_read_next_header(archive, &entry);
-        if (r == ARCHIVE_EOF)
-            break;
-        if (r < ARCHIVE_OK)
-            std::cerr << archive_error_string(archive) << std::endl;
-        if (r < ARCHIVE_WARN)
+        if (!entry)
         {
-            throw std::runtime_error(
-                std::string("Error reading file from archive: ") +
-                archive_error_string(archive));
+            const auto r = archive_read_next_header(archive, &entry);
+            if (r == ARCHIVE_EOF)
+                break;
+            if (r < ARCHIVE_OK)
+                std::cerr << archive_error_string(archive) << std::endl;
+            if (r < ARCHIVE_WARN)
+            {
+                throw std::runtime_error(
+                    std::string("Error reading file from archive: ") +
+                    archive_error_string(archive));
+            }
         }
         const char* currentFile = archive_entry_pathname(entry);
 
@@ -185,7 +262,7 @@ void _extractArchive(archive* archive, const std::string& filename,
             currentFile = filename.c_str();
         const std::string fullOutputPath = destination + "/" + currentFile;
         archive_entry_set_pathname(entry, fullOutputPath.c_str());
-        r = archive_write_header(writer, entry);
+        auto r = archive_write_header(writer, entry);
         if (r < ARCHIVE_OK)
             std::cerr << archive_error_string(writer) << std::endl;
         else if (archive_entry_size(entry) > 0)
@@ -206,9 +283,97 @@ void _extractArchive(archive* archive, const std::string& filename,
                 std::string("Error finishing current file: ") +
                 archive_error_string(archive));
     }
-    archive_read_free(archive);
     archive_write_close(writer);
-    archive_write_free(writer);
+}
+
+void _writeBlobs(const std::vector<Blob>& blobs, const std::string& destination)
+{
+    for (const auto& blob : blobs)
+    {
+        const auto path = fs::path(destination) / blob.name;
+        fs::create_directories(path.parent_path());
+        std::ofstream file(path.string(), std::ios::out | std::ios::binary);
+        file.write(blob.data.data(), blob.data.size());
+        if (!file.good())
+            throw std::runtime_error("Could not write " + path.string());
+    }
+}
+
+std::vector<Blob> _readArchive(ArchivePtr archivePtr,
+                               const std::string& filename,
+                               const ArchiveEntryFilter& accept,
+                               const std::string& destination)
+{
+    auto archive = archivePtr.get();
+    std::vector<Blob> blobs;
+    for (;;)
+    {
+        archive_entry* entry;
+        auto r = archive_read_next_header(archive, &entry);
+        if (r == ARCHIVE_EOF)
+            break;
+        if (r < ARCHIVE_OK)
+            std::cerr << archive_error_string(archive) << std::endl;
+        if (r < ARCHIVE_WARN)
+        {
+            const std::string error = archive_error_string(archive);
+            throw std::runtime_error("Error reading file from archive: " +
+                                     error);
+        }
+
+        // raw formats like gzip do not report a file type
+        const auto fileType = archive_entry_filetype(entry);
+        if (fileType != 0 && fileType != AE_IFREG)
+            continue;
+
+        std::string path = archive_entry_pathname(entry);
+
+        // magic 'data' file for gzip archives is useless to us, so rename it
+        if (path == "data")
+            path = filename;
+
+        if (accept && !accept(path))
+        {
+            if (destination.empty())
+                return {};
+
+            // keep the entries read so far and extract the others, without
+            // reading the archive again
+            _writeBlobs(blobs, destination);
+            _extractArchive(archive, filename, destination, entry);
+            return {};
+        }
+
+        Blob blob;
+        blob.name = path;
+        blob.type = fs::extension(path);
+        if (!blob.type.empty())
+            blob.type.erase(0, 1);
+        if (archive_entry_size_is_set(entry))
+            blob.data.reserve(archive_entry_size(entry));
+
+        const void* buff;
+        size_t size;
+        int64_t offset;
+        while ((r = archive_read_data_block(archive, &buff, &size, &offset)) ==
+               ARCHIVE_OK)
+        {
+            blob.data.resize(offset);
+            blob.data.append(static_cast<const char*>(buff), size);
+        }
+        if (r < ARCHIVE_WARN)
+        {
+            const std::string error = archive_error_string(archive);
+            throw std::runtime_error("Error reading file from archive: " +
+                                     error);
+        }
+        blobs.push_back(std::move(blob));
+    }
+
+    std::sort(blobs.begin(), blobs.end(), [](const auto& a, const auto& b) {
+        return a.name < b.name;
+    });
+    return blobs;
 }
 #endif
 
@@ -245,6 +410,7 @@ void extractFile(const std::string& filename BRAYNS_UNUSED,
     auto archive = _openArchive(filename);
     if (!archive)
         throw std::runtime_error(filename + " is not a supported archive type");
+    ArchivePtr archivePtr(archive, archive_read_free);
     _extractArchive(archive, fs::basename(filename), destination);
 #else
     throw std::runtime_error("No support for archives; missing libarchive");
@@ -258,9 +424,47 @@ void extractBlob(Blob&& blob BRAYNS_UNUSED,
     auto archive = _openArchive(blob);
     if (!archive)
         throw std::runtime_error("Blob is not a supported archive type");
+    ArchivePtr archivePtr(archive, archive_read_free);
     _extractArchive(archive, fs::basename(blob.name), destination);
 #else
     throw std::runtime_error("No support for archives; missing libarchive");
 #endif
 }
+
+std::vector<Blob> readArchive(const std::string& filename BRAYNS_UNUSED,
+                              const ArchiveEntryFilter& accept BRAYNS_UNUSED,
+                              const std::string& destination BRAYNS_UNUSED)
+{
+#ifdef BRAYNS_USE_LIBARCHIVE
+    auto archive = _openArchive(filename);
+    if (!archive)
+        throw std::runtime_error(filename + " is not a supported archive type");
+    return _readArchive({archive, archive_read_free}, fs::basename(filename),
+                        accept, destination);
+#else
+    throw std::runtime_error("No support for archives; missing libarchive");
+#endif
+}
+
+std::vector<Blob> readArchive(const Blob& blob BRAYNS_UNUSED,
+                              const ArchiveEntryFilter& accept BRAYNS_UNUSED,
+                              const std::string& destination BRAYNS_UNUSED)
+{
+#ifdef BRAYNS_USE_LIBARCHIVE
+    auto archive = _openArchive(blob);
+    if (!archive)
+        throw std::runtime_error("Blob is not a supported archive type");
+    return _readArchive({archive, archive_read_free}, fs::basename(blob.name),
+                        accept, destination);
+#else
+    throw std::runtime_error("No support for archives; missing libarchive");
+#endif
+}
+
+void releaseUnusedMemory()
+{
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
 }
@@ -23,10 +23,22 @@
 
 #include <brayns/common/types.h>
 
+#include <functional>
+
 namespace brayns
 {
 strings parseFolder(const std::string& folder, const strings& filters);
 
+/**
+ * @param arguments command line arguments
+ * @param outputOptions options, like "--frame-export-folder", whose values
+ *        are written by the application and are not inputs
+ * @return the arguments followed by the size and modification time of the
+ *         files they name, and of the files in the folders they name, to tell
+ *         if data loaded with these arguments has changed
+ */
+strings getInputStamps(const strings& arguments, const strings& outputOptions);
+
 std::string shortenString(const std::string& string,
                           const size_t maxLength = 32);
 
@@ -41,6 +53,30 @@ bool isArchive(const std::string& filename);
 bool isArchive(const Blob& blob);
 void extractFile(const std::string& filename, const std::string& destination);
 void extractBlob(Blob&& blob, const std::string& destination);
+
+/**
+ * Reads all regular files of the given archive into memory, sorted by their
+ * path in the archive. The type of each blob is the file extension.
+ *
+ * @param accept optional check of the path of each entry, before its data is
+ *        read. If an entry is rejected, no blobs are returned.
+ * @param destination optional folder where the archive is extracted if an
+ *        entry is rejected. The blobs already read are written from memory,
+ *        the archive is not read again.
+ */
+using ArchiveEntryFilter = std::function<bool(const std::string&)>;
+std::vector<Blob> readArchive(const std::string& filename,
+                              const ArchiveEntryFilter& accept = {},
+                              const std::string& destination = {});
+std::vector<Blob> readArchive(const Blob& blob,
+                              const ArchiveEntryFilter& accept = {},
+                              const std::string& destination = {});
+
+/**
+ * Gives the free memory of the heap back to the system, if supported by the C
+ * library. Meant to be called after large objects, like models, were released.
+ */
+void releaseUnusedMemory();
 }
 
 #endif // UTILS_H
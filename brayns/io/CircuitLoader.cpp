@@ -19,8 +19,11 @@
  */
 
 #include "CircuitLoader.h"
+#include "CircuitSpatialIndex.h"
 #include "circuitLoaderCommon.h"
+#include "sampleBatch.h"
 
+#include <brayns/common/loader/ProgressAggregator.h>
 #include <brayns/common/scene/Model.h>
 #include <brayns/common/scene/Scene.h>
 #include <brayns/io/simulation/CircuitSimulationHandler.h>
@@ -33,6 +36,11 @@
 #include <brayns/io/MeshLoader.h>
 #endif
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+
 namespace brayns
 {
 class CircuitLoader::Impl
@@ -81,29 +89,20 @@ public:
             else
                 localTargets = targets;
 
+            const auto& aabb = _geometryParameters.getCircuitBoundingBox();
             for (const auto& target : localTargets)
             {
-                const auto targetGids = circuit.getRandomGIDs(
-                    circuitDensity, target,
-                    _geometryParameters.getCircuitRandomSeed());
-                const Matrix4fs& allTransformations =
-                    circuit.getTransforms(targetGids);
-
+                // The density applies to the cells in the bounding box
                 brain::GIDSet gids;
-                const auto& aabb = _geometryParameters.getCircuitBoundingBox();
                 if (aabb.getSize() == Vector3f(0.f))
-                    gids = targetGids;
+                    gids = circuit.getRandomGIDs(
+                        circuitDensity, target,
+                        _geometryParameters.getCircuitRandomSeed());
                 else
-                {
-                    auto gidIterator = targetGids.begin();
-                    for (size_t i = 0; i < allTransformations.size(); ++i)
-                    {
-                        if (aabb.isIn(Vector3d(
-                                allTransformations[i].getTranslation())))
-                            gids.insert(*gidIterator);
-                        ++gidIterator;
-                    }
-                }
+                    gids = _getRandomGIDs(
+                        _getGIDsInBoundingBox(circuit, source,
+                                              circuit.getGIDs(target)),
+                        circuitDensity);
 
                 if (gids.empty())
                 {
@@ -122,25 +121,24 @@ public:
                 return {};
 
             // Load simulation information from compartment report
-            CompartmentReportPtr compartmentReport = nullptr;
+            CircuitSimulationHandlerPtr simulationHandler;
             if (!report.empty())
                 try
                 {
-                    CircuitSimulationHandlerPtr simulationHandler(
+                    simulationHandler.reset(
                         new CircuitSimulationHandler(_applicationParameters,
                                                      _geometryParameters,
                                                      bc.getReportSource(report),
                                                      allGids));
-                    compartmentReport =
-                        simulationHandler->getCompartmentReport();
                     // Only keep simulated GIDs
-                    if (compartmentReport)
-                        allGids = compartmentReport->getGIDs();
+                    allGids = simulationHandler->getCompartmentReport()
+                                  ->getGIDs();
                     // Attach simulation handler
                     _parent._scene.setSimulationHandler(simulationHandler);
                 }
                 catch (const std::exception& e)
                 {
+                    simulationHandler.reset();
                     BRAYNS_ERROR << e.what() << std::endl;
                 }
 
@@ -169,11 +167,18 @@ public:
             {
                 MorphologyLoader morphLoader(_parent._scene,
                                              _geometryParameters);
+                if (_geometryParameters.getCircuitBoundingBoxClipping() &&
+                    aabb.getSize() != Vector3f(0.f))
+                {
+                    morphLoader._setClippingBox(
+                        {Vector3f(aabb.getMin()), Vector3f(aabb.getMax())});
+                }
                 returnValue =
                     returnValue &&
                     _importMorphologies(circuit, *model, allGids,
                                         transformations, targetGIDOffsets,
-                                        compartmentReport, morphLoader);
+                                        simulationHandler, morphLoader);
+                _initializeCellMask(*model, allGids, simulationHandler);
             }
             // Create materials
             model->createMissingMaterials(
@@ -192,7 +197,7 @@ public:
             modelDesc->setTransformation(transformation);
 
             // unset the simulation handler once the model is removed
-            if (compartmentReport)
+            if (simulationHandler)
                 modelDesc->onRemoved([& scene = _parent._scene](const auto&) {
                     scene.setSimulationHandler(nullptr);
                 });
@@ -323,6 +328,127 @@ private:
         }
     }
 
+    /**
+     * @return the given GIDs of the cells whose morphology intersects the
+     * circuit bounding box, using the spatial index of the circuit
+     */
+    brain::GIDSet _getGIDsInBoundingBox(const brain::Circuit& circuit,
+                                        const std::string& source,
+                                        const brain::GIDSet& gids)
+    {
+        if (_spatialIndexSource != source)
+        {
+            _spatialIndex = CircuitSpatialIndex();
+            _spatialIndexSource = source;
+            _spatialIndexFile = CircuitSpatialIndex::getCacheFilename(
+                _applicationParameters.getTmpFolder(), source);
+            if (_spatialIndex.load(_spatialIndexFile, source))
+                BRAYNS_INFO << "Loaded spatial index of "
+                            << _spatialIndex.getNumCells() << " cells from "
+                            << _spatialIndexFile << std::endl;
+        }
+
+        const auto missingGids =
+            _spatialIndex.getMissingGIDs({gids.begin(), gids.end()});
+        if (!missingGids.empty())
+        {
+            _spatialIndex.addCells(_getSpatialIndexCells(circuit, missingGids));
+            try
+            {
+                _spatialIndex.save(_spatialIndexFile, source);
+            }
+            catch (const std::exception& error)
+            {
+                BRAYNS_WARN << error.what() << std::endl;
+            }
+        }
+
+        const auto& aabb = _geometryParameters.getCircuitBoundingBox();
+        const auto gidsInBox = _spatialIndex.intersect(
+            {Vector3f(aabb.getMin()), Vector3f(aabb.getMax())});
+        brain::GIDSet result;
+        std::set_intersection(gids.begin(), gids.end(), gidsInBox.begin(),
+                              gidsInBox.end(),
+                              std::inserter(result, result.end()));
+        return result;
+    }
+
+    /**
+     * @return the soma position and the morphology bounds of the given cells
+     */
+    std::vector<CircuitSpatialIndex::Cell> _getSpatialIndexCells(
+        const brain::Circuit& circuit, const uint32_ts& gids) const
+    {
+        const brain::GIDSet gidSet(gids.begin(), gids.end());
+        const auto transforms = circuit.getTransforms(gidSet);
+        const auto uris = circuit.getMorphologyURIs(gidSet);
+
+        // Many cells share a morphology, each one is read once. The bounds of
+        // a cell enclose the transformed bounds of its morphology, so that no
+        // cell reaching the box is missed.
+        std::map<std::string, Boxf> morphologyBounds;
+        for (const auto& uri : uris)
+            morphologyBounds.emplace(uri.getPath(), Boxf());
+
+        std::stringstream message;
+        message << "Indexing " << gids.size() << " cells with "
+                << morphologyBounds.size() << " morphologies...";
+        ProgressAggregator progress(_parent.getProgressCallback(),
+                                    message.str(), morphologyBounds.size());
+        for (auto& i : morphologyBounds)
+        {
+            const brain::neuron::Morphology morphology(servus::URI(i.first));
+            for (const auto& point : morphology.getPoints())
+            {
+                const Vector3f position(point.x(), point.y(), point.z());
+                const float radius = point.w() * 0.5f;
+                i.second.merge(position - radius);
+                i.second.merge(position + radius);
+            }
+            progress.increment();
+        }
+        progress.finish();
+
+        std::vector<CircuitSpatialIndex::Cell> cells(gids.size());
+        for (size_t i = 0; i < gids.size(); ++i)
+        {
+            auto& cell = cells[i];
+            cell.gid = gids[i];
+            cell.soma = transforms[i].getTranslation();
+            cell.bounds.merge(cell.soma);
+
+            const auto& bounds = morphologyBounds[uris[i].getPath()];
+            if (bounds.isEmpty())
+                continue;
+            for (size_t corner = 0; corner < 8; ++corner)
+            {
+                const Vector3f point(
+                    corner & 1 ? bounds.getMax().x() : bounds.getMin().x(),
+                    corner & 2 ? bounds.getMax().y() : bounds.getMin().y(),
+                    corner & 4 ? bounds.getMax().z() : bounds.getMin().z());
+                cell.bounds.merge(transformPoint(point, transforms[i],
+                                                 Vector3f(0.f, 0.f, 0.f)));
+            }
+        }
+        return cells;
+    }
+
+    /**
+     * @return a random subset of the given GIDs, of the given fraction
+     */
+    brain::GIDSet _getRandomGIDs(const brain::GIDSet& gids,
+                                 const float fraction) const
+    {
+        if (fraction >= 1.f)
+            return gids;
+
+        uint32_ts shuffled(gids.begin(), gids.end());
+        std::mt19937 engine(_geometryParameters.getCircuitRandomSeed());
+        std::shuffle(shuffled.begin(), shuffled.end(), engine);
+        shuffled.resize(size_t(fraction * shuffled.size()));
+        return {shuffled.begin(), shuffled.end()};
+    }
+
     /**
      * @brief _logLoadedGIDs Logs selected GIDs for debugging purpose
      * @param gids to trace
@@ -351,6 +477,8 @@ private:
         // Loading meshes is currently sequential. TODO: Make it parallel!!!
         std::stringstream message;
         message << "Loading " << gids.size() << " meshes...";
+        ProgressAggregator progress(_parent.getProgressCallback(),
+                                    message.str(), gids.size());
         for (const auto& gid : gids)
         {
             const size_t materialId = _getMaterialFromGeometryParameters(
@@ -373,8 +501,9 @@ private:
                 ++loadingFailures;
             }
             ++meshIndex;
-            _parent.updateProgress(message.str(), meshIndex, gids.size());
+            progress.increment();
         }
+        progress.finish();
         if (loadingFailures != 0)
             BRAYNS_WARN << "Failed to import " << loadingFailures << " meshes"
                         << std::endl;
@@ -390,18 +519,44 @@ private:
     }
 #endif
 
+    /**
+     * Sizes the cell mask of the model for the loaded cells, which are
+     * selected by GID. The mask can hide cells according to their simulation
+     * value, taken at the first compartment of each cell, or at its reduced
+     * value with --circuit-simulation-reduction.
+     */
+    void _initializeCellMask(
+        Model& model, const brain::GIDSet& gids,
+        CircuitSimulationHandlerPtr simulationHandler) const
+    {
+        auto& cellMask = model.getCellMask();
+        cellMask.resize(gids.size());
+        cellMask.setCellIds({gids.begin(), gids.end()});
+
+        if (!simulationHandler)
+            return;
+
+        const auto& offsets = simulationHandler->getOffsets();
+        uint64_ts cellOffsets;
+        cellOffsets.reserve(offsets.size());
+        for (const auto& cellOffset : offsets)
+            cellOffsets.push_back(cellOffset.empty() ? 0 : cellOffset[0]);
+        cellMask.setSimulationOffsets(std::move(cellOffsets));
+    }
+
     bool _importMorphologies(const brain::Circuit& circuit, Model& model,
                              const brain::GIDSet& gids,
                              const Matrix4fs& transformations,
                              const GIDOffsets& targetGIDOffsets,
-                             CompartmentReportPtr compartmentReport,
+                             CircuitSimulationHandlerPtr simulationHandler,
                              MorphologyLoader& morphLoader)
     {
         const brain::URIs& uris = circuit.getMorphologyURIs(gids);
         size_t loadingFailures = 0;
         std::stringstream message;
         message << "Loading " << uris.size() << " morphologies...";
-        std::atomic_size_t current{0};
+        ProgressAggregator progress(_parent.getProgressCallback(),
+                                    message.str(), uris.size());
         std::exception_ptr cancelException;
 #pragma omp parallel
         {
@@ -409,13 +564,10 @@ private:
             for (uint64_t morphologyIndex = 0; morphologyIndex < uris.size();
                  ++morphologyIndex)
             {
-                ++current;
-
                 try
                 {
-                    _parent.updateProgress(message.str(), current, uris.size());
-
                     ParallelModelContainer modelContainer;
+                    modelContainer.useCellTags = true;
                     const auto& uri = uris[morphologyIndex];
 
                     if (!morphLoader._importMorphology(
@@ -424,7 +576,7 @@ private:
                                       this, morphologyIndex, NO_MATERIAL,
                                       std::placeholders::_1, targetGIDOffsets,
                                       false),
-                            transformations[morphologyIndex], compartmentReport,
+                            transformations[morphologyIndex], simulationHandler,
                             modelContainer))
 #pragma omp atomic
                         ++loadingFailures;
@@ -436,6 +588,7 @@ private:
                     modelContainer.addConesToModel(model);
 #pragma omp critical
                     modelContainer.addSDFGeometriesToModel(model);
+                    progress.increment();
                 }
                 catch (...)
                 {
@@ -447,6 +600,7 @@ private:
 
         if (cancelException)
             std::rethrow_exception(cancelException);
+        progress.finish();
 
         if (loadingFailures != 0)
         {
@@ -465,6 +619,10 @@ private:
     size_ts _electrophysiologyTypes;
     size_ts _morphologyTypes;
     size_t _materialsOffset;
+
+    CircuitSpatialIndex _spatialIndex;
+    std::string _spatialIndexSource;
+    std::string _spatialIndexFile;
 };
 
 CircuitLoader::CircuitLoader(Scene& scene,
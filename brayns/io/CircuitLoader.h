@@ -53,6 +53,8 @@ public:
                                       const size_t index,
                                       const size_t materialID) final;
 
+    bool canImportFromBlob() const final { return false; }
+
     /**
      * @brief Imports morphology from a circuit for the given target name
      * @param circuitConfig URI of the Circuit Config file
@@ -0,0 +1,272 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "CircuitSpatialIndex.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+
+namespace brayns
+{
+namespace
+{
+const char MAGIC[] = "BRAYNSCI";
+const uint32_t VERSION = 1;
+
+// Maximum number of cells in a leaf of the hierarchy
+const uint32_t LEAF_SIZE = 8;
+
+bool overlaps(const Boxf& a, const Boxf& b)
+{
+    for (size_t i = 0; i < 3; ++i)
+        if (a.getMin()[i] > b.getMax()[i] || a.getMax()[i] < b.getMin()[i])
+            return false;
+    return true;
+}
+
+/** Modification time of the circuit, to discard the index of older versions */
+int64_t getVersion(const std::string& circuit)
+{
+    boost::system::error_code error;
+    const auto time = boost::filesystem::last_write_time(circuit, error);
+    return error ? 0 : time;
+}
+
+template <typename T>
+void write(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void read(std::istream& stream, T& value)
+{
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+void write(std::ostream& stream, const Vector3f& value)
+{
+    stream.write(reinterpret_cast<const char*>(value.array), sizeof(float) * 3);
+}
+
+void read(std::istream& stream, Vector3f& value)
+{
+    stream.read(reinterpret_cast<char*>(value.array), sizeof(float) * 3);
+}
+}
+
+std::string CircuitSpatialIndex::getCacheFilename(const std::string& folder,
+                                                  const std::string& circuit)
+{
+    boost::system::error_code error;
+    const auto path = boost::filesystem::canonical(circuit, error);
+    const auto key = std::hash<std::string>()(error ? circuit : path.string());
+
+    std::stringstream filename;
+    filename << "brayns_circuit_index_" << std::hex << key << ".bin";
+    return (boost::filesystem::path(folder) / filename.str()).string();
+}
+
+void CircuitSpatialIndex::addCells(const std::vector<Cell>& cells)
+{
+    uint32_ts gids;
+    gids.reserve(cells.size());
+    for (const auto& cell : cells)
+        gids.push_back(cell.gid);
+    std::sort(gids.begin(), gids.end());
+
+    _cells.erase(std::remove_if(_cells.begin(), _cells.end(),
+                                [&gids](const Cell& cell) {
+                                    return std::binary_search(gids.begin(),
+                                                              gids.end(),
+                                                              cell.gid);
+                                }),
+                 _cells.end());
+    _cells.insert(_cells.end(), cells.begin(), cells.end());
+    _build();
+}
+
+uint32_ts CircuitSpatialIndex::getMissingGIDs(const uint32_ts& gids) const
+{
+    uint32_ts missing;
+    std::set_difference(gids.begin(), gids.end(), _gids.begin(), _gids.end(),
+                        std::back_inserter(missing));
+    return missing;
+}
+
+uint32_ts CircuitSpatialIndex::intersect(const Boxf& box) const
+{
+    uint32_ts gids;
+    if (_nodes.empty())
+        return gids;
+
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty())
+    {
+        const auto& node = _nodes[stack.back()];
+        const uint32_t index = stack.back();
+        stack.pop_back();
+        if (!overlaps(node.bounds, box))
+            continue;
+
+        if (node.secondChild == 0)
+        {
+            for (uint32_t i = node.begin; i < node.end; ++i)
+                if (overlaps(_cells[i].bounds, box))
+                    gids.push_back(_cells[i].gid);
+            continue;
+        }
+        stack.push_back(node.secondChild);
+        stack.push_back(index + 1);
+    }
+    std::sort(gids.begin(), gids.end());
+    return gids;
+}
+
+bool CircuitSpatialIndex::load(const std::string& filename,
+                               const std::string& circuit)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.good())
+        return false;
+
+    char magic[sizeof(MAGIC) - 1];
+    file.read(magic, sizeof(magic));
+    uint32_t version = 0;
+    read(file, version);
+    uint64_t length = 0;
+    read(file, length);
+    if (!file.good() || !std::equal(magic, magic + sizeof(magic), MAGIC) ||
+        version != VERSION || length != circuit.size())
+    {
+        return false;
+    }
+
+    std::string path(length, ' ');
+    file.read(&path[0], length);
+    int64_t circuitVersion = 0;
+    read(file, circuitVersion);
+    uint64_t numCells = 0;
+    read(file, numCells);
+    if (!file.good() || path != circuit ||
+        circuitVersion != getVersion(circuit))
+    {
+        return false;
+    }
+
+    std::vector<Cell> cells(numCells);
+    for (auto& cell : cells)
+    {
+        Vector3f min, max;
+        read(file, cell.gid);
+        read(file, cell.soma);
+        read(file, min);
+        read(file, max);
+        cell.bounds = Boxf(min, max);
+    }
+    if (!file.good())
+        return false;
+
+    _cells = std::move(cells);
+    _build();
+    return true;
+}
+
+void CircuitSpatialIndex::save(const std::string& filename,
+                               const std::string& circuit) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    file.write(MAGIC, sizeof(MAGIC) - 1);
+    write(file, VERSION);
+    write(file, uint64_t(circuit.size()));
+    file.write(circuit.data(), circuit.size());
+    write(file, getVersion(circuit));
+    write(file, uint64_t(_cells.size()));
+    for (const auto& cell : _cells)
+    {
+        write(file, cell.gid);
+        write(file, cell.soma);
+        write(file, cell.bounds.getMin());
+        write(file, cell.bounds.getMax());
+    }
+    if (!file.good())
+        throw std::runtime_error("Could not write " + filename);
+}
+
+void CircuitSpatialIndex::_build()
+{
+    _nodes.clear();
+    if (!_cells.empty())
+        _buildNode(0, _cells.size());
+
+    _gids.clear();
+    _gids.reserve(_cells.size());
+    for (const auto& cell : _cells)
+        _gids.push_back(cell.gid);
+    std::sort(_gids.begin(), _gids.end());
+}
+
+uint32_t CircuitSpatialIndex::_buildNode(const uint32_t begin,
+                                         const uint32_t end)
+{
+    const uint32_t index = _nodes.size();
+    _nodes.emplace_back();
+
+    Boxf bounds;
+    Boxf centers;
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        bounds.merge(_cells[i].bounds);
+        centers.merge(_cells[i].bounds.getCenter());
+    }
+
+    uint32_t secondChild = 0;
+    if (end - begin > LEAF_SIZE)
+    {
+        // median split along the largest extent of the cell centers, the
+        // first child follows its parent
+        const auto size = centers.getSize();
+        const size_t axis = size.x() > size.y()
+                                ? (size.x() > size.z() ? 0 : 2)
+                                : (size.y() > size.z() ? 1 : 2);
+        const uint32_t middle = begin + (end - begin) / 2;
+        std::nth_element(_cells.begin() + begin, _cells.begin() + middle,
+                         _cells.begin() + end,
+                         [axis](const Cell& a, const Cell& b) {
+                             return a.bounds.getCenter()[axis] <
+                                    b.bounds.getCenter()[axis];
+                         });
+        _buildNode(begin, middle);
+        secondChild = _buildNode(middle, end);
+    }
+
+    auto& node = _nodes[index];
+    node.bounds = bounds;
+    node.begin = begin;
+    node.end = end;
+    node.secondChild = secondChild;
+    return index;
+}
+}
@@ -0,0 +1,100 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * Spatial index of the cells of a circuit, made of the soma position and of
+ * the bounding box of the morphology of each cell. The cells are stored in a
+ * bounding volume hierarchy so that the cells intersecting a region are found
+ * without testing all the cells of the circuit.
+ *
+ * Computing the bounding boxes needs the morphologies, so the index can be
+ * completed incrementally with the cells of each loaded target, and cached on
+ * disk between runs.
+ */
+class CircuitSpatialIndex
+{
+public:
+    struct Cell
+    {
+        uint32_t gid{0};
+        Vector3f soma;
+        /** Box enclosing the morphology, including the soma */
+        Boxf bounds;
+    };
+
+    /**
+     * @return the file caching the index of the given circuit, in the given
+     *         folder
+     */
+    static std::string getCacheFilename(const std::string& folder,
+                                        const std::string& circuit);
+
+    /**
+     * Adds the given cells, replacing the indexed cells of the same GIDs, and
+     * rebuilds the hierarchy.
+     */
+    void addCells(const std::vector<Cell>& cells);
+
+    /** @return the given sorted GIDs that are not indexed yet, sorted */
+    uint32_ts getMissingGIDs(const uint32_ts& gids) const;
+
+    /** @return the sorted GIDs of the cells whose bounds intersect the box */
+    uint32_ts intersect(const Boxf& box) const;
+
+    size_t getNumCells() const { return _cells.size(); }
+    /**
+     * Loads the index saved for the given circuit.
+     * @return false if the file does not exist or was saved for another
+     *         circuit or an older version of it
+     */
+    bool load(const std::string& filename, const std::string& circuit);
+
+    /**
+     * Saves the index of the given circuit.
+     * @throw std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& filename, const std::string& circuit) const;
+
+private:
+    struct Node
+    {
+        Boxf bounds;
+        /** Range of the cells of a leaf, or of the cells of the children */
+        uint32_t begin{0};
+        uint32_t end{0};
+        /** Index of the second child, 0 for a leaf */
+        uint32_t secondChild{0};
+    };
+
+    void _build();
+    uint32_t _buildNode(uint32_t begin, uint32_t end);
+
+    std::vector<Cell> _cells;
+    std::vector<Node> _nodes;
+    /** GIDs of _cells, sorted */
+    uint32_ts _gids;
+};
+}
@@ -113,6 +113,7 @@ ModelDescriptorPtr MeshLoader::importFromBlob(Blob&& blob, const size_t index,
     Assimp::Importer importer;
     importer.SetProgressHandler(new ProgressWatcher(*this, blob.name));
 
+    startPhase("Parse");
     const aiScene* aiScene =
         importer.ReadFileFromMemory(blob.data.data(), blob.data.size(),
                                     _getQuality(), blob.type.c_str());
@@ -123,6 +124,7 @@ ModelDescriptorPtr MeshLoader::importFromBlob(Blob&& blob, const size_t index,
     if (!aiScene->HasMeshes())
         throw std::runtime_error("No meshes found");
 
+    startPhase("Build geometry");
     auto model = _scene.createModel();
     _postLoad(aiScene, *model, index, {}, defaultMaterialId);
 
@@ -141,6 +143,10 @@ void MeshLoader::_createMaterials(Model& model, const aiScene* aiScene,
     BRAYNS_DEBUG << "Loading " << aiScene->mNumMaterials << " materials"
                  << std::endl;
 
+    // textures are decoded all at once after the materials are created
+    std::vector<std::pair<MaterialPtr, TextureType>> textureSlots;
+    strings textureFiles;
+
     for (size_t m = 0; m < aiScene->mNumMaterials; ++m)
     {
         aiMaterial* aimaterial = aiScene->mMaterials[m];
@@ -180,8 +186,9 @@ void MeshLoader::_createMaterials(Model& model, const aiScene* aiScene,
                     const std::string fileName = folder + "/" + path.data;
                     BRAYNS_DEBUG << "Loading texture: " << fileName
                                  << std::endl;
-                    material->setTexture(fileName,
-                                         textureTypeMapping[textureType].type);
+                    textureSlots.emplace_back(
+                        material, textureTypeMapping[textureType].type);
+                    textureFiles.push_back(fileName);
                 }
             }
         }
@@ -222,6 +229,16 @@ void MeshLoader::_createMaterials(Model& model, const aiScene* aiScene,
             if (value1f != 0.f)
                 material->setRefractionIndex(value1f);
     }
+
+    const auto textures = _scene.getTextureCache().get(textureFiles);
+    for (size_t i = 0; i < textures.size(); ++i)
+    {
+        if (!textures[i])
+            throw std::runtime_error("Failed to load texture from " +
+                                     textureFiles[i]);
+        textureSlots[i].first->setTexture(textures[i],
+                                          textureSlots[i].second);
+    }
 }
 
 void MeshLoader::_postLoad(const aiScene* aiScene, Model& model,
@@ -367,6 +384,7 @@ void MeshLoader::importMesh(const std::string& fileName, Model& model,
         throw std::runtime_error("Could not open file " + fileName);
     meshFile.close();
 
+    startPhase("Parse");
     const aiScene* aiScene = importer.ReadFile(fileName.c_str(), _getQuality());
 
     if (!aiScene)
@@ -380,6 +398,7 @@ void MeshLoader::importMesh(const std::string& fileName, Model& model,
     if (!aiScene->HasMeshes())
         throw std::runtime_error("Error finding meshes in scene");
 
+    startPhase("Build geometry");
     boost::filesystem::path filepath = fileName;
 
     _postLoad(aiScene, model, index, transformation, defaultMaterialId,
@@ -63,6 +63,8 @@ public:
         throw std::runtime_error("Unsupported");
     }
 
+    bool canImportFromBlob() const final { return false; }
+
 private:
     bool _createScene();
     bool _loadConfiguration(const std::string& fileName);
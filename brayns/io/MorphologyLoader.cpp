@@ -20,6 +20,7 @@
 
 #include "MorphologyLoader.h"
 #include "circuitLoaderCommon.h"
+#include "sampleBatch.h"
 
 #include <brayns/common/material/Material.h>
 #include <brayns/common/scene/Model.h>
@@ -28,6 +29,7 @@
 #include <brayns/common/utils/Utils.h>
 
 #include <brayns/io/algorithms/MetaballsGenerator.h>
+#include <brayns/io/simulation/CircuitSimulationHandler.h>
 
 #include <brain/brain.h>
 #include <brion/brion.h>
@@ -53,6 +55,24 @@ typename std::enable_if<!std::numeric_limits<T>::is_integer, bool>::type
            // unless the result is subnormal
            || std::abs(x - y) < std::numeric_limits<T>::min();
 }
+
+brayns::MorphologySectionType toMorphologySectionType(
+    const brain::neuron::SectionType sectionType)
+{
+    switch (sectionType)
+    {
+    case brain::neuron::SectionType::soma:
+        return brayns::MorphologySectionType::soma;
+    case brain::neuron::SectionType::axon:
+        return brayns::MorphologySectionType::axon;
+    case brain::neuron::SectionType::dendrite:
+        return brayns::MorphologySectionType::dendrite;
+    case brain::neuron::SectionType::apicalDendrite:
+        return brayns::MorphologySectionType::apical_dendrite;
+    default:
+        return brayns::MorphologySectionType::all;
+    }
+}
 }
 
 namespace brayns
@@ -60,25 +80,33 @@ namespace brayns
 class MorphologyLoader::Impl
 {
 public:
-    Impl(const GeometryParameters& geometryParameters)
+    Impl(const GeometryParameters& geometryParameters,
+         const Loader::PhaseCallback& startPhase)
         : _geometryParameters(geometryParameters)
+        , _startPhase(startPhase)
     {
     }
 
+    void setClippingBox(const Boxf& box)
+    {
+        _clippingBox = box;
+        _clip = true;
+    }
+
     /**
      * @brief importMorphology imports a single morphology from a specified URI
      * @param uri URI of the morphology
      * @param index Index of the morphology
      * @param defaultMaterialId Material to use
      * @param transformation Transformation to apply to the morphology
-     * @param compartmentReport Compartment report to map to the morphology
+     * @param simulationHandler Maps the morphology to the simulation values
      * @return Position of the soma
      */
-    Vector3f importMorphology(const servus::URI& source, Model& model,
-                              const uint64_t index,
-                              const Matrix4f& transformation,
-                              const size_t defaultMaterialId = NO_MATERIAL,
-                              CompartmentReportPtr compartmentReport = nullptr)
+    Vector3f importMorphology(
+        const servus::URI& source, Model& model, const uint64_t index,
+        const Matrix4f& transformation,
+        const size_t defaultMaterialId = NO_MATERIAL,
+        CircuitSimulationHandlerPtr simulationHandler = nullptr)
     {
         Vector3f somaPosition;
         auto materialFunc = [
@@ -124,7 +152,7 @@ public:
         ParallelModelContainer modelContainer;
         somaPosition =
             importMorphology(source, index, materialFunc, transformation,
-                             compartmentReport, modelContainer);
+                             simulationHandler, modelContainer);
 
         modelContainer.addSpheresToModel(model);
         modelContainer.addCylindersToModel(model);
@@ -138,7 +166,7 @@ public:
     Vector3f importMorphology(const servus::URI& source, const uint64_t index,
                               MaterialFunc materialFunc,
                               const Matrix4f& transformation,
-                              CompartmentReportPtr compartmentReport,
+                              CircuitSimulationHandlerPtr simulationHandler,
                               ParallelModelContainer& model)
     {
         const size_t morphologySectionTypes =
@@ -148,14 +176,14 @@ public:
             static_cast<size_t>(MorphologySectionType::soma))
             somaPosition =
                 _importMorphologyAsPoint(index, materialFunc, transformation,
-                                         compartmentReport, model);
+                                         simulationHandler, model);
         else if (_geometryParameters.useRealisticSomas())
             somaPosition = _createRealisticSoma(source, materialFunc,
                                                 transformation, model);
         else
             somaPosition = _importMorphologyFromURI(source, index, materialFunc,
                                                     transformation,
-                                                    compartmentReport, model);
+                                                    simulationHandler, model);
         return somaPosition;
     }
 
@@ -225,24 +253,25 @@ private:
      * @param transformation Transformation to apply to the morphology
      * @param material Material that is forced in case geometry parameters do
      * not apply
-     * @param compartmentReport Compartment report to map to the morphology
+     * @param simulationHandler Maps the morphology to the simulation values
      * @param scene Scene to which the morphology should be loaded into
      * @return Position of the soma
      */
-    Vector3f _importMorphologyAsPoint(const uint64_t index,
-                                      MaterialFunc materialFunc,
-                                      const Matrix4f& transformation,
-                                      CompartmentReportPtr compartmentReport,
-                                      ParallelModelContainer& model)
+    Vector3f _importMorphologyAsPoint(
+        const uint64_t index, MaterialFunc materialFunc,
+        const Matrix4f& transformation,
+        CircuitSimulationHandlerPtr simulationHandler,
+        ParallelModelContainer& model)
     {
         uint64_t offset = 0;
-        if (compartmentReport)
-            offset = compartmentReport->getOffsets()[index][0];
+        if (simulationHandler)
+            offset = simulationHandler->getOffsets()[index][0];
 
         const auto radius = _geometryParameters.getRadiusMultiplier();
         const auto textureCoordinates = _getIndexAsTextureCoordinates(offset);
         const auto somaPosition = transformation.getTranslation();
         const auto materialId = materialFunc(brain::neuron::SectionType::soma);
+        model.setCellTag(index, MorphologySectionType::soma);
         model.addSphere(materialId,
                         {somaPosition, radius, 0.f, textureCoordinates});
         return somaPosition;
@@ -332,6 +361,16 @@ private:
         std::vector<size_t> bifurcationIndices;
         std::unordered_map<size_t, int> geometrySection;
         std::unordered_map<int, std::vector<size_t>> sectionGeometries;
+        std::vector<uint32_t> cellTags;
+        uint32_t cellTag{CELL_TAG_NONE};
+    };
+
+    /** Primitives of one section, added to the model container at once */
+    struct SectionGeometry
+    {
+        Spheres spheres;
+        Cylinders cylinders;
+        Cones cones;
     };
 
     struct MorphologyTreeStructure
@@ -352,6 +391,7 @@ private:
         sdfMorphologyData.materials.push_back(materialId);
         sdfMorphologyData.geometrySection[idx] = section;
         sdfMorphologyData.sectionGeometries[section].push_back(idx);
+        sdfMorphologyData.cellTags.push_back(sdfMorphologyData.cellTag);
         return idx;
     }
 
@@ -364,6 +404,8 @@ private:
                                  const size_t materialId, const float distance,
                                  const Vector2f& textureCoordinates,
                                  const brain::neuron::Sections& somaChildren,
+                                 const Matrix4f& transformation,
+                                 const Vector3f& translation,
                                  SDFMorphologyData& sdfMorphologyData) const
     {
         std::set<size_t> child_indices;
@@ -371,12 +413,18 @@ private:
         for (const auto& child : somaChildren)
         {
             const auto& samples = child.getSamples();
-            const Vector3f sample{samples[0].x(), samples[0].y(),
-                                  samples[0].z()};
+            const Vector3f sample =
+                transformPoint({samples[0].x(), samples[0].y(), samples[0].z()},
+                               transformation, translation);
 
             // Create a sigmoid cone with half of soma radius to center of soma
             // to give it an organic look.
             const float radiusEnd = _getCorrectedRadius(samples[0].w() * 0.5f);
+
+            // Do not blend the soma with branches starting outside of the
+            // clipping box
+            if (!_isInClippingBox(sample, sample, radiusEnd, translation))
+                continue;
             const size_t geomIdx =
                 _addSDFGeometry(sdfMorphologyData,
                                 createSDFConePillSigmoid(somaPosition, sample,
@@ -453,14 +501,17 @@ private:
                 }
             };
 
-            // Connect all child sections
+            // Connect all child sections, the sections clipped by the
+            // clipping box have no geometry
             for (const size_t sectionChild : mts.sectionChildren[section])
             {
-                connectGeometriesToBifurcation(
-                    sdfMorphologyData.sectionGeometries.at(sectionChild));
+                const auto i =
+                    sdfMorphologyData.sectionGeometries.find(sectionChild);
+                if (i != sdfMorphologyData.sectionGeometries.end())
+                    connectGeometriesToBifurcation(i->second);
             }
 
-            // Connect with own section
+            // Connect with own section, which has at least the bifurcation
             connectGeometriesToBifurcation(
                 sdfMorphologyData.sectionGeometries.at(section));
         }
@@ -508,6 +559,7 @@ private:
                                [i](size_t elem) { return elem == i; }),
                 neighbours.end());
 
+            modelContainer.cellTag = sdfMorphologyData.cellTags[i];
             modelContainer.addSDFGeometry(sdfMorphologyData.materials[i],
                                           sdfMorphologyData.geometries[i],
                                           neighbours);
@@ -520,6 +572,7 @@ private:
      */
     MorphologyTreeStructure _calculateMorphologyTreeStructure(
         const brain::neuron::Sections& sections,
+        const std::vector<SampleBatch>& batches,
         const bool dampenThickness) const
     {
         const size_t numSections = sections.size();
@@ -557,33 +610,20 @@ private:
             if (section.getType() == brain::neuron::SectionType::soma)
                 continue;
 
-            const auto& samples = section.getSamples();
-            if (samples.empty())
+            const auto& samples = batches[sectionI];
+            if (samples.size() == 0)
                 continue;
 
             skipSection[sectionI] = false;
 
-            { // Branch beginning
-                const auto& sample = samples[0];
-
-                const auto radius = _getCorrectedRadius(sample.w() * 0.5f);
-
-                const Vector3f position(sample.x(), sample.y(), sample.z());
-
-                bifurcationPosition[sectionI].first = radius;
-                bifurcationPosition[sectionI].second = position;
-            }
-
-            { // Branch end
-                const auto& sample = samples.back();
-
-                const auto radius = _getCorrectedRadius(sample.w() * 0.5f);
+            // Branch beginning
+            bifurcationPosition[sectionI].first = samples.radius[0];
+            bifurcationPosition[sectionI].second = samples.position(0);
 
-                const Vector3f position(sample.x(), sample.y(), sample.z());
-
-                sectionEndPosition[sectionI].first = radius;
-                sectionEndPosition[sectionI].second = position;
-            }
+            // Branch end
+            const size_t last = samples.size() - 1;
+            sectionEndPosition[sectionI].first = samples.radius[last];
+            sectionEndPosition[sectionI].second = samples.position(last);
         }
 
         const auto overlaps = [](const std::pair<float, Vector3f>& p0,
@@ -663,6 +703,7 @@ private:
      * Adds a Soma geometry to the model
      */
     void _addSomaGeometry(const brain::neuron::Soma& soma,
+                          const Matrix4f& transformation,
                           const Vector3f& translation, uint64_t offset,
                           bool useSDFGeometries, MaterialFunc materialFunc,
                           ParallelModelContainer& model,
@@ -670,7 +711,8 @@ private:
     {
         const size_t materialId =
             materialFunc(brain::neuron::SectionType::soma);
-        const auto somaPosition = soma.getCentroid() + translation;
+        const auto somaPosition =
+            transformPoint(soma.getCentroid(), transformation, translation);
         const auto somaRadius = _getCorrectedRadius(soma.getMeanRadius());
         const auto textureCoordinates = _getIndexAsTextureCoordinates(offset);
         const auto& children = soma.getChildren();
@@ -679,6 +721,7 @@ private:
         {
             _connectSDFSomaChildren(somaPosition, somaRadius, materialId, 0.f,
                                     textureCoordinates, children,
+                                    transformation, translation,
                                     sdfMorphologyData);
         }
         else
@@ -695,8 +738,9 @@ private:
                 for (const auto& child : children)
                 {
                     const auto& samples = child.getSamples();
-                    const Vector3f sample{samples[0].x(), samples[0].y(),
-                                          samples[0].z()};
+                    const Vector3f sample = transformPoint(
+                        {samples[0].x(), samples[0].y(), samples[0].z()},
+                        transformation, translation);
                     const float sampleRadius =
                         _getCorrectedRadius(samples[0].w() * 0.5f);
 
@@ -715,7 +759,7 @@ private:
                                 const Vector3f& position, const float radius,
                                 const size_t materialId, const float distance,
                                 const Vector2f& textureCoordinates,
-                                ParallelModelContainer& model,
+                                SectionGeometry& geometry,
                                 const size_t section,
                                 SDFMorphologyData& sdfMorphologyData) const
     {
@@ -739,8 +783,8 @@ private:
         }
         else
         {
-            model.addSphere(materialId,
-                            {position, radius, distance, textureCoordinates});
+            geometry.spheres.push_back(
+                {position, radius, distance, textureCoordinates});
         }
     }
 
@@ -751,7 +795,7 @@ private:
         const bool useSDFGeometries, const Vector3f& position,
         const float radius, const Vector3f& target, const float previousRadius,
         const size_t materialId, const float distance,
-        const Vector2f& textureCoordinates, ParallelModelContainer& model,
+        const Vector2f& textureCoordinates, SectionGeometry& geometry,
         const size_t section, SDFMorphologyData& sdfMorphologyData) const
     {
         if (useSDFGeometries)
@@ -767,12 +811,12 @@ private:
         else
         {
             if (almost_equal(radius, previousRadius, 100000))
-                model.addCylinder(materialId, {position, target, radius,
-                                               distance, textureCoordinates});
+                geometry.cylinders.push_back(
+                    {position, target, radius, distance, textureCoordinates});
             else
-                model.addCone(materialId,
-                              {position, target, radius, previousRadius,
-                               distance, textureCoordinates});
+                geometry.cones.push_back({position, target, radius,
+                                          previousRadius, distance,
+                                          textureCoordinates});
         }
     }
 
@@ -784,17 +828,16 @@ private:
        * @param materialFunc A function mapping brain::neuron::SectionType to a
        * material id
        * @param transformation Transformation to apply to the morphology
-       * @param compartmentReport Compartment report to map to the morphology
+       * @param simulationHandler Maps the morphology to the simulation values
        * @param model Model container to whichh the morphology should be loaded
        * into
        * @return Position of the soma
        */
-    Vector3f _importMorphologyFromURI(const servus::URI& uri,
-                                      const uint64_t index,
-                                      MaterialFunc materialFunc,
-                                      const Matrix4f& transformation,
-                                      CompartmentReportPtr compartmentReport,
-                                      ParallelModelContainer& model) const
+    Vector3f _importMorphologyFromURI(
+        const servus::URI& uri, const uint64_t index, MaterialFunc materialFunc,
+        const Matrix4f& transformation,
+        CircuitSimulationHandlerPtr simulationHandler,
+        ParallelModelContainer& model) const
     {
         Vector3f somaPosition;
         Vector3f translation;
@@ -810,18 +853,29 @@ private:
 
         SDFMorphologyData sdfMorphologyData;
 
-        brain::neuron::Morphology morphology(uri, transformation);
+        // the samples are transformed in batches, see transformSamples()
+        _startPhase("Parse");
+        brain::neuron::Morphology morphology(uri);
+        _startPhase("Build geometry");
         brain::neuron::SectionTypes sectionTypes;
 
+        const float radiusMultiplier =
+            _geometryParameters.getRadiusMultiplier();
+        const float radiusCorrection =
+            _geometryParameters.getRadiusCorrection();
+
         const MorphologyLayout& layout =
             _geometryParameters.getMorphologyLayout();
 
         if (layout.nbColumns != 0)
         {
+            SampleBatch points;
+            transformSamples(morphology.getPoints(), transformation,
+                             Vector3f(0.f, 0.f, 0.f), radiusMultiplier,
+                             radiusCorrection, points);
             Boxf morphologyAABB;
-            const auto& points = morphology.getPoints();
-            for (const auto& point : points)
-                morphologyAABB.merge({point.x(), point.y(), point.z()});
+            for (size_t i = 0; i < points.size(); ++i)
+                morphologyAABB.merge(points.position(i));
 
             const Vector3f positionInGrid = {
                 -1.f * layout.horizontalSpacing *
@@ -836,29 +890,39 @@ private:
 
         uint64_t offset = 0;
 
-        if (compartmentReport)
-            offset = compartmentReport->getOffsets()[index][0];
+        if (simulationHandler)
+            offset = simulationHandler->getOffsets()[index][0];
+
+        const auto setCellTag = [&](const MorphologySectionType sectionType) {
+            model.setCellTag(index, sectionType);
+            sdfMorphologyData.cellTag = model.cellTag;
+        };
 
         // Soma
-        somaPosition = morphology.getSoma().getCentroid() + translation;
+        somaPosition = transformPoint(morphology.getSoma().getCentroid(),
+                                      transformation, translation);
+        setCellTag(MorphologySectionType::soma);
         if (!_geometryParameters.useRealisticSomas() &&
             morphologySectionTypes &
-                static_cast<size_t>(MorphologySectionType::soma))
+                static_cast<size_t>(MorphologySectionType::soma) &&
+            _isInClippingBox(somaPosition, somaPosition,
+                             morphology.getSoma().getMeanRadius(),
+                             translation))
         {
-            _addSomaGeometry(morphology.getSoma(), translation, offset,
-                             useSDFGeometries, materialFunc, model,
+            _addSomaGeometry(morphology.getSoma(), transformation, translation,
+                             offset, useSDFGeometries, materialFunc, model,
                              sdfMorphologyData);
         }
 
         // Only the first one or two axon sections are reported, so find the
         // last one and use its offset for all the other axon sections
         uint16_t lastAxon = 0;
-        if (compartmentReport &&
+        if (simulationHandler &&
             (morphologySectionTypes &
              static_cast<size_t>(MorphologySectionType::axon)))
         {
             const auto& counts =
-                compartmentReport->getCompartmentCounts()[index];
+                simulationHandler->getCompartmentCounts()[index];
             const auto& axon =
                 morphology.getSections(brain::neuron::SectionType::axon);
             for (const auto& section : axon)
@@ -874,9 +938,18 @@ private:
 
         float previousRadius = 0;
         const auto& sections = morphology.getSections(sectionTypes);
+        std::vector<SampleBatch> batches(sections.size());
+        for (size_t i = 0; i < sections.size(); ++i)
+            if (sections[i].getType() != brain::neuron::SectionType::soma)
+                transformSamples(sections[i].getSamples(), transformation,
+                                 translation, radiusMultiplier,
+                                 radiusCorrection, batches[i]);
+
         const auto morphologyTree =
-            _calculateMorphologyTreeStructure(sections, dampenThickness);
+            _calculateMorphologyTreeStructure(sections, batches,
+                                              dampenThickness);
         std::vector<float> sectionEndRadius(sections.size(), -1.0f);
+        SectionGeometry sectionGeometry;
 
         // Dendrites and axon
         for (const size_t sectionI : morphologyTree.sectionTraverseOrder)
@@ -887,13 +960,15 @@ private:
                 continue;
 
             const auto materialId = materialFunc(section.getType());
-            const auto& samples = section.getSamples();
-            if (samples.empty())
+            const auto& samples = batches[sectionI];
+            if (samples.size() == 0)
                 continue;
 
+            setCellTag(toMorphologySectionType(section.getType()));
+
             const size_t numSamples = samples.size();
 
-            auto previousSample = samples[0];
+            size_t previousSample = 0;
             size_t step = 1;
             switch (_geometryParameters.getGeometryQuality())
             {
@@ -912,10 +987,10 @@ private:
             const floats& distancesToSoma = section.getSampleDistancesToSoma();
 
             float segmentStep = 0.f;
-            if (compartmentReport)
+            if (simulationHandler)
             {
                 const auto& counts =
-                    compartmentReport->getCompartmentCounts()[index];
+                    simulationHandler->getCompartmentCounts()[index];
                 // Number of compartments usually differs from number of
                 // samples
                 segmentStep = counts[section.getID()] / float(numSamples);
@@ -945,12 +1020,12 @@ private:
 
                 const auto distance = distanceToSoma + distancesToSoma[i];
 
-                if (compartmentReport)
+                if (simulationHandler)
                 {
                     const auto& offsets =
-                        compartmentReport->getOffsets()[index];
+                        simulationHandler->getOffsets()[index];
                     const auto& counts =
-                        compartmentReport->getCompartmentCounts()[index];
+                        simulationHandler->getCompartmentCounts()[index];
 
                     // update the offset if we have enough compartments aka
                     // a full compartment report. Otherwise we keep the soma
@@ -977,22 +1052,16 @@ private:
                     }
                 }
 
-                const auto sample = samples[i];
-
-                Vector3f position(sample.x(), sample.y(), sample.z());
-                position += translation;
-                Vector3f target(previousSample.x(), previousSample.y(),
-                                previousSample.z());
-                target += translation;
+                const Vector3f position = samples.position(i);
+                const Vector3f target = samples.position(previousSample);
                 const auto textureCoordinates =
                     _getIndexAsTextureCoordinates(offset);
-                float radius = _getCorrectedRadius(samples[i].w() * 0.5f);
+                float radius = samples.radius[i];
                 constexpr float maxRadiusChange = 0.1f;
 
                 if (resetRadius)
                 {
-                    previousRadius =
-                        _getCorrectedRadius(samples[i - step].w() * 0.5f);
+                    previousRadius = samples.radius[i - step];
                     resetRadius = false;
                 }
 
@@ -1008,26 +1077,36 @@ private:
                         radius = previousRadius + radiusChange;
                 }
 
-                if (radius > 0.f)
+                if (radius > 0.f &&
+                    _isInClippingBox(position, target,
+                                     std::max(radius, previousRadius),
+                                     translation))
                 {
                     _addStepSphereGeometry(useSDFGeometries, done, position,
                                            radius, materialId, distance,
-                                           textureCoordinates, model, sectionI,
-                                           sdfMorphologyData);
+                                           textureCoordinates, sectionGeometry,
+                                           sectionI, sdfMorphologyData);
 
                     if (position != target && previousRadius > 0.f)
                     {
                         _addStepConeGeometry(useSDFGeometries, position, radius,
                                              target, previousRadius, materialId,
                                              distance, textureCoordinates,
-                                             model, sectionI,
+                                             sectionGeometry, sectionI,
                                              sdfMorphologyData);
                     }
                 }
-                previousSample = sample;
+                previousSample = i;
                 previousRadius = radius;
                 sectionEndRadius[sectionI] = radius;
             }
+
+            model.addSpheres(materialId, sectionGeometry.spheres);
+            model.addCylinders(materialId, sectionGeometry.cylinders);
+            model.addCones(materialId, sectionGeometry.cones);
+            sectionGeometry.spheres.clear();
+            sectionGeometry.cylinders.clear();
+            sectionGeometry.cones.clear();
         }
 
         if (useSDFGeometries)
@@ -1039,13 +1118,41 @@ private:
     }
 
 private:
+    /**
+     * @param translation translation of the morphology layout, the clipping
+     *        box is in circuit coordinates
+     * @return true if the segment is not clipped by the clipping box
+     */
+    bool _isInClippingBox(const Vector3f& start, const Vector3f& end,
+                          const float radius,
+                          const Vector3f& translation) const
+    {
+        if (!_clip)
+            return true;
+        const Vector3f min = _clippingBox.getMin() + translation;
+        const Vector3f max = _clippingBox.getMax() + translation;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            if (std::min(start[i], end[i]) - radius > max[i])
+                return false;
+            if (std::max(start[i], end[i]) + radius < min[i])
+                return false;
+        }
+        return true;
+    }
+
     const GeometryParameters& _geometryParameters;
+    Loader::PhaseCallback _startPhase;
+    Boxf _clippingBox;
+    bool _clip{false};
 };
 
 MorphologyLoader::MorphologyLoader(Scene& scene,
                                    const GeometryParameters& geometryParameters)
     : Loader(scene)
-    , _impl(new MorphologyLoader::Impl(geometryParameters))
+    , _impl(new MorphologyLoader::Impl(
+          geometryParameters,
+          [this](const std::string& name) { startPhase(name); }))
 {
 }
 
@@ -1093,10 +1200,16 @@ Vector3f MorphologyLoader::importMorphology(const servus::URI& uri,
 
 Vector3f MorphologyLoader::_importMorphology(
     const servus::URI& source, const uint64_t index, MaterialFunc materialFunc,
-    const Matrix4f& transformation, CompartmentReportPtr compartmentReport,
+    const Matrix4f& transformation,
+    CircuitSimulationHandlerPtr simulationHandler,
     ParallelModelContainer& model)
 {
     return _impl->importMorphology(source, index, materialFunc, transformation,
-                                   compartmentReport, model);
+                                   simulationHandler, model);
+}
+
+void MorphologyLoader::_setClippingBox(const Boxf& box)
+{
+    _impl->setClippingBox(box);
 }
 }
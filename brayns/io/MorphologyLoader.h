@@ -58,6 +58,8 @@ public:
                                       const size_t index,
                                       const size_t materialID) final;
 
+    bool canImportFromBlob() const final { return false; }
+
     /**
      * @brief Imports morphology from a given SWC or H5 file
      * @param source URI of the morphology
@@ -71,13 +73,16 @@ public:
                               const Matrix4f& transformation);
 
 private:
-    using CompartmentReportPtr = std::shared_ptr<brion::CompartmentReport>;
     using MaterialFunc = std::function<size_t(brain::neuron::SectionType)>;
     Vector3f _importMorphology(const servus::URI& source, const uint64_t index,
                                MaterialFunc materialFunc,
                                const Matrix4f& transformation,
-                               CompartmentReportPtr compartmentReport,
+                               CircuitSimulationHandlerPtr simulationHandler,
                                ParallelModelContainer& model);
+
+    /** Only loads the segments of the sections that intersect the box */
+    void _setClippingBox(const Boxf& box);
+
     friend class CircuitLoader;
     class Impl;
     std::unique_ptr<Impl> _impl;
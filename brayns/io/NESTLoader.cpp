@@ -20,6 +20,7 @@
 
 #include "NESTLoader.h"
 
+#include <brayns/common/loader/ProgressAggregator.h>
 #include <brayns/common/log.h>
 #include <brayns/common/scene/Model.h>
 #include <brayns/common/scene/Scene.h>
@@ -126,6 +127,8 @@ ModelDescriptorPtr NESTLoader::importFromFile(const std::string& filepath,
     _positions.reserve(_frameSize);
     const float radius = _geometryParameters.getRadiusMultiplier();
 
+    ProgressAggregator progress(getProgressCallback(), "Loading neurons...",
+                                _frameSize);
     for (uint64_t gid = 0; gid < _frameSize; ++gid)
     {
         // Create a unique index for the combination of R,G and B values. This
@@ -137,8 +140,9 @@ ModelDescriptorPtr NESTLoader::importFromFile(const std::string& filepath,
         _positions.push_back(center);
         model->addSphere(0,
                          {center, radius, 0.f, {materialMapping[index], 0.f}});
-        updateProgress("Loading neurons...", spheres[0].size(), _frameSize);
+        progress.increment();
     }
+    progress.finish();
 
     BRAYNS_INFO << "Finished loading " << _frameSize << " neurons" << std::endl;
 
@@ -225,6 +229,8 @@ bool NESTLoader::_loadBinarySpikes(const std::string& spikesFilename)
     _values.reserve(_nbElements);
     _gids.reserve(_nbElements);
     size_t i = 0;
+    ProgressAggregator progress(getProgressCallback(), "Loading spikes...",
+                                _nbElements);
     while (!file.eof())
     {
         file.read((char*)&value, sizeof(float));
@@ -232,8 +238,9 @@ bool NESTLoader::_loadBinarySpikes(const std::string& spikesFilename)
         file.read((char*)&gid, sizeof(uint32_t));
         _gids.push_back(gid);
         ++i;
-        updateProgress("Loading spikes...", i, _nbElements);
+        progress.increment();
     }
+    progress.finish();
 
     _spikesStart = _values[0];             // First spike timestamp after header
     _spikesEnd = _values[_nbElements - 1]; // Last spike timestamp
@@ -61,6 +61,8 @@ public:
         throw std::runtime_error("Unsupported");
     }
 
+    bool canImportFromBlob() const final { return false; }
+
     /**
      * Imports a circuit into a scene. Every neuron is represented as a sphere,
      * with a given
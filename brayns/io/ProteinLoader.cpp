@@ -330,6 +330,7 @@ ModelDescriptorPtr ProteinLoader::importFromFile(
     if (!file.is_open())
         throw std::runtime_error("Could not open " + fileName);
 
+    startPhase("Parse");
     size_t lineIndex{0};
     std::map<size_t, Spheres> spheres;
 
@@ -450,6 +451,7 @@ ModelDescriptorPtr ProteinLoader::importFromFile(
     }
     file.close();
 
+    startPhase("Build geometry");
     auto model = _scene.createModel();
 
     // Add materials and spheres
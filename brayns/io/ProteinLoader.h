@@ -48,6 +48,8 @@ public:
         throw std::runtime_error("Unsupported");
     }
 
+    bool canImportFromBlob() const final { return false; }
+
 private:
     const GeometryParameters& _geometryParameters;
 };
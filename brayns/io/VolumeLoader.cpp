@@ -128,6 +128,7 @@ ModelDescriptorPtr VolumeLoader::importFromFile(
     const size_t defaultMaterialId BRAYNS_UNUSED)
 {
     updateProgress("Parsing volume file ...", 0, 2);
+    startPhase("Parse");
 
     Vector3ui dimensions;
     Vector3f spacing;
@@ -171,9 +172,11 @@ ModelDescriptorPtr VolumeLoader::importFromFile(
     volume->setDataRange(dataRange);
 
     updateProgress("Loading voxels ...", 1, 2);
+    startPhase("Load voxels");
     volume->mapData(volumeFile);
 
     updateProgress("Creating model ...", 2, 2);
+    startPhase("Build geometry");
     auto model = _scene.createModel();
     model->addVolume(volume);
 
@@ -41,6 +41,8 @@ public:
         const std::string& filename, const size_t index = 0,
         const size_t defaultMaterialId = NO_MATERIAL) final;
 
+    bool canImportFromBlob() const final { return false; }
+
 private:
     VolumeParameters& _volumeParameters;
 };
@@ -20,6 +20,7 @@
 
 #include "XYZBLoader.h"
 
+#include <brayns/common/loader/ProgressAggregator.h>
 #include <brayns/common/log.h>
 #include <brayns/common/scene/Model.h>
 #include <brayns/common/scene/Scene.h>
@@ -31,8 +32,6 @@
 
 namespace brayns
 {
-constexpr float DEFAULT_POINT_SIZE = 0.0001f;
-
 XYZBLoader::XYZBLoader(Scene& scene)
     : Loader(scene)
 {
@@ -57,22 +56,16 @@ ModelDescriptorPtr XYZBLoader::importFromBlob(
     }
     stream.seekg(0);
 
-    auto model = _scene.createModel();
-
-    const auto name = boost::filesystem::basename({blob.name});
-    const auto materialId =
-        (defaultMaterialId == NO_MATERIAL ? 0 : defaultMaterialId);
-    model->createMaterial(materialId, name);
-    auto& spheres = model->getSpheres()[materialId];
-
-    const size_t startOffset = spheres.size();
-    spheres.reserve(spheres.size() + numlines);
+    startPhase("Parse");
+    std::vector<Vector3f> positions;
+    positions.reserve(numlines);
 
     Boxf bbox;
     size_t i = 0;
     std::string line;
     std::stringstream msg;
     msg << "Loading " << shortenString(blob.name) << " ..." << std::endl;
+    ProgressAggregator progress(getProgressCallback(), msg.str(), numlines);
     while (std::getline(stream, line))
     {
         std::vector<float> lineData;
@@ -88,15 +81,19 @@ ModelDescriptorPtr XYZBLoader::importFromBlob(
         {
             const Vector3f position(lineData[0], lineData[1], lineData[2]);
             bbox.merge(position);
-            model->addSphere(materialId, {position, DEFAULT_POINT_SIZE});
+            positions.push_back(position);
             break;
         }
         default:
             throw std::runtime_error("Invalid content in line " +
                                      std::to_string(i + 1) + ": " + line);
         }
-        updateProgress(msg.str(), i++, numlines);
+        ++i;
+        progress.increment();
     }
+    progress.finish();
+
+    startPhase("Build geometry");
 
     // Find an appropriate mean radius to avoid overlaps of the spheres, see
     // https://en.wikipedia.org/wiki/Wigner%E2%80%93Seitz_radius
@@ -104,9 +101,15 @@ ModelDescriptorPtr XYZBLoader::importFromBlob(
     const double meanRadius =
         std::pow((3. / (4. * M_PI * (numlines / volume))), 1. / 3.);
 
-    // resize the spheres to the new mean radius
-    for (i = 0; i < numlines; ++i)
-        spheres[i + startOffset].radius = meanRadius;
+    auto model = _scene.createModel();
+
+    const auto name = boost::filesystem::basename({blob.name});
+    const auto materialId =
+        (defaultMaterialId == NO_MATERIAL ? 0 : defaultMaterialId);
+    model->createMaterial(materialId, name);
+    model->getSpheres(materialId).reserve(positions.size());
+    for (const auto& position : positions)
+        model->addSphere(materialId, {position, float(meanRadius)});
 
     Transformation transformation;
     transformation.setRotationCenter(model->getBounds().getCenter());
@@ -122,7 +125,7 @@ ModelDescriptorPtr XYZBLoader::importFromBlob(
         if (auto modelDesc_ = modelDesc.lock())
         {
             const auto newRadius = property.template get<double>();
-            for (auto& sphere : modelDesc_->getModel().getSpheres()[materialId])
+            for (auto& sphere : modelDesc_->getModel().getSpheres(materialId))
                 sphere.radius = newRadius;
         }
     });
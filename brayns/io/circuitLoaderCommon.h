@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <brayns/common/geometry/CellTag.h>
 #include <brayns/common/geometry/Cone.h>
 #include <brayns/common/geometry/Cylinder.h>
 #include <brayns/common/geometry/SDFGeometry.h>
@@ -31,19 +32,49 @@ namespace brayns
 {
 struct ParallelModelContainer
 {
+    /**
+     * Sets the cell and section type of the geometry added next, so that it
+     * can be hidden with the cell mask of the model. Tags are only added to the
+     * model if useCellTags is set.
+     */
+    void setCellTag(const uint64_t cellIndex,
+                    const MorphologySectionType sectionType)
+    {
+        cellTag = makeCellTag(cellIndex, static_cast<uint32_t>(sectionType));
+    }
+
     void addSphere(const size_t materialId, const Sphere& sphere)
     {
         spheres[materialId].push_back(sphere);
+        sphereTags[materialId].push_back(cellTag);
     }
 
     void addCylinder(const size_t materialId, const Cylinder& cylinder)
     {
         cylinders[materialId].push_back(cylinder);
+        cylinderTags[materialId].push_back(cellTag);
     }
 
     void addCone(const size_t materialId, const Cone& cone)
     {
         cones[materialId].push_back(cone);
+        coneTags[materialId].push_back(cellTag);
+    }
+
+    /** Adds the primitives with the current cell tag, if there are any */
+    void addSpheres(const size_t materialId, const Spheres& newSpheres)
+    {
+        _append(spheres, sphereTags, materialId, newSpheres);
+    }
+
+    void addCylinders(const size_t materialId, const Cylinders& newCylinders)
+    {
+        _append(cylinders, cylinderTags, materialId, newCylinders);
+    }
+
+    void addCones(const size_t materialId, const Cones& newCones)
+    {
+        _append(cones, coneTags, materialId, newCones);
     }
 
     void addSDFGeometry(const size_t materialId, const SDFGeometry& geom,
@@ -52,6 +83,7 @@ struct ParallelModelContainer
         sdfMaterials.push_back(materialId);
         sdfGeometries.push_back(geom);
         sdfNeighbours.push_back(neighbours);
+        sdfTags.push_back(cellTag);
     }
 
     void addSpheresToModel(Model& model) const
@@ -59,9 +91,10 @@ struct ParallelModelContainer
         for (const auto& sphere : spheres)
         {
             const auto index = sphere.first;
-            model.getSpheres()[index].insert(model.getSpheres()[index].end(),
-                                             sphere.second.begin(),
-                                             sphere.second.end());
+            const auto first = model.addSpheres(index, sphere.second);
+            if (useCellTags)
+                _addTags(model.getCellTags().spheres[index], first,
+                         sphereTags.at(index));
         }
     }
 
@@ -70,9 +103,10 @@ struct ParallelModelContainer
         for (const auto& cylinder : cylinders)
         {
             const auto index = cylinder.first;
-            model.getCylinders()[index].insert(
-                model.getCylinders()[index].end(), cylinder.second.begin(),
-                cylinder.second.end());
+            const auto first = model.addCylinders(index, cylinder.second);
+            if (useCellTags)
+                _addTags(model.getCellTags().cylinders[index], first,
+                         cylinderTags.at(index));
         }
     }
 
@@ -81,9 +115,10 @@ struct ParallelModelContainer
         for (const auto& cone : cones)
         {
             const auto index = cone.first;
-            model.getCones()[index].insert(model.getCones()[index].end(),
-                                           cone.second.begin(),
-                                           cone.second.end());
+            const auto first = model.addCones(index, cone.second);
+            if (useCellTags)
+                _addTags(model.getCellTags().cones[index], first,
+                         coneTags.at(index));
         }
     }
 
@@ -98,6 +133,10 @@ struct ParallelModelContainer
             localToGlobalIndex[i] =
                 model.addSDFGeometry(sdfMaterials[i], sdfGeometries[i], {});
 
+        if (useCellTags && numGeoms > 0)
+            _addTags(model.getCellTags().sdfGeometries, localToGlobalIndex[0],
+                     sdfTags);
+
         // Write the neighbours using global indices
         std::vector<size_t> neighboursTmp;
         for (size_t i = 0; i < numGeoms; i++)
@@ -120,5 +159,35 @@ struct ParallelModelContainer
     std::vector<SDFGeometry> sdfGeometries;
     std::vector<std::vector<size_t>> sdfNeighbours;
     std::vector<size_t> sdfMaterials;
+
+    bool useCellTags{false};
+    uint32_t cellTag{CELL_TAG_NONE};
+    std::map<size_t, uint32_ts> sphereTags;
+    std::map<size_t, uint32_ts> cylinderTags;
+    std::map<size_t, uint32_ts> coneTags;
+    uint32_ts sdfTags;
+
+private:
+    template <typename PrimitivesMapT, typename PrimitivesT>
+    void _append(PrimitivesMapT& primitivesMap,
+                 std::map<size_t, uint32_ts>& tagsMap, const size_t materialId,
+                 const PrimitivesT& primitives)
+    {
+        if (primitives.empty())
+            return;
+        auto& materialPrimitives = primitivesMap[materialId];
+        materialPrimitives.insert(materialPrimitives.end(), primitives.begin(),
+                                  primitives.end());
+        auto& tags = tagsMap[materialId];
+        tags.resize(tags.size() + primitives.size(), cellTag);
+    }
+
+    // Primitives of the model that were added without tags are never masked
+    static void _addTags(uint32_ts& modelTags, const size_t nbPrimitives,
+                         const uint32_ts& tags)
+    {
+        modelTags.resize(nbPrimitives, CELL_TAG_NONE);
+        modelTags.insert(modelTags.end(), tags.begin(), tags.end());
+    }
 };
 }
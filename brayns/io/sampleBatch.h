@@ -0,0 +1,106 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * Positions and radii of the samples of a morphology section in structure of
+ * arrays layout, so that the transformation of a whole section is vectorized
+ * by the compiler.
+ */
+struct SampleBatch
+{
+    floats x;
+    floats y;
+    floats z;
+    floats radius;
+
+    size_t size() const { return radius.size(); }
+    Vector3f position(const size_t i) const { return {x[i], y[i], z[i]}; }
+};
+
+/**
+ * Fills batch with the samples (x, y, z, diameter) transformed by the affine
+ * transformation followed by the translation. The radii are half of the
+ * diameters multiplied by radiusMultiplier, or radiusCorrection for all samples
+ * if it is not 0.
+ */
+inline void transformSamples(const Vector4fs& samples,
+                             const Matrix4f& transformation,
+                             const Vector3f& translation,
+                             const float radiusMultiplier,
+                             const float radiusCorrection, SampleBatch& batch)
+{
+    const size_t size = samples.size();
+    batch.x.resize(size);
+    batch.y.resize(size);
+    batch.z.resize(size);
+    batch.radius.resize(size);
+    if (size == 0)
+        return;
+
+    const float m00 = transformation(0, 0), m01 = transformation(0, 1),
+                m02 = transformation(0, 2),
+                m03 = transformation(0, 3) + translation.x();
+    const float m10 = transformation(1, 0), m11 = transformation(1, 1),
+                m12 = transformation(1, 2),
+                m13 = transformation(1, 3) + translation.y();
+    const float m20 = transformation(2, 0), m21 = transformation(2, 1),
+                m22 = transformation(2, 2),
+                m23 = transformation(2, 3) + translation.z();
+    const float radiusScale = radiusCorrection != 0.f ? 0.f
+                                                      : 0.5f * radiusMultiplier;
+
+    const float* __restrict in = samples[0].array;
+    float* __restrict x = batch.x.data();
+    float* __restrict y = batch.y.data();
+    float* __restrict z = batch.z.data();
+    float* __restrict radius = batch.radius.data();
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i)
+    {
+        const float px = in[4 * i];
+        const float py = in[4 * i + 1];
+        const float pz = in[4 * i + 2];
+        x[i] = m00 * px + m01 * py + m02 * pz + m03;
+        y[i] = m10 * px + m11 * py + m12 * pz + m13;
+        z[i] = m20 * px + m21 * py + m22 * pz + m23;
+        radius[i] = in[4 * i + 3] * radiusScale + radiusCorrection;
+    }
+}
+
+/** @return the point transformed like the samples of transformSamples() */
+inline Vector3f transformPoint(const Vector3f& point,
+                               const Matrix4f& transformation,
+                               const Vector3f& translation)
+{
+    Vector3f result;
+    for (size_t i = 0; i < 3; ++i)
+        result[i] = transformation(i, 0) * point.x() +
+                    transformation(i, 1) * point.y() +
+                    transformation(i, 2) * point.z() + transformation(i, 3) +
+                    translation[i];
+    return result;
+}
+}
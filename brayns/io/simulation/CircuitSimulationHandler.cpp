@@ -21,11 +21,21 @@
 #include "CircuitSimulationHandler.h"
 
 #include <brayns/common/log.h>
+#include <brayns/common/simulation/CompactFrameReader.h>
+#include <brayns/common/simulation/FrameReader.h>
+#include <brayns/common/simulation/SimulationCacheWriter.h>
+#include <brayns/common/simulation/SimulationReducer.h>
 #include <brayns/parameters/ApplicationParameters.h>
 #include <brayns/parameters/GeometryParameters.h>
 
 #include <servus/types.h>
 
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
+
 namespace brayns
 {
 CircuitSimulationHandler::CircuitSimulationHandler(
@@ -65,15 +75,51 @@ CircuitSimulationHandler::CircuitSimulationHandler(
     BRAYNS_INFO << "Number of frames : " << _nbFrames << std::endl;
     BRAYNS_INFO << "-----------------------------------------------------------"
                 << std::endl;
+
+    const auto& cacheFile =
+        _geometryParameters.getCircuitSimulationCacheFile();
+    if (!cacheFile.empty())
+    {
+        try
+        {
+            _attachCache(reportSource, cacheFile);
+        }
+        catch (const std::exception& e)
+        {
+            BRAYNS_WARN << "Not using simulation cache " << cacheFile << ": "
+                        << e.what() << std::endl;
+        }
+    }
+
+    if (_geometryParameters.getCircuitSimulationReduction() !=
+        SimulationReduction::none)
+    {
+        _initializeReduction();
+    }
 }
 
 CircuitSimulationHandler::~CircuitSimulationHandler()
 {
+    _cancelReduction = true;
+    if (_reductionThread.joinable())
+        _reductionThread.join();
+}
+
+const brion::SectionOffsets& CircuitSimulationHandler::getOffsets() const
+{
+    return _reducer ? _reducedOffsets : _compartmentReport->getOffsets();
+}
+
+const brion::CompartmentCounts& CircuitSimulationHandler::getCompartmentCounts()
+    const
+{
+    return _reducer ? _reducedCounts
+                    : _compartmentReport->getCompartmentCounts();
 }
 
 bool CircuitSimulationHandler::isReady() const
 {
-    return _ready;
+    return _ready && !_keyFrameFuture.valid();
 }
 
 void* CircuitSimulationHandler::getFrameData(uint32_t frame)
@@ -83,43 +129,346 @@ void* CircuitSimulationHandler::getFrameData(uint32_t frame)
     if (!_currentFrameFuture.valid() && _currentFrame != frame)
         _triggerLoading(frame);
 
-    if (!_makeFrameReady(frame))
+    if (!_makeFrameReady())
         return nullptr;
 
+    // the loaded frame was requested before, load the requested one
+    if (!_currentFrameFuture.valid() && _currentFrame != frame)
+    {
+        _triggerLoading(frame);
+        if (!_makeFrameReady())
+            return nullptr;
+    }
+
     return _frameData.data();
 }
 
+bool CircuitSimulationHandler::_readFrame(const uint32_t frame,
+                                          floats& values)
+{
+    // The key frames are loaded in the background like the frames of
+    // getFrameData(), one load at a time as the readers are not shared. The
+    // scene keeps the last data until the missing key frames arrive.
+    if (_keyFrameFuture.valid())
+    {
+        if (!_isLoaded(_keyFrameFuture))
+            return false;
+        brion::floatsPtr data;
+        try
+        {
+            data = _keyFrameFuture.get();
+        }
+        catch (const std::exception& e)
+        {
+            BRAYNS_ERROR << "Error loading simulation frame " << _keyFrame
+                         << ": " << e.what() << std::endl;
+            return false;
+        }
+        if (_keyFrame == frame)
+        {
+            values = std::move(*data);
+            return true;
+        }
+    }
+
+    if (_currentFrameFuture.valid())
+    {
+        _makeFrameReady();
+        if (_currentFrameFuture.valid())
+            return false;
+    }
+
+    _keyFrame = frame;
+    _keyFrameFuture = _loadFrame(frame);
+    if (_applicationParameters.getSynchronousMode())
+        return _readFrame(frame, values);
+    return false;
+}
+
+void CircuitSimulationHandler::_attachCache(const brion::URI& reportSource,
+                                            const std::string& cacheFile)
+{
+    // the cache holds the frames of all the cells of the report, map the
+    // sections of the loaded cells to their values in the cache
+    const brion::CompartmentReport report(reportSource, brion::MODE_READ,
+                                          brion::GIDSet());
+    const auto& reportGids = report.getGIDs();
+    const auto& reportOffsets = report.getOffsets();
+    const auto& gids = _compartmentReport->getGIDs();
+    const auto& offsets = _compartmentReport->getOffsets();
+    const auto& counts = _compartmentReport->getCompartmentCounts();
+
+    FrameRanges ranges;
+    auto reportGid = reportGids.begin();
+    size_t reportIndex = 0;
+    size_t index = 0;
+    for (const auto gid : gids)
+    {
+        while (reportGid != reportGids.end() && *reportGid < gid)
+        {
+            ++reportGid;
+            ++reportIndex;
+        }
+        if (reportGid == reportGids.end() || *reportGid != gid)
+            throw std::runtime_error("Cell " + std::to_string(gid) +
+                                     " is not in the report");
+
+        for (size_t section = 0; section < counts[index].size(); ++section)
+        {
+            // sections without compartments in the report have no offset
+            if (counts[index][section] > 0)
+                ranges.push_back({reportOffsets[reportIndex][section],
+                                  offsets[index][section],
+                                  counts[index][section]});
+        }
+        ++index;
+    }
+
+    auto reader = std::make_shared<CompactFrameReader>(
+        cacheFile, ranges, _compartmentReport->getFrameSize());
+    if (reader->getCacheFrameSize() != report.getFrameSize() ||
+        reader->getNbFrames() != _nbFrames)
+    {
+        throw std::runtime_error(
+            "the cache does not match the report and simulation times");
+    }
+
+    // the cache frames start at its start time, every dt; caches without
+    // recorded times hold the whole report at its own step
+    double cacheStartTime = report.getStartTime();
+    double cacheDt = report.getTimestep();
+    std::ifstream times(cacheFile + SIMULATION_CACHE_TIMES_SUFFIX);
+    if (times && !(times >> cacheStartTime >> cacheDt))
+        throw std::runtime_error("the times of the cache can not be read");
+    const auto sameTime = [](const double a, const double b) {
+        return std::abs(a - b) <= 1e-6 * std::max(1., std::abs(b));
+    };
+    if (!sameTime(cacheStartTime, _startTime) || !sameTime(cacheDt, _dt))
+    {
+        std::stringstream message;
+        message << "the cache starts at " << cacheStartTime << " every "
+                << cacheDt << ", the simulation at " << _startTime
+                << " every " << _dt;
+        throw std::runtime_error(message.str());
+    }
+
+    BRAYNS_INFO << "Reading " << reader->getNbReadValues() << " of "
+                << reader->getCacheFrameSize() << " values per frame in "
+                << reader->getNbReads() << " reads from " << cacheFile
+                << std::endl;
+    _cacheReader = reader;
+}
+
+void CircuitSimulationHandler::_initializeReduction()
+{
+    const auto reduction = _geometryParameters.getCircuitSimulationReduction();
+    const bool perCell = reduction == SimulationReduction::cell_mean ||
+                         reduction == SimulationReduction::cell_max;
+    const auto& offsets = _compartmentReport->getOffsets();
+    const auto& counts = _compartmentReport->getCompartmentCounts();
+
+    // one value per reported section, or per cell; the sections that are not
+    // reported keep an undefined offset, as in the report
+    auto reducer = std::make_shared<SimulationReducer>(reduction);
+    _reducedOffsets.resize(offsets.size());
+    _reducedCounts.resize(counts.size());
+    for (size_t cell = 0; cell < counts.size(); ++cell)
+    {
+        const auto& cellCounts = counts[cell];
+        _reducedOffsets[cell].assign(cellCounts.size(),
+                                     std::numeric_limits<uint64_t>::max());
+        _reducedCounts[cell].assign(cellCounts.size(), 0);
+        const auto cellValue = perCell ? reducer->addValue() : 0;
+        for (size_t section = 0; section < cellCounts.size(); ++section)
+        {
+            if (cellCounts[section] == 0)
+                continue;
+            _reducedOffsets[cell][section] =
+                perCell ? cellValue : reducer->addValue();
+            _reducedCounts[cell][section] = 1;
+            reducer->addRange(offsets[cell][section], cellCounts[section]);
+        }
+    }
+
+    BRAYNS_INFO << "Reducing the simulation frames from " << _frameSize
+                << " to " << reducer->getFrameSize() << " values" << std::endl;
+    _reducer = reducer;
+    _frameSize = reducer->getFrameSize();
+    if (!_cacheReader)
+        return;
+
+    // the name tells the layout and the version of the simulation cache,
+    // other reductions or cells, or a rewritten cache, get another file
+    const auto& cacheFile = _geometryParameters.getCircuitSimulationCacheFile();
+    struct stat sb;
+    if (::stat(cacheFile.c_str(), &sb) == -1)
+        return;
+    std::stringstream filename;
+    filename << cacheFile << ".reduced-" << std::hex
+             << reducer->getLayoutHash() << "-" << uint64_t(sb.st_size) << "-"
+             << uint64_t(sb.st_mtime);
+    _reducedCacheFile = filename.str();
+    try
+    {
+        auto reader =
+            FrameReader::create(_geometryParameters.getSimulationFrameReader(),
+                                _reducedCacheFile);
+        if (reader->getNbFrames() == _nbFrames &&
+            reader->getFrameSize() == _frameSize)
+        {
+            BRAYNS_INFO << "Reading the reduced simulation frames from "
+                        << _reducedCacheFile << std::endl;
+            _reducedCacheReader = std::move(reader);
+            return;
+        }
+    }
+    catch (const std::exception&)
+    {
+        // missing or incomplete, (re)built below
+    }
+
+    _reductionThread = std::thread([this] { _reduceCache(); });
+}
+
+void CircuitSimulationHandler::_reduceCache()
+{
+    try
+    {
+        constexpr size_t blockSize = 4 * 1024 * 1024;
+        SimulationCacheWriter writer(_reducedCacheFile, _nbFrames, _frameSize,
+                                     true, blockSize);
+        BRAYNS_INFO << "Caching the reduced simulation frames in "
+                    << _reducedCacheFile << ", from frame "
+                    << writer.getNbFrames() << std::endl;
+
+        floats frame(_cacheReader->getFrameSize());
+        floats values(_frameSize);
+        for (uint64_t i = writer.getNbFrames();
+             i < _nbFrames && !_cancelReduction; ++i)
+        {
+            _cacheReader->read(i, frame.data());
+            _reducer->reduce(frame.data(), frame.size(), values.data());
+            writer.append(values.data(), 1);
+        }
+        writer.close();
+
+        if (writer.getNbFrames() == _nbFrames)
+        {
+            BRAYNS_INFO << "Reduced simulation frames cached in "
+                        << _reducedCacheFile << std::endl;
+            _reducedCacheReady = true;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        BRAYNS_WARN << "Could not cache the reduced simulation frames in "
+                    << _reducedCacheFile << ": " << e.what() << std::endl;
+    }
+}
+
 void CircuitSimulationHandler::_triggerLoading(const uint32_t frame)
+{
+    if (_currentFrameFuture.valid())
+        _currentFrameFuture.wait();
+
+    // the key frames of the interpolation are not needed anymore
+    if (_keyFrameFuture.valid())
+    {
+        _keyFrameFuture.wait();
+        _keyFrameFuture = {};
+    }
+
+    _ready = false;
+    _loadingFrame = frame;
+    _currentFrameFuture = _loadFrame(frame);
+}
+
+std::future<brion::floatsPtr> CircuitSimulationHandler::_loadFrame(
+    const uint32_t frame)
 {
     auto timestamp = _startTime + frame * _dt;
     timestamp = std::max(_startTime, timestamp);
     timestamp = std::min(_endTime, timestamp);
 
-    if (_currentFrameFuture.valid())
-        _currentFrameFuture.wait();
+    if (_reducedCacheReady && !_reducedCacheReader)
+    {
+        _reductionThread.join();
+        try
+        {
+            _reducedCacheReader = FrameReader::create(
+                _geometryParameters.getSimulationFrameReader(),
+                _reducedCacheFile);
+        }
+        catch (const std::exception& e)
+        {
+            BRAYNS_WARN << e.what() << std::endl;
+        }
+        _reducedCacheReady = false;
+    }
 
-    _ready = false;
-    _currentFrameFuture = _compartmentReport->loadFrame(timestamp);
+    if (_reducedCacheReader)
+    {
+        // the future is destroyed, and waited for, before the reader
+        auto reader = _reducedCacheReader.get();
+        const auto nbFrames = _nbFrames;
+        return std::async(std::launch::async, [reader, frame, nbFrames] {
+            const auto data = reader->getFrame(frame, true);
+            auto values = std::make_shared<brion::floats>(
+                data, data + reader->getFrameSize());
+            if (frame + 1 < nbFrames)
+                reader->prefetch(frame + 1);
+            return values;
+        });
+    }
+
+    std::future<brion::floatsPtr> future;
+    if (_cacheReader)
+    {
+        auto reader = _cacheReader;
+        future = std::async(std::launch::async, [reader, frame] {
+            auto values =
+                std::make_shared<brion::floats>(reader->getFrameSize());
+            reader->read(frame, values->data());
+            return values;
+        });
+    }
+    else
+        future = _compartmentReport->loadFrame(timestamp);
+
+    if (!_reducer)
+        return future;
+
+    auto reducer = _reducer;
+    return std::async(
+        std::launch::async, [reducer, future = std::move(future)]() mutable {
+            const auto fullFrame = future.get();
+            auto values =
+                std::make_shared<brion::floats>(reducer->getFrameSize());
+            reducer->reduce(fullFrame->data(), fullFrame->size(),
+                            values->data());
+            return values;
+        });
 }
 
-bool CircuitSimulationHandler::_isFrameLoaded() const
+bool CircuitSimulationHandler::_isLoaded(
+    const std::future<brion::floatsPtr>& future) const
 {
-    if (!_currentFrameFuture.valid())
+    if (!future.valid())
         return false;
 
     if (_applicationParameters.getSynchronousMode())
     {
-        _currentFrameFuture.wait();
+        future.wait();
         return true;
     }
 
-    return _currentFrameFuture.wait_for(std::chrono::milliseconds(0)) ==
+    return future.wait_for(std::chrono::milliseconds(0)) ==
            std::future_status::ready;
 }
 
-bool CircuitSimulationHandler::_makeFrameReady(const uint32_t frame)
+bool CircuitSimulationHandler::_makeFrameReady()
 {
-    if (_isFrameLoaded())
+    if (_isLoaded(_currentFrameFuture))
     {
         try
         {
@@ -127,11 +476,11 @@ bool CircuitSimulationHandler::_makeFrameReady(const uint32_t frame)
         }
         catch (const std::exception& e)
         {
-            BRAYNS_ERROR << "Error loading simulation frame " << frame << ": "
-                         << e.what() << std::endl;
+            BRAYNS_ERROR << "Error loading simulation frame " << _loadingFrame
+                         << ": " << e.what() << std::endl;
             return false;
         }
-        _currentFrame = frame;
+        _currentFrame = _loadingFrame;
         _ready = true;
     }
     return true;
@@ -27,6 +27,10 @@
 #include <brayns/common/types.h>
 #include <brion/brion.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 namespace brayns
 {
 typedef std::shared_ptr<brion::CompartmentReport> CompartmentReportPtr;
@@ -36,6 +40,16 @@ typedef std::shared_ptr<brion::CompartmentReport> CompartmentReportPtr;
  * current circuit. Frames are stored in a memory mapped file that is accessed
  * according to a specified timestamp. The CircuitSimulationHandler class is in
  * charge of keeping the handle to the memory mapped file.
+ *
+ * If a simulation cache of the report is given with
+ * --circuit-simulation-cache-file, only the values of the loaded cells are
+ * read from it, with the layout of the report opened for these cells.
+ *
+ * With --circuit-simulation-reduction, the frames hold one value per section
+ * or per cell, see SimulationReducer, and getOffsets() and
+ * getCompartmentCounts() map the sections to these values. The reduced frames
+ * of the simulation cache are written once, in the background, to a cache
+ * file next to it, and read from there afterwards.
  */
 class CircuitSimulationHandler : public AbstractSimulationHandler
 {
@@ -55,20 +69,51 @@ public:
     void* getFrameData(uint32_t frame) final;
 
     CompartmentReportPtr getCompartmentReport() { return _compartmentReport; }
+    /** @return the offsets of the sections of the cells in the frames given
+     * by getFrameData(), indexed like the GIDs of the report */
+    const brion::SectionOffsets& getOffsets() const;
+
+    /** @return the number of values of the sections of the cells in the
+     * frames given by getFrameData() */
+    const brion::CompartmentCounts& getCompartmentCounts() const;
+
     bool isReady() const final;
 
+protected:
+    bool _readFrame(uint32_t frame, floats& values) final;
+
 private:
+    void _attachCache(const brion::URI& reportSource,
+                      const std::string& cacheFile);
+    void _initializeReduction();
+    void _reduceCache();
     void _triggerLoading(uint32_t frame);
-    bool _isFrameLoaded() const;
-    bool _makeFrameReady(uint32_t frame);
+    std::future<brion::floatsPtr> _loadFrame(uint32_t frame);
+    bool _isLoaded(const std::future<brion::floatsPtr>& future) const;
+    bool _makeFrameReady();
 
     const ApplicationParameters& _applicationParameters;
 
     CompartmentReportPtr _compartmentReport;
     double _startTime;
     double _endTime;
+    CompactFrameReaderPtr _cacheReader;
+
+    SimulationReducerPtr _reducer;
+    brion::SectionOffsets _reducedOffsets;
+    brion::CompartmentCounts _reducedCounts;
+    std::string _reducedCacheFile;
+    FrameReaderPtr _reducedCacheReader;
+    std::thread _reductionThread;
+    std::atomic<bool> _reducedCacheReady{false};
+    std::atomic<bool> _cancelReduction{false};
+
     std::future<brion::floatsPtr> _currentFrameFuture;
+    uint32_t _loadingFrame{0};
     bool _ready{false};
+
+    std::future<brion::floatsPtr> _keyFrameFuture;
+    uint32_t _keyFrame{0};
 };
 }
 
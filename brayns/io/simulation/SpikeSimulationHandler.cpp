@@ -21,6 +21,7 @@
 #include "SpikeSimulationHandler.h"
 
 #include <brayns/common/log.h>
+#include <brayns/common/simulation/FrameReader.h>
 
 namespace brayns
 {
@@ -32,17 +33,16 @@ SpikeSimulationHandler::SpikeSimulationHandler(
 
 void* SpikeSimulationHandler::getFrameData(const uint32_t frame)
 {
-    if (_nbFrames == 0 || _memoryMapPtr == 0)
+    if (_nbFrames == 0 || !_frameReader)
         return nullptr;
 
-    _frameData.resize(_frameSize);
-
     _currentFrame = _getBoundedFrame(frame);
-    const auto index = _currentFrame % _nbFrames;
-    const uint64_t frameSize = _frameSize * sizeof(float);
-    memcpy(_frameData.data(),
-           (unsigned char*)_memoryMapPtr + _headerSize + index * frameSize,
-           frameSize);
+    const float* data = _frameReader->getFrame(_currentFrame, true);
+    _frameData.assign(data, data + _frameSize);
+
+    // read ahead of the playback while the current frame is rendered
+    for (size_t i = 1; i < _frameReader->getQueueDepth(); ++i)
+        _frameReader->prefetch((_currentFrame + i) % _nbFrames);
     return _frameData.data();
 }
 }
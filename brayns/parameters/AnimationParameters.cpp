@@ -23,6 +23,9 @@
 namespace
 {
 const std::string PARAM_ANIMATION_FRAME = "animation-frame";
+const std::string PARAM_ANIMATION_INTERPOLATION = "animation-interpolation";
+
+const std::string ANIMATION_INTERPOLATIONS[3] = {"none", "linear", "cubic"};
 }
 
 namespace brayns
@@ -30,15 +33,29 @@ namespace brayns
 AnimationParameters::AnimationParameters()
     : AbstractParameters("Animation")
 {
-    _parameters.add_options()(PARAM_ANIMATION_FRAME.c_str(),
-                              po::value<uint32_t>(),
-                              "Scene animation frame [float]");
+    _parameters.add_options() //
+        (PARAM_ANIMATION_FRAME.c_str(), po::value<uint32_t>(),
+         "Scene animation frame [float]")
+        //
+        (PARAM_ANIMATION_INTERPOLATION.c_str(), po::value<std::string>(),
+         "Interpolation of the simulation values between frames "
+         "[none|linear|cubic]");
 }
 
 void AnimationParameters::parse(const po::variables_map& vm)
 {
     if (vm.count(PARAM_ANIMATION_FRAME))
         _current = vm[PARAM_ANIMATION_FRAME].as<uint32_t>();
+    if (vm.count(PARAM_ANIMATION_INTERPOLATION))
+    {
+        const auto& interpolation =
+            vm[PARAM_ANIMATION_INTERPOLATION].as<std::string>();
+        for (size_t i = 0; i < sizeof(ANIMATION_INTERPOLATIONS) /
+                                   sizeof(ANIMATION_INTERPOLATIONS[0]);
+             ++i)
+            if (interpolation == ANIMATION_INTERPOLATIONS[i])
+                _interpolation = static_cast<SimulationInterpolation>(i);
+    }
     markModified();
 }
 
@@ -46,5 +63,9 @@ void AnimationParameters::print()
 {
     AbstractParameters::print();
     BRAYNS_INFO << "Animation frame          : " << _current << std::endl;
+    BRAYNS_INFO << "Interpolation            : "
+                << ANIMATION_INTERPOLATIONS[static_cast<size_t>(
+                       _interpolation)]
+                << std::endl;
 }
 }
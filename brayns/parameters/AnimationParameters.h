@@ -23,6 +23,9 @@
 
 #include "AbstractParameters.h"
 
+#include <algorithm>
+#include <cmath>
+
 SERIALIZATION_ACCESS(AnimationParameters)
 
 namespace brayns
@@ -39,21 +42,54 @@ public:
     void setFrame(uint32_t value)
     {
         _updateValue(_current, adjustCurrent(value));
+        _updateValue(_fraction, 0.);
+    }
+
+    /**
+     * @return the position between getFrame() and the next frame, clamped to
+     *         [0, 1] as it may be set by clients
+     */
+    double getFrameFraction() const
+    {
+        return _fraction > 0 ? std::min(_fraction, 1.) : 0.;
+    }
+    /** @return the fractional frame, getFrame() + getFrameFraction() */
+    double getFramePosition() const { return _current + getFrameFraction(); }
+    /** Sets a fractional frame, wrapped in the frame range */
+    void setFramePosition(const double value)
+    {
+        const auto frame = std::floor(value);
+        _updateValue(_current, adjustCurrent(frame));
+        _updateValue(_fraction, _end == _start ? 0. : value - frame);
     }
 
-    /** The (frame) delta to apply for animations to select the next frame. */
-    void setDelta(const int32_t delta) { _updateValue(_delta, delta); }
-    int32_t getDelta() const { return _delta; }
+    /**
+     * The (frame) delta to apply for animations to select the next frame;
+     * fractional deltas slow down the playback without reading more frames.
+     */
+    void setDelta(const double delta) { _updateValue(_delta, delta); }
+    double getDelta() const { return _delta; }
     void setEnd(const uint32_t end)
     {
         _updateValue(_end, end);
         _updateValue(_current, std::min(_current, _end));
     }
+
+    /** Interpolation of the simulation values at fractional frames */
+    SimulationInterpolation getInterpolation() const
+    {
+        return _interpolation;
+    }
+    void setInterpolation(const SimulationInterpolation value)
+    {
+        _updateValue(_interpolation, value);
+    }
     uint32_t getEnd() const { return _end; }
     void reset()
     {
         _updateValue(_end, 0u);
         _updateValue(_current, 0u);
+        _updateValue(_fraction, 0.);
         _updateValue(_unit, std::string());
         _updateValue(_dt, 0.);
     }
@@ -71,10 +107,22 @@ private:
         return nbFrames == 0 ? 0 : _start + (newCurrent % nbFrames);
     }
 
+    uint32_t adjustCurrent(const double newCurrent) const
+    {
+        const auto nbFrames = _end - _start;
+        if (nbFrames == 0)
+            return 0;
+        // negative deltas play backwards from the start to the end
+        const auto frame = std::fmod(newCurrent, double(nbFrames));
+        return _start + uint32_t(frame < 0 ? frame + nbFrames : frame);
+    }
+
     uint32_t _start{0};
     uint32_t _end{0};
     uint32_t _current{0};
-    int32_t _delta{0};
+    double _fraction{0};
+    double _delta{0};
+    SimulationInterpolation _interpolation{SimulationInterpolation::none};
     double _dt{0};
     std::string _unit;
 
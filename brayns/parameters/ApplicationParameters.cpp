@@ -42,6 +42,7 @@ const std::string PARAM_PARALLEL_RENDERING = "parallel-rendering";
 const std::string PARAM_PLUGIN = "plugin";
 const std::string PARAM_SYNCHRONOUS_MODE = "synchronous-mode";
 const std::string PARAM_TMP_FOLDER = "tmp-folder";
+const std::string PARAM_WARM_STATE_FILE = "warm-state-file";
 const std::string PARAM_WINDOW_SIZE = "window-size";
 
 const size_t DEFAULT_WINDOW_WIDTH = 800;
@@ -93,7 +94,10 @@ ApplicationParameters::ApplicationParameters()
         "Screen space filters [string]")(
         PARAM_FRAME_EXPORT_FOLDER.c_str(), po::value<std::string>(),
         "Folder where frames are exported as PNG images [string]")(
-        PARAM_MAX_RENDER_FPS.c_str(), po::value<size_t>(), "Max. render FPS");
+        PARAM_MAX_RENDER_FPS.c_str(), po::value<size_t>(), "Max. render FPS")(
+        PARAM_WARM_STATE_FILE.c_str(), po::value<std::string>(),
+        "File to reuse the loaded scene from in subsequent runs with the "
+        "same command line; delete it when the data changes [string]");
 
     _positionalArgs.add(PARAM_INPUT_PATHS.c_str(), -1);
 }
@@ -139,6 +143,8 @@ void ApplicationParameters::parse(const po::variables_map& vm)
         _parallelRendering = vm[PARAM_PARALLEL_RENDERING].as<bool>();
     if (vm.count(PARAM_MAX_RENDER_FPS))
         _maxRenderFPS = vm[PARAM_MAX_RENDER_FPS].as<size_t>();
+    if (vm.count(PARAM_WARM_STATE_FILE))
+        _warmStateFile = vm[PARAM_WARM_STATE_FILE].as<std::string>();
 
     // Explode plugin arguments
     for (auto pluginString : _pluginsRaw)
@@ -179,6 +185,8 @@ void ApplicationParameters::print()
                 << std::endl;
     BRAYNS_INFO << "Max. render  FPS            : " << _maxRenderFPS
                 << std::endl;
+    BRAYNS_INFO << "Warm state file             : " << _warmStateFile
+                << std::endl;
 }
 
 const std::string& ApplicationParameters::getEngineAsString(
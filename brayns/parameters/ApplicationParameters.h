@@ -97,6 +97,11 @@ public:
     std::string getFrameExportFolder() const { return _frameExportFolder; }
     /** Folder used by the application to store temporary files */
     std::string getTmpFolder() const { return _tmpFolder; }
+    /**
+     * @return the file where the loaded scene is saved to and reused from by
+     *         runs with the same command line, empty if not used
+     */
+    const std::string& getWarmStateFile() const { return _warmStateFile; }
     /** @return true if synchronous mode is enabled, aka rendering waits for
      * data loading. */
     bool getSynchronousMode() const { return _synchronousMode; }
@@ -127,6 +132,7 @@ protected:
     strings _filters;
     std::string _frameExportFolder;
     std::string _tmpFolder;
+    std::string _warmStateFile;
     bool _synchronousMode{false};
     size_t _imageStreamFPS{60};
     size_t _maxRenderFPS{std::numeric_limits<size_t>::max()};
@@ -34,6 +34,8 @@ const std::string PARAM_CIRCUIT_DENSITY = "circuit-density";
 const std::string PARAM_CIRCUIT_USES_SIMULATION_MODEL =
     "circuit-uses-simulation-model";
 const std::string PARAM_CIRCUIT_BOUNDING_BOX = "circuit-bounding-box";
+const std::string PARAM_CIRCUIT_BOUNDING_BOX_CLIPPING =
+    "circuit-bounding-box-clipping";
 const std::string PARAM_CIRCUIT_MESH_FOLDER = "circuit-mesh-folder";
 const std::string PARAM_CIRCUIT_MESH_FILENAME_PATTERN =
     "circuit-mesh-filename-pattern";
@@ -41,6 +43,10 @@ const std::string PARAM_CIRCUIT_MESH_TRANSFORMATION =
     "circuit-mesh-transformation";
 const std::string PARAM_CIRCUIT_TARGETS = "circuit-targets";
 const std::string PARAM_CIRCUIT_REPORT = "circuit-report";
+const std::string PARAM_CIRCUIT_SIMULATION_CACHE_FILE =
+    "circuit-simulation-cache-file";
+const std::string PARAM_CIRCUIT_SIMULATION_REDUCTION =
+    "circuit-simulation-reduction";
 const std::string PARAM_CIRCUIT_START_SIMULATION_TIME =
     "circuit-start-simulation-time";
 const std::string PARAM_CIRCUIT_END_SIMULATION_TIME =
@@ -70,6 +76,7 @@ const std::string PARAM_MORPHOLOGY_DAMPEN_BRANCH_THICKNESS_CHANGERATE =
 const std::string PARAM_MORPHOLOGY_USE_SDF_GEOMETRIES =
     "morphology-use-sdf-geometries";
 const std::string PARAM_MEMORY_MODE = "memory-mode";
+const std::string PARAM_SIMULATION_FRAME_READER = "simulation-frame-reader";
 
 const std::array<std::string, 12> COLOR_SCHEMES = {
     {"none", "neuron-by-id", "neuron-by-type", "neuron-by-segment-type",
@@ -79,6 +86,10 @@ const std::array<std::string, 12> COLOR_SCHEMES = {
 
 const std::string GEOMETRY_QUALITIES[3] = {"low", "medium", "high"};
 const std::string GEOMETRY_MEMORY_MODES[2] = {"shared", "replicated"};
+const std::string FRAME_READER_TYPES[3] = {"mmap", "pread", "io_uring"};
+const std::string SIMULATION_REDUCTIONS[5] = {"none", "section-mean",
+                                              "section-max", "cell-mean",
+                                              "cell-max"};
 }
 
 namespace brayns
@@ -96,6 +107,7 @@ GeometryParameters::GeometryParameters()
     , _morphologyDampenBranchThicknessChangerate(false)
     , _morphologyUseSDFGeometries(false)
     , _memoryMode(MemoryMode::shared)
+    , _simulationFrameReader(FrameReaderType::io_uring)
 {
     _parameters.add_options() //
         (PARAM_NEST_CIRCUIT.c_str(), po::value<std::string>(),
@@ -142,6 +154,16 @@ GeometryParameters::GeometryParameters()
         (PARAM_CIRCUIT_REPORT.c_str(), po::value<std::string>(),
          "Circuit report [string]")
         //
+        (PARAM_CIRCUIT_SIMULATION_CACHE_FILE.c_str(), po::value<std::string>(),
+         "Simulation cache of the circuit report, only the values of the "
+         "loaded cells are read [string]")
+        //
+        (PARAM_CIRCUIT_SIMULATION_REDUCTION.c_str(), po::value<std::string>(),
+         "Aggregation of the simulation values per section or per cell, "
+         "for circuits seen from a distance. The reduced frames are cached "
+         "next to the simulation cache file "
+         "[none|section-mean|section-max|cell-mean|cell-max]")
+        //
         (PARAM_MORPHOLOGY_SECTION_TYPES.c_str(), po::value<size_t>(),
          "Morphology section types (1: soma, 2: axon, 4: dendrite, "
          "8: apical dendrite). Values can be added to select more than "
@@ -206,11 +228,19 @@ GeometryParameters::GeometryParameters()
          "box"
          "[float float float float float float]")
         //
+        (PARAM_CIRCUIT_BOUNDING_BOX_CLIPPING.c_str(), po::value<bool>(),
+         "Only loads the segments of the cells that intersect the circuit "
+         "bounding box [bool]")
+        //
         (PARAM_MEMORY_MODE.c_str(), po::value<std::string>(),
          "Defines what memory mode should be used between Brayns and "
          "the "
          "underlying renderer [shared|replicated]")
         //
+        (PARAM_SIMULATION_FRAME_READER.c_str(), po::value<std::string>(),
+         "Defines how the frames of simulation cache files are read ahead "
+         "of the playback [mmap|pread|io_uring]")
+        //
         (PARAM_CIRCUIT_MESH_FILENAME_PATTERN.c_str(), po::value<std::string>(),
          "Pattern used to determine the name of the file containing a "
          "meshed "
@@ -270,6 +300,20 @@ void GeometryParameters::parse(const po::variables_map& vm)
     if (vm.count(PARAM_CIRCUIT_REPORT))
         _circuitConfiguration.report =
             vm[PARAM_CIRCUIT_REPORT].as<std::string>();
+    if (vm.count(PARAM_CIRCUIT_SIMULATION_CACHE_FILE))
+        _circuitConfiguration.simulationCacheFile =
+            vm[PARAM_CIRCUIT_SIMULATION_CACHE_FILE].as<std::string>();
+    if (vm.count(PARAM_CIRCUIT_SIMULATION_REDUCTION))
+    {
+        const auto& reduction =
+            vm[PARAM_CIRCUIT_SIMULATION_REDUCTION].as<std::string>();
+        for (size_t i = 0; i < sizeof(SIMULATION_REDUCTIONS) /
+                                   sizeof(SIMULATION_REDUCTIONS[0]);
+             ++i)
+            if (reduction == SIMULATION_REDUCTIONS[i])
+                _circuitConfiguration.simulationReduction =
+                    static_cast<SimulationReduction>(i);
+    }
     if (vm.count(PARAM_CIRCUIT_DENSITY))
         _circuitConfiguration.density = vm[PARAM_CIRCUIT_DENSITY].as<float>();
     if (vm.count(PARAM_CIRCUIT_MESH_FOLDER))
@@ -359,6 +403,9 @@ void GeometryParameters::parse(const po::variables_map& vm)
             BRAYNS_ERROR << "Invalid number of values for "
                          << PARAM_CIRCUIT_BOUNDING_BOX << std::endl;
     }
+    if (vm.count(PARAM_CIRCUIT_BOUNDING_BOX_CLIPPING))
+        _circuitConfiguration.boundingBoxClipping =
+            vm[PARAM_CIRCUIT_BOUNDING_BOX_CLIPPING].as<bool>();
     if (vm.count(PARAM_MEMORY_MODE))
     {
         const auto& memoryMode = vm[PARAM_MEMORY_MODE].as<std::string>();
@@ -368,6 +415,16 @@ void GeometryParameters::parse(const po::variables_map& vm)
             if (memoryMode == GEOMETRY_MEMORY_MODES[i])
                 _memoryMode = static_cast<MemoryMode>(i);
     }
+    if (vm.count(PARAM_SIMULATION_FRAME_READER))
+    {
+        const auto& frameReader =
+            vm[PARAM_SIMULATION_FRAME_READER].as<std::string>();
+        for (size_t i = 0;
+             i < sizeof(FRAME_READER_TYPES) / sizeof(FRAME_READER_TYPES[0]);
+             ++i)
+            if (frameReader == FRAME_READER_TYPES[i])
+                _simulationFrameReader = static_cast<FrameReaderType>(i);
+    }
     if (vm.count(PARAM_CIRCUIT_MESH_FILENAME_PATTERN))
         _circuitConfiguration.meshFilenamePattern =
             vm[PARAM_CIRCUIT_MESH_FILENAME_PATTERN].as<std::string>();
@@ -404,6 +461,12 @@ void GeometryParameters::print()
                 << _circuitConfiguration.targets << std::endl;
     BRAYNS_INFO << " - Report                  : "
                 << _circuitConfiguration.report << std::endl;
+    BRAYNS_INFO << " - Simulation cache file   : "
+                << _circuitConfiguration.simulationCacheFile << std::endl;
+    BRAYNS_INFO << " - Simulation reduction    : "
+                << SIMULATION_REDUCTIONS[static_cast<size_t>(
+                       _circuitConfiguration.simulationReduction)]
+                << std::endl;
     BRAYNS_INFO << " - Mesh folder             : "
                 << _circuitConfiguration.meshFolder << std::endl;
     BRAYNS_INFO << " - Density                 : "
@@ -420,6 +483,9 @@ void GeometryParameters::print()
                 << _circuitConfiguration.simulationHistogramSize << std::endl;
     BRAYNS_INFO << " - Bounding box            : "
                 << _circuitConfiguration.boundingBox << std::endl;
+    BRAYNS_INFO << " - Bounding box clipping   : "
+                << (_circuitConfiguration.boundingBoxClipping ? "Yes" : "No")
+                << std::endl;
     BRAYNS_INFO << " - Mesh transformation     : "
                 << (_circuitConfiguration.meshTransformation ? "Yes" : "No")
                 << std::endl;
@@ -447,6 +513,10 @@ void GeometryParameters::print()
     BRAYNS_INFO << "Memory mode                : "
                 << (_memoryMode == MemoryMode::shared ? "Shared" : "Replicated")
                 << std::endl;
+    BRAYNS_INFO << "Simulation frame reader    : "
+                << FRAME_READER_TYPES[static_cast<size_t>(
+                       _simulationFrameReader)]
+                << std::endl;
     BRAYNS_INFO << "Mesh filename pattern      : "
                 << _circuitConfiguration.meshFilenamePattern << std::endl;
 }
@@ -47,11 +47,14 @@ struct CircuitConfiguration
     std::string circuitConfigFile;
     bool useSimulationModel{false};
     Boxd boundingBox{{0, 0, 0}, {0, 0, 0}};
+    bool boundingBoxClipping{false};
     float density{100};
     std::string meshFilenamePattern;
     std::string meshFolder;
     std::string targets;
     std::string report;
+    std::string simulationCacheFile;
+    SimulationReduction simulationReduction{SimulationReduction::none};
     double startSimulationTime{0};
     double endSimulationTime{std::numeric_limits<float>::max()};
     double simulationStep{0};
@@ -102,6 +105,19 @@ public:
     {
         return _circuitConfiguration.report;
     }
+    /**
+     * Simulation cache of the whole circuit report, written by
+     * braynsSimulationConverter, read instead of the report
+     */
+    const std::string& getCircuitSimulationCacheFile() const
+    {
+        return _circuitConfiguration.simulationCacheFile;
+    }
+    /** Aggregation of the simulation values of the circuit */
+    SimulationReduction getCircuitSimulationReduction() const
+    {
+        return _circuitConfiguration.simulationReduction;
+    }
     /** Defines the folder where morphologies meshes are stored. Meshes must
      * have the same name as the h5/SWC morphology file, suffixed with an
      * extension supported by the assimp library
@@ -116,7 +132,8 @@ public:
 
     /**
      * Defines a bounding box outside of which geometry of a circuit will not be
-     * loaded
+     * loaded. The cells whose morphology intersects the box are selected with
+     * a spatial index of the circuit, cached in the temporary folder.
      */
     const Boxd& getCircuitBoundingBox() const
     {
@@ -127,6 +144,19 @@ public:
         _updateValue(_circuitConfiguration.boundingBox, value);
     }
 
+    /**
+     * If only the segments of the selected cells that intersect the circuit
+     * bounding box are loaded, instead of the whole cells
+     */
+    bool getCircuitBoundingBoxClipping() const
+    {
+        return _circuitConfiguration.boundingBoxClipping;
+    }
+    void setCircuitBoundingBoxClipping(const bool value)
+    {
+        _updateValue(_circuitConfiguration.boundingBoxClipping, value);
+    }
+
     /**
      * Defines if a different model is used to handle the simulation geometry.
      * If set to True, the shading of the main geometry model will be done
@@ -251,6 +281,11 @@ public:
      * underlying renderer
      */
     MemoryMode getMemoryMode() const { return _memoryMode; };
+    /** Defines how the frames of simulation cache files are read */
+    FrameReaderType getSimulationFrameReader() const
+    {
+        return _simulationFrameReader;
+    }
     bool getMorphologyDampenBranchThicknessChangerate() const
     {
         return _morphologyDampenBranchThicknessChangerate;
@@ -292,6 +327,7 @@ protected:
 
     // System parameters
     MemoryMode _memoryMode;
+    FrameReaderType _simulationFrameReader;
 
     SERIALIZATION_FRIEND(GeometryParameters)
 };
@@ -28,10 +28,17 @@ namespace
 const std::string PARAM_ACCUMULATION = "accumulation";
 const std::string PARAM_BACKGROUND_COLOR = "background-color";
 const std::string PARAM_CAMERA = "camera";
+const std::string PARAM_FOVEATED_RENDERING = "foveated-rendering";
+const std::string PARAM_FOVEATION_FOCUS = "foveation-focus";
+const std::string PARAM_FOVEATION_PERIPHERAL_DENSITY =
+    "foveation-peripheral-density";
+const std::string PARAM_FOVEATION_RADII = "foveation-radii";
 const std::string PARAM_HEAD_LIGHT = "head-light";
 const std::string PARAM_MAX_ACCUMULATION_FRAMES = "max-accumulation-frames";
 const std::string PARAM_RENDERER = "renderer";
 const std::string PARAM_SPP = "samples-per-pixel";
+const std::string PARAM_STEREO_REPROJECTION = "stereo-reprojection";
+const std::string PARAM_TEMPORAL_REPROJECTION = "temporal-reprojection";
 const std::string PARAM_VARIANCE_THRESHOLD = "variance-threshold";
 
 const std::array<std::string, 8> RENDERER_NAMES = {
@@ -64,7 +71,24 @@ RenderingParameters::RenderingParameters()
         PARAM_VARIANCE_THRESHOLD.c_str(), po::value<float>(),
         "Threshold for adaptive accumulation [float]")(
         PARAM_MAX_ACCUMULATION_FRAMES.c_str(), po::value<size_t>(),
-        "Maximum number of accumulation frames");
+        "Maximum number of accumulation frames")(
+        PARAM_STEREO_REPROJECTION.c_str(), po::value<bool>(),
+        "Reproject the left eye to the right eye on the first frame of side "
+        "by side stereo [bool]")(
+        PARAM_TEMPORAL_REPROJECTION.c_str(), po::value<bool>(),
+        "Continue the accumulation from the previous frames after camera "
+        "moves [bool]")(
+        PARAM_FOVEATED_RENDERING.c_str(), po::value<bool>(),
+        "Trace the first frame with a sample density decreasing away from "
+        "the focus point, and interpolate the skipped pixels [bool]")(
+        PARAM_FOVEATION_FOCUS.c_str(), po::value<floats>()->multitoken(),
+        "Normalized screen position of the full sample density [float "
+        "float]")(PARAM_FOVEATION_RADII.c_str(),
+                  po::value<floats>()->multitoken(),
+                  "Radii of the full and of the peripheral sample density, "
+                  "relative to the frame height [float float]")(
+        PARAM_FOVEATION_PERIPHERAL_DENSITY.c_str(), po::value<float>(),
+        "Fraction of the pixels traced in the periphery [float]");
 
     initializeDefaultRenderers();
     initializeDefaultCameras();
@@ -114,6 +138,27 @@ void RenderingParameters::parse(const po::variables_map& vm)
         _varianceThreshold = vm[PARAM_VARIANCE_THRESHOLD].as<float>();
     if (vm.count(PARAM_MAX_ACCUMULATION_FRAMES))
         _maxAccumFrames = vm[PARAM_MAX_ACCUMULATION_FRAMES].as<size_t>();
+    if (vm.count(PARAM_STEREO_REPROJECTION))
+        _stereoReprojection = vm[PARAM_STEREO_REPROJECTION].as<bool>();
+    if (vm.count(PARAM_TEMPORAL_REPROJECTION))
+        _temporalReprojection = vm[PARAM_TEMPORAL_REPROJECTION].as<bool>();
+    if (vm.count(PARAM_FOVEATED_RENDERING))
+        _foveatedRendering = vm[PARAM_FOVEATED_RENDERING].as<bool>();
+    if (vm.count(PARAM_FOVEATION_FOCUS))
+    {
+        floats values = vm[PARAM_FOVEATION_FOCUS].as<floats>();
+        if (values.size() == 2)
+            _foveationFocus = Vector2d(values[0], values[1]);
+    }
+    if (vm.count(PARAM_FOVEATION_RADII))
+    {
+        floats values = vm[PARAM_FOVEATION_RADII].as<floats>();
+        if (values.size() == 2)
+            _foveationRadii = Vector2d(values[0], values[1]);
+    }
+    if (vm.count(PARAM_FOVEATION_PERIPHERAL_DENSITY))
+        _foveationPeripheralDensity =
+            vm[PARAM_FOVEATION_PERIPHERAL_DENSITY].as<float>();
     markModified();
 }
 
@@ -134,5 +179,20 @@ void RenderingParameters::print()
                 << (_accumulation ? "on" : "off") << std::endl;
     BRAYNS_INFO << "Max. accumulation frames          : " << _maxAccumFrames
                 << std::endl;
+    BRAYNS_INFO << "Stereo reprojection               : "
+                << (_stereoReprojection ? "on" : "off") << std::endl;
+    BRAYNS_INFO << "Temporal reprojection             : "
+                << (_temporalReprojection ? "on" : "off") << std::endl;
+    BRAYNS_INFO << "Foveated rendering                : "
+                << (_foveatedRendering ? "on" : "off") << std::endl;
+    if (_foveatedRendering)
+    {
+        BRAYNS_INFO << "- Focus                           : "
+                    << _foveationFocus << std::endl;
+        BRAYNS_INFO << "- Radii                           : "
+                    << _foveationRadii << std::endl;
+        BRAYNS_INFO << "- Peripheral density              : "
+                    << _foveationPeripheralDensity << std::endl;
+    }
 }
 }
@@ -95,6 +95,68 @@ public:
         _updateValue(_maxAccumFrames, value);
     }
     size_t getMaxAccumFrames() const { return _maxAccumFrames; }
+
+    /**
+     * If the right eye of side by side stereo cameras is reprojected from the
+     * left eye on the first frame, tracing only the disoccluded pixels.
+     */
+    bool getStereoReprojection() const { return _stereoReprojection; }
+    void setStereoReprojection(const bool value)
+    {
+        _updateValue(_stereoReprojection, value);
+    }
+
+    /**
+     * If the frame accumulated before a camera move is reprojected to the new
+     * view to continue the accumulation, instead of restarting from scratch.
+     */
+    bool getTemporalReprojection() const { return _temporalReprojection; }
+    void setTemporalReprojection(const bool value)
+    {
+        _updateValue(_temporalReprojection, value);
+    }
+
+    /**
+     * If the first frame is traced with a sample density that decreases away
+     * from the focus point, interpolating the skipped pixels.
+     */
+    bool getFoveatedRendering() const { return _foveatedRendering; }
+    void setFoveatedRendering(const bool value)
+    {
+        _updateValue(_foveatedRendering, value);
+    }
+
+    /**
+     * Normalized screen position of the full sample density, (0, 0) being the
+     * bottom left corner of the frame. Meant to follow a tracked point of
+     * attention on large displays.
+     */
+    const Vector2d& getFoveationFocus() const { return _foveationFocus; }
+    void setFoveationFocus(const Vector2d& value)
+    {
+        _updateValue(_foveationFocus, value);
+    }
+
+    /**
+     * Distances to the focus, relative to the frame height, up to which the
+     * sample density is full, and from which it is the peripheral one.
+     */
+    const Vector2d& getFoveationRadii() const { return _foveationRadii; }
+    void setFoveationRadii(const Vector2d& value)
+    {
+        _updateValue(_foveationRadii, value);
+    }
+
+    /** Fraction of the pixels traced in the periphery */
+    double getFoveationPeripheralDensity() const
+    {
+        return _foveationPeripheralDensity;
+    }
+    void setFoveationPeripheralDensity(const double value)
+    {
+        _updateValue(_foveationPeripheralDensity, value);
+    }
+
 protected:
     void initializeDefaultRenderers();
     void parse(const po::variables_map& vm) final;
@@ -109,6 +171,12 @@ protected:
     bool _headLight{true};
     double _varianceThreshold{-1.};
     size_t _maxAccumFrames{100};
+    bool _stereoReprojection{false};
+    bool _temporalReprojection{false};
+    bool _foveatedRendering{false};
+    Vector2d _foveationFocus{0.5, 0.5};
+    Vector2d _foveationRadii{0.25, 1.};
+    double _foveationPeripheralDensity{1. / 16.};
 
     SERIALIZATION_FRIEND(RenderingParameters)
 };
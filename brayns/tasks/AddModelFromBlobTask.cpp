@@ -26,6 +26,7 @@
 #include <brayns/common/engine/Engine.h>
 #include <brayns/common/scene/Scene.h>
 
+#include <iomanip>
 #include <sstream>
 
 namespace brayns
@@ -37,6 +38,28 @@ AddModelFromBlobTask::AddModelFromBlobTask(const BinaryParam& param,
     _checkValidity(engine);
 
     _blob.reserve(param.size);
+    _startTime = std::chrono::steady_clock::now();
+
+    // the size, and the progress, refer to the uncompressed data
+    if (!param.compression.empty())
+    {
+        _decompressor = std::make_unique<StreamDecompressor>(
+            param.compression,
+            [this](const char* data, const size_t size) {
+                _appendData(data, size);
+            },
+            [this](const std::string& error) {
+                _errorEvent.set_exception(std::make_exception_ptr(
+                    LOADING_BINARY_FAILED("Invalid compressed data: " +
+                                          error)));
+            },
+            [this] {
+                if (_receivedBytes != _param.size)
+                    _errorEvent.set_exception(
+                        std::make_exception_ptr(LOADING_BINARY_FAILED(
+                            "Compressed data is incomplete")));
+            });
+    }
 
     LoadModelFunctor functor{engine};
     functor.setCancelToken(_cancelToken);
@@ -67,20 +90,46 @@ AddModelFromBlobTask::AddModelFromBlobTask(const BinaryParam& param,
 }
 
 void AddModelFromBlobTask::appendBlob(const std::string& blob)
+{
+    if (!_decompressor)
+    {
+        _appendData(blob.data(), blob.size());
+        return;
+    }
+
+    // compressed chunks are decompressed on the worker thread of the
+    // decompressor, which appends the data
+    _receivedCompressedBytes += blob.size();
+    if (_receivedCompressedBytes > _param.compressedSize)
+    {
+        _errorEvent.set_exception(
+            std::make_exception_ptr(INVALID_BINARY_RECEIVE));
+        return;
+    }
+    _decompressor->push(blob);
+
+    // the end of the stream lets the worker finish instead of waiting for
+    // more data
+    if (_receivedCompressedBytes == _param.compressedSize)
+        _decompressor->close();
+}
+
+void AddModelFromBlobTask::_appendData(const char* data, const size_t size)
 {
     // if more bytes than expected are received, error and stop
-    if (_blob.size() + blob.size() > _param.size)
+    if (_blob.size() + size > _param.size)
     {
         _errorEvent.set_exception(
             std::make_exception_ptr(INVALID_BINARY_RECEIVE));
         return;
     }
 
-    _blob += blob;
+    _blob.append(data, size);
 
-    _receivedBytes += blob.size();
+    _receivedBytes += size;
     std::stringstream msg;
-    msg << "Receiving " << _param.getName() << " ...";
+    msg << "Receiving " << _param.getName() << " (" << std::fixed
+        << std::setprecision(1) << _throughput() << " MB/s) ...";
     progress.update(msg.str(), _progressBytes());
 
     // if blob is complete, start the loading
@@ -88,11 +137,27 @@ void AddModelFromBlobTask::appendBlob(const std::string& blob)
         _chunkEvent.set({_param.type, _param.getName(), std::move(_blob)});
 }
 
+float AddModelFromBlobTask::_throughput() const
+{
+    const std::chrono::duration<float> elapsed =
+        std::chrono::steady_clock::now() - _startTime;
+    const float megabytes = _receivedBytes / 1048576.f;
+    return elapsed.count() > 0.f ? megabytes / elapsed.count() : 0.f;
+}
+
 void AddModelFromBlobTask::_checkValidity(EnginePtr engine)
 {
     if (_param.type.empty() || _param.size == 0)
         throw MISSING_PARAMS;
 
+    if (!_param.compression.empty())
+    {
+        if (!StreamDecompressor::isSupported(_param.compression))
+            throw UNSUPPORTED_COMPRESSION;
+        if (_param.compressedSize == 0)
+            throw MISSING_PARAMS;
+    }
+
     const auto& registry = engine->getScene().getLoaderRegistry();
     if (!registry.isSupported(_param.type))
     {
@@ -22,6 +22,10 @@
 
 #include <brayns/common/scene/Model.h>
 #include <brayns/common/tasks/Task.h>
+#include <brayns/common/utils/StreamDecompressor.h>
+
+#include <atomic>
+#include <chrono>
 
 namespace brayns
 {
@@ -41,6 +45,8 @@ struct BinaryParam : ModelParams
     size_t size{0};   //!< size in bytes of file
     std::string type; //!< file extension or type (MESH, POINTS, CIRCUIT)
     size_t chunksID{0};
+    std::string compression; //!< compression of the chunks, none if empty
+    size_t compressedSize{0}; //!< size in bytes of the compressed chunks
     SERIALIZATION_FRIEND(BinaryParam)
 };
 
@@ -56,6 +62,7 @@ public:
     void appendBlob(const std::string& blob);
 
 private:
+    void _appendData(const char* data, size_t size);
     void _checkValidity(EnginePtr engine);
     void _cancel() final
     {
@@ -66,13 +73,21 @@ private:
     {
         return CHUNK_PROGRESS_WEIGHT * ((float)_receivedBytes / _param.size);
     }
+    float _throughput() const;
 
     async::event_task<Blob> _chunkEvent;
     async::event_task<ModelDescriptorPtr> _errorEvent;
     std::vector<async::task<ModelDescriptorPtr>> _finishTasks;
     std::string _blob;
     BinaryParam _param;
-    size_t _receivedBytes{0};
+
+    // updated by the worker thread of the decompressor, if any
+    std::atomic<size_t> _receivedBytes{0};
+    size_t _receivedCompressedBytes{0};
     const float CHUNK_PROGRESS_WEIGHT{0.5f};
+    std::chrono::steady_clock::time_point _startTime;
+
+    // last member, the worker thread uses the members above
+    std::unique_ptr<StreamDecompressor> _decompressor;
 };
 }
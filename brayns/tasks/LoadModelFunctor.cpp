@@ -38,6 +38,17 @@ namespace brayns
 {
 const float TOTAL_PROGRESS = 100.f;
 
+namespace
+{
+/** Folder for extracted archives, removed with its content */
+struct TemporaryFolder
+{
+    TemporaryFolder() { fs::create_directories(path); }
+    ~TemporaryFolder() { fs::remove_all(path); }
+    const fs::path path = fs::temp_directory_path() / fs::unique_path();
+};
+}
+
 LoadModelFunctor::LoadModelFunctor(EnginePtr engine)
     : _engine(engine)
 {
@@ -45,24 +56,15 @@ LoadModelFunctor::LoadModelFunctor(EnginePtr engine)
 
 ModelDescriptorPtr LoadModelFunctor::operator()(Blob&& blob)
 {
-    // extract the archive and treat it as 'load from folder'
     if (isArchive(blob))
     {
-        struct Scope
-        {
-            Scope() { fs::create_directories(_path); }
-            ~Scope() { fs::remove_all(_path); }
-            ModelDescriptorPtr operator()(Blob&& b, LoadModelFunctor& parent)
-            {
-                extractBlob(std::move(b), _path.string());
-                return parent._performLoad(
-                    [&] { return parent._loadData(_path.string()); });
-            }
-
-        private:
-            fs::path _path = fs::temp_directory_path() / fs::unique_path();
-        } scope;
-        return scope(std::move(blob), *this);
+        TemporaryFolder folder;
+        auto blobs = readArchive(blob,
+                                 [this](const std::string& path) {
+                                     return _canLoadFromBlob(path);
+                                 },
+                                 folder.path.string());
+        return _loadArchive(std::move(blobs), folder.path.string());
     }
 
     return _performLoad([&] { return _loadData(std::move(blob)); });
@@ -70,30 +72,30 @@ ModelDescriptorPtr LoadModelFunctor::operator()(Blob&& blob)
 
 ModelDescriptorPtr LoadModelFunctor::operator()(const std::string& path)
 {
-    // extract the archive and treat it as 'load from folder'
     if (isArchive(path))
     {
-        struct Scope
-        {
-            Scope() { fs::create_directories(_path); }
-            ~Scope() { fs::remove_all(_path); }
-            ModelDescriptorPtr operator()(const std::string& file,
-                                          LoadModelFunctor& parent)
-            {
-                extractFile(file, _path.string());
-                return parent._performLoad(
-                    [&] { return parent._loadData(_path.string()); });
-            }
-
-        private:
-            fs::path _path = fs::temp_directory_path() / fs::unique_path();
-        } scope;
-        return scope(path, *this);
+        TemporaryFolder folder;
+        auto blobs = readArchive(path,
+                                 [this](const std::string& entry) {
+                                     return _canLoadFromBlob(entry);
+                                 },
+                                 folder.path.string());
+        return _loadArchive(std::move(blobs), folder.path.string());
     }
 
     return _performLoad([&] { return _loadData(path); });
 }
 
+ModelDescriptorPtr LoadModelFunctor::_loadArchive(std::vector<Blob>&& blobs,
+                                                  const std::string& folder)
+{
+    // import the entries from memory if all of them can be loaded from blobs,
+    // otherwise the archive was extracted and is treated as 'load from folder'
+    if (!blobs.empty())
+        return _performLoad([&] { return _loadData(std::move(blobs)); });
+    return _performLoad([&] { return _loadData(folder); });
+}
+
 ModelDescriptorPtr LoadModelFunctor::_performLoad(
     const std::function<ModelDescriptorPtr()>& loadData)
 {
@@ -120,6 +122,23 @@ ModelDescriptorPtr LoadModelFunctor::_loadData(const std::string& path)
     return _engine->getScene().load(path, NO_MATERIAL, _getProgressFunc());
 }
 
+ModelDescriptorPtr LoadModelFunctor::_loadData(std::vector<Blob>&& blobs)
+{
+    return _engine->getScene().load(std::move(blobs), NO_MATERIAL,
+                                    _getProgressFunc());
+}
+
+bool LoadModelFunctor::_canLoadFromBlob(const std::string& path) const
+{
+    // other files, like textures or material files, are probably referenced
+    // by the models and need to be extracted to disk
+    const auto& registry = _engine->getScene().getLoaderRegistry();
+    auto extension = fs::extension(path);
+    if (extension.empty() || isSupportedArchiveType(extension.erase(0, 1)))
+        return false;
+    return registry.isSupportedFromBlob(path);
+}
+
 void LoadModelFunctor::_updateProgress(const std::string& message,
                                        const size_t increment)
 {
@@ -43,6 +43,16 @@ private:
 
     ModelDescriptorPtr _loadData(Blob&& blob);
     ModelDescriptorPtr _loadData(const std::string& path);
+    ModelDescriptorPtr _loadData(std::vector<Blob>&& blobs);
+
+    /**
+     * Loads the entries read from an archive, or the folder where it was
+     * extracted if some entries could not be loaded from memory.
+     */
+    ModelDescriptorPtr _loadArchive(std::vector<Blob>&& blobs,
+                                    const std::string& folder);
+
+    bool _canLoadFromBlob(const std::string& path) const;
 
     void _updateProgress(const std::string& message, const size_t increment);
 
@@ -59,4 +59,7 @@ inline TaskRuntimeError LOADING_BINARY_FAILED(const std::string& error)
 {
     return {error, -1734};
 }
+
+const TaskRuntimeError UNSUPPORTED_COMPRESSION{
+    "Unsupported compression; use gzip, bzip2, xz, lz4 or zstd", -1735};
 }
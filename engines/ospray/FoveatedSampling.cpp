@@ -0,0 +1,204 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "FoveatedSampling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace brayns
+{
+namespace
+{
+const float INFINITE_DEPTH = std::numeric_limits<float>::infinity();
+
+/** @return the distance from value to the [begin, end] range */
+float distance(const float value, const float begin, const float end)
+{
+    return value < begin ? begin - value : value > end ? value - end : 0.f;
+}
+}
+
+size_t FoveatedSampling::sample(const Parameters& parameters,
+                                const Vector2ui& frameSize)
+{
+    _frameSize = frameSize;
+    const uint32_t width = frameSize.x();
+    const uint32_t height = frameSize.y();
+
+    // the blocks of a view are the same in all views, the last view takes
+    // the remaining columns of a width not divisible by the number of views
+    _numViews = std::max(std::min(parameters.numViews, width), 1u);
+    _viewWidth = std::max(width / _numViews, 1u);
+    _numBlocksX = (_viewWidth + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const uint32_t numBlocksY = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    _strides.resize(_numBlocksX * numBlocksY);
+    for (uint32_t blockY = 0; blockY < numBlocksY; ++blockY)
+        for (uint32_t blockX = 0; blockX < _numBlocksX; ++blockX)
+            _strides[blockY * _numBlocksX + blockX] =
+                _computeStride(parameters, blockX, blockY);
+
+    _colors.assign(width * height, Vector4f(0.f, 0.f, 0.f, 0.f));
+    _depths.assign(width * height, INFINITE_DEPTH);
+    size_t numPixelsToTrace = 0;
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            if (!_isTraced(x, y))
+                continue;
+            _colors[y * width + x] = Vector4f(0.f, 0.f, 0.f, -1.f);
+            ++numPixelsToTrace;
+        }
+    }
+    return numPixelsToTrace;
+}
+
+void FoveatedSampling::interpolate(const float* colors, const float* depths)
+{
+    const uint32_t width = _frameSize.x();
+    const uint32_t height = _frameSize.y();
+
+#pragma omp parallel for
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            const size_t index = size_t(y) * width + x;
+            if (_isTraced(x, y))
+            {
+                const float* color = colors + 4 * index;
+                _colors[index] =
+                    Vector4f(color[0], color[1], color[2], color[3]);
+                _depths[index] = depths[index];
+                continue;
+            }
+
+            // Bilinear interpolation of the traced corners of the stride
+            // grid. The corners missing in a neighbouring block of larger
+            // stride are ignored, and the grid of the next stride is used if
+            // none is traced. The corner at the origin of the MAX_STRIDE grid
+            // is traced in all blocks. The grid is aligned on the view, the
+            // corners in the next view are ignored.
+            const uint32_t view = _getView(x);
+            const uint32_t viewBegin = view * _viewWidth;
+            const uint32_t viewEnd =
+                view + 1 == _numViews ? width : viewBegin + _viewWidth;
+            const uint32_t stride = _getStride(x, y);
+            for (uint32_t size = stride; size <= MAX_STRIDE; size *= 2)
+            {
+                const uint32_t x0 = x - (x - viewBegin) % size;
+                const uint32_t y0 = y - y % size;
+                const float fx = float(x - x0) / size;
+                const float fy = float(y - y0) / size;
+
+                Vector4f color(0.f, 0.f, 0.f, 0.f);
+                float totalWeight = 0.f;
+                float maxWeight = 0.f;
+                float depth = INFINITE_DEPTH;
+                for (uint32_t corner = 0; corner < 4; ++corner)
+                {
+                    const uint32_t cx = x0 + (corner & 1) * size;
+                    const uint32_t cy = y0 + (corner >> 1) * size;
+                    if (cx >= viewEnd || cy >= height || !_isTraced(cx, cy))
+                        continue;
+
+                    const float weight = ((corner & 1) ? fx : 1.f - fx) *
+                                         ((corner >> 1) ? fy : 1.f - fy);
+                    const size_t cornerIndex = size_t(cy) * width + cx;
+                    const float* cornerColor = colors + 4 * cornerIndex;
+                    color += Vector4f(cornerColor[0], cornerColor[1],
+                                      cornerColor[2], cornerColor[3]) *
+                             weight;
+                    totalWeight += weight;
+
+                    // blending depths would create surfaces in between
+                    if (weight > maxWeight)
+                    {
+                        maxWeight = weight;
+                        depth = depths[cornerIndex];
+                    }
+                }
+
+                if (totalWeight > 0.f)
+                {
+                    _colors[index] = color / totalWeight;
+                    _depths[index] = depth;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+uint32_t FoveatedSampling::_computeStride(const Parameters& parameters,
+                                          const uint32_t blockX,
+                                          const uint32_t blockY) const
+{
+    // distance from the focus to the closest pixel of the block, relative to
+    // the frame height
+    const float height = _frameSize.y();
+    const float focusX = parameters.focus.x() * _viewWidth;
+    const float focusY = parameters.focus.y() * height;
+    const float dx =
+        distance(focusX, blockX * BLOCK_SIZE, (blockX + 1) * BLOCK_SIZE);
+    const float dy =
+        distance(focusY, blockY * BLOCK_SIZE, (blockY + 1) * BLOCK_SIZE);
+    const float radius = std::sqrt(dx * dx + dy * dy) / height;
+
+    float t = radius > parameters.innerRadius ? 1.f : 0.f;
+    if (parameters.outerRadius > parameters.innerRadius)
+        t = std::min(std::max((radius - parameters.innerRadius) /
+                                  (parameters.outerRadius -
+                                   parameters.innerRadius),
+                              0.f),
+                     1.f);
+    const float density = 1.f + t * (parameters.peripheralDensity - 1.f);
+
+    uint32_t stride = 1;
+    while (stride * 2 <= MAX_STRIDE &&
+           1.f / float(4 * stride * stride) >= density)
+    {
+        stride *= 2;
+    }
+    return stride;
+}
+
+uint32_t FoveatedSampling::_getView(const uint32_t x) const
+{
+    return std::min(x / _viewWidth, _numViews - 1);
+}
+
+uint32_t FoveatedSampling::_getStride(const uint32_t x, const uint32_t y) const
+{
+    // the extra columns of the last view use the strides of its last blocks
+    const uint32_t viewX = x - _getView(x) * _viewWidth;
+    const uint32_t blockX = std::min(viewX / BLOCK_SIZE, _numBlocksX - 1);
+    return _strides[(y / BLOCK_SIZE) * _numBlocksX + blockX];
+}
+
+bool FoveatedSampling::_isTraced(const uint32_t x, const uint32_t y) const
+{
+    const uint32_t stride = _getStride(x, y);
+    const uint32_t viewX = x - _getView(x) * _viewWidth;
+    return viewX % stride == 0 && y % stride == 0;
+}
+}
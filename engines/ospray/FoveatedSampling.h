@@ -0,0 +1,103 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * Traces a subset of the pixels of a frame following a sample density map,
+ * and interpolates the skipped pixels from the traced ones.
+ *
+ * The density is full around a focus point and decreases linearly to the
+ * peripheral density between the inner and outer radii. The frame is divided
+ * in blocks of BLOCK_SIZE pixels, each block traces one pixel out of a power
+ * of two stride in both directions matching its density. The strides are
+ * aligned on the whole frame, so that the pixels traced with a larger stride
+ * are also traced by the blocks of smaller strides.
+ *
+ * A frame made of several views side by side, e.g. the eyes of a stereo
+ * frame, is sampled per view: each view has its own focus and block grid, and
+ * the interpolation never blends pixels of different views.
+ */
+class FoveatedSampling
+{
+public:
+    struct Parameters
+    {
+        /**
+         * Normalized position of the full density in each view, (0, 0) is
+         * bottom left
+         */
+        Vector2f focus{0.5f, 0.5f};
+        /** Radius of the full density, relative to the frame height */
+        float innerRadius{0.25f};
+        /** Radius where the peripheral density is reached */
+        float outerRadius{1.f};
+        /** Fraction of the pixels traced in the periphery */
+        float peripheralDensity{1.f / 16.f};
+        /** Number of views of equal width side by side in the frame */
+        uint32_t numViews{1};
+    };
+
+    static constexpr uint32_t BLOCK_SIZE = 16;
+    static constexpr uint32_t MAX_STRIDE = 4;
+
+    /**
+     * Computes the pixels to trace.
+     * @return the number of pixels to trace
+     */
+    size_t sample(const Parameters& parameters, const Vector2ui& frameSize);
+
+    /**
+     * Fills the skipped pixels from the traced ones of the frame rendered with
+     * the colors and depths of sample().
+     *
+     * @param colors RGBA colors of the whole frame
+     * @param depths distance along the ray of the whole frame
+     */
+    void interpolate(const float* colors, const float* depths);
+
+    /**
+     * @return the RGBA colors of the whole frame: after sample(), a negative
+     *         alpha for the pixels to trace; after interpolate(), the
+     *         interpolated frame
+     */
+    const Vector4fs& getColors() const { return _colors; }
+    /** @return the depths matching getColors() */
+    const floats& getDepths() const { return _depths; }
+private:
+    uint32_t _computeStride(const Parameters& parameters, uint32_t blockX,
+                            uint32_t blockY) const;
+    uint32_t _getView(uint32_t x) const;
+    uint32_t _getStride(uint32_t x, uint32_t y) const;
+    bool _isTraced(uint32_t x, uint32_t y) const;
+
+    Vector2ui _frameSize;
+    std::vector<uint8_t> _strides;
+    uint32_t _numViews{1};
+    uint32_t _viewWidth{0};
+    uint32_t _numBlocksX{0};
+    Vector4fs _colors;
+    floats _depths;
+};
+}
@@ -48,7 +48,7 @@ void OSPRayCamera::commit()
     ospSet3f(_camera, "dir", dir.x(), dir.y(), dir.z());
     ospSet3f(_camera, "up", up.x(), up.y(), up.z());
 
-    setOSPRayProperties(*this, _camera);
+    setOSPRayProperties(*this, _camera, cameraChanged);
 
     // Clip planes
     if (!_clipPlanes.empty())
@@ -81,7 +81,7 @@ void OSPRayCamera::setClipPlanes(const ClipPlanes& clipPlanes)
 
 bool OSPRayCamera::isSideBySideStereo() const
 {
-    return hasProperty("stereoMode") && getProperty<int>("stereoMode") == 3;
+    return hasProperty(_stereoMode) && getProperty<int>(_stereoMode) == 3;
 }
 
 void OSPRayCamera::createOSPCamera()
@@ -65,6 +65,7 @@ private:
     OSPCamera _camera{nullptr};
     std::string _currentOSPCamera;
     ClipPlanes _clipPlanes;
+    PropertyHandle _stereoMode{"stereoMode"};
 };
 }
 #endif // OSPRAYCAMERA_H
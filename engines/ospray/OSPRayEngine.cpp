@@ -42,6 +42,7 @@ OSPRayEngine::OSPRayEngine(ParametersManager& parametersManager)
     : Engine(parametersManager)
 {
     BRAYNS_INFO << "Initializing OSPRay" << std::endl;
+    _initializationTimings.start("ospInit");
     auto& ap = _parametersManager.getApplicationParameters();
     try
     {
@@ -75,6 +76,7 @@ OSPRayEngine::OSPRayEngine(ParametersManager& parametersManager)
         BRAYNS_ERROR << "Error during ospInit(): " << e.what() << std::endl;
     }
 
+    _initializationTimings.start("OSPRay modules");
     for (const auto& module : ap.getOsprayModules())
     {
         try
@@ -107,12 +109,14 @@ OSPRayEngine::OSPRayEngine(ParametersManager& parametersManager)
 
     RenderingParameters& rp = _parametersManager.getRenderingParameters();
     BRAYNS_INFO << "Initializing renderers" << std::endl;
+    _initializationTimings.start("Renderers");
 
     _createRenderers();
 
     const auto ospFlags = _getOSPDataFlags();
 
     BRAYNS_INFO << "Initializing scene" << std::endl;
+    _initializationTimings.start("Scene, camera and frame buffer");
     _scene = std::make_shared<OSPRayScene>(_parametersManager, ospFlags);
 
     BRAYNS_INFO << "Initializing camera" << std::endl;
@@ -138,6 +142,7 @@ OSPRayEngine::OSPRayEngine(ParametersManager& parametersManager)
     _renderer->setScene(_scene);
     _renderer->setCamera(_camera);
 
+    _initializationTimings.stop();
     BRAYNS_INFO << "Engine initialization complete" << std::endl;
 }
 
@@ -198,6 +203,10 @@ void OSPRayEngine::preRender()
     const auto& renderParams = _parametersManager.getRenderingParameters();
     if (renderParams.getAccumulation() != _frameBuffer->getAccumulation())
         _frameBuffer->setAccumulation(renderParams.getAccumulation());
+
+    auto osprayFrameBuffer =
+        std::static_pointer_cast<OSPRayFrameBuffer>(_frameBuffer);
+    osprayFrameBuffer->setKeepHistory(renderParams.getTemporalReprojection());
 }
 
 Vector2ui OSPRayEngine::getSupportedFrameSize(const Vector2ui& size) const
@@ -407,6 +416,11 @@ void OSPRayEngine::_createCameras()
             properties.setProperty(
                 {"zeroParallaxPlane", "Zero parallax plane", 1.});
         }
+        if (camera == "cylindricStereo")
+        {
+            properties.setProperty(stereoProperty);
+            properties.setProperty(eyeSeparation);
+        }
         ospCamera->setProperties(camera, properties);
     }
     ospCamera->setCurrentType(rp.getCameraType());
@@ -24,6 +24,8 @@
 #include <brayns/parameters/StreamParameters.h>
 #include <ospray/SDK/common/OSPCommon.h>
 
+#include <algorithm>
+
 namespace brayns
 {
 OSPRayFrameBuffer::OSPRayFrameBuffer(const Vector2ui& frameSize,
@@ -119,11 +121,18 @@ void OSPRayFrameBuffer::_recreate()
     if (_pixelOp)
         ospSetPixelOp(_frameBuffer, _pixelOp);
     ospCommit(_frameBuffer);
+
+    // nothing to keep from the new frame buffer
+    FrameBuffer::clear();
     clear();
 }
 
 void OSPRayFrameBuffer::clear()
 {
+    _historyFrames = 0;
+    if (_keepHistory && numAccumFrames() > 0)
+        _saveHistory();
+
     FrameBuffer::clear();
     size_t attributes = OSP_FB_COLOR | OSP_FB_DEPTH;
     if (_accumulation)
@@ -131,6 +140,42 @@ void OSPRayFrameBuffer::clear()
     ospFrameBufferClear(_frameBuffer, attributes);
 }
 
+void OSPRayFrameBuffer::_saveHistory()
+{
+    if (_frameBufferFormat == FrameBufferFormat::none)
+        return;
+
+    const size_t size = _frameSize.product();
+    _historyColors.resize(size);
+    _historyDepths.resize(size);
+
+    auto colors = ospMapFrameBuffer(_frameBuffer, OSP_FB_COLOR);
+    if (_frameBufferFormat == FrameBufferFormat::rgba_i8)
+    {
+        auto bytes = static_cast<const uint8_t*>(colors);
+        for (size_t i = 0; i < size; ++i)
+            _historyColors[i] =
+                Vector4f(bytes[4 * i], bytes[4 * i + 1], bytes[4 * i + 2],
+                         bytes[4 * i + 3]) /
+                255.f;
+    }
+    else
+    {
+        auto floats = static_cast<const float*>(colors);
+        for (size_t i = 0; i < size; ++i)
+            _historyColors[i] = Vector4f(floats[4 * i], floats[4 * i + 1],
+                                         floats[4 * i + 2], floats[4 * i + 3]);
+    }
+    ospUnmapFrameBuffer(colors, _frameBuffer);
+
+    auto depths = static_cast<const float*>(
+        ospMapFrameBuffer(_frameBuffer, OSP_FB_DEPTH));
+    std::copy(depths, depths + size, _historyDepths.begin());
+    ospUnmapFrameBuffer(depths, _frameBuffer);
+
+    _historyFrames = numAccumFrames();
+}
+
 void OSPRayFrameBuffer::map()
 {
     _mapMutex.lock();
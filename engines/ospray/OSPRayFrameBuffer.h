@@ -51,16 +51,34 @@ public:
     void enableDeflectPixelOp();
     void setStreamingParams(const StreamParameters& params, bool stereo);
 
+    /** Keep the accumulated frame on clear(), for temporal reprojection */
+    void setKeepHistory(const bool keepHistory) { _keepHistory = keepHistory; }
+    /** @return the RGBA colors accumulated before the last clear() */
+    const Vector4fs& getHistoryColors() const { return _historyColors; }
+    /** @return the depths of the frame before the last clear() */
+    const floats& getHistoryDepths() const { return _historyDepths; }
+    /**
+     * @return the number of frames accumulated before the last clear(), 0 if
+     *         there is no history
+     */
+    size_t getHistoryFrames() const { return _historyFrames; }
+
 private:
     void _recreate();
     void _unmapUnsafe();
     void _mapUnsafe();
+    void _saveHistory();
 
     OSPFrameBuffer _frameBuffer;
     uint8_t* _colorBuffer;
     float* _depthBuffer;
     OSPPixelOp _pixelOp{nullptr};
 
+    bool _keepHistory{false};
+    Vector4fs _historyColors;
+    floats _historyDepths;
+    size_t _historyFrames{0};
+
     // protect map/unmap vs ospRenderFrame
     std::mutex _mapMutex;
 };
@@ -58,33 +58,58 @@ void OSPRayMaterial::commit()
     if (!isModified())
         return;
 
-    ospSet3f(_ospMaterial, "kd", _diffuseColor.x(), _diffuseColor.y(),
-             _diffuseColor.z());
-    ospSet3f(_ospMaterial, "ks", _specularColor.x(), _specularColor.y(),
-             _specularColor.z());
-    ospSet1f(_ospMaterial, "ns", _specularExponent);
-    ospSet1f(_ospMaterial, "d", _opacity);
-    ospSet1f(_ospMaterial, "refraction", _refractionIndex);
-    ospSet1f(_ospMaterial, "reflection", _reflectionIndex);
-    ospSet1f(_ospMaterial, "a", _emission);
-    ospSet1f(_ospMaterial, "glossiness", _glossiness);
-    ospSet1i(_ospMaterial, "cast_simulation_data", _castSimulationData);
-
-    // Textures
-    for (const auto& textureType : textureTypeMaterialAttribute)
-        ospSetObject(_ospMaterial, textureType.attribute.c_str(), nullptr);
-
-    for (const auto& textureDescriptor : _textureDescriptors)
+    // Only pass on the values that changed since the last commit, the ospray
+    // material keeps the others.
+    const bool all = !_committed;
+    if (all)
+        _committed.reset(new CommittedValues);
+    auto& committed = *_committed;
+    const auto changed = [all](const auto& value, auto& committedValue) {
+        if (!all && value == committedValue)
+            return false;
+        committedValue = value;
+        return true;
+    };
+
+    if (changed(_diffuseColor, committed.diffuseColor))
+        ospSet3f(_ospMaterial, "kd", _diffuseColor.x(), _diffuseColor.y(),
+                 _diffuseColor.z());
+    if (changed(_specularColor, committed.specularColor))
+        ospSet3f(_ospMaterial, "ks", _specularColor.x(), _specularColor.y(),
+                 _specularColor.z());
+    if (changed(_specularExponent, committed.specularExponent))
+        ospSet1f(_ospMaterial, "ns", _specularExponent);
+    if (changed(_opacity, committed.opacity))
+        ospSet1f(_ospMaterial, "d", _opacity);
+    if (changed(_refractionIndex, committed.refractionIndex))
+        ospSet1f(_ospMaterial, "refraction", _refractionIndex);
+    if (changed(_reflectionIndex, committed.reflectionIndex))
+        ospSet1f(_ospMaterial, "reflection", _reflectionIndex);
+    if (changed(_emission, committed.emission))
+        ospSet1f(_ospMaterial, "a", _emission);
+    if (changed(_glossiness, committed.glossiness))
+        ospSet1f(_ospMaterial, "glossiness", _glossiness);
+    if (changed(_castSimulationData, committed.castSimulationData))
+        ospSet1i(_ospMaterial, "cast_simulation_data", _castSimulationData);
+
+    // Textures, only created again if other textures were assigned
+    if (changed(_textureDescriptors, committed.textureDescriptors))
     {
-        const auto texType = textureDescriptor.first;
-        auto texture = getTexture(texType);
-        if (texture)
+        for (const auto& textureType : textureTypeMaterialAttribute)
+            ospSetObject(_ospMaterial, textureType.attribute.c_str(), nullptr);
+
+        for (const auto& textureDescriptor : _textureDescriptors)
         {
-            auto ospTexture = _createOSPTexture2D(texture);
-            const auto str =
-                textureTypeMaterialAttribute[texType].attribute.c_str();
-            ospSetObject(_ospMaterial, str, ospTexture);
-            ospRelease(ospTexture);
+            const auto texType = textureDescriptor.first;
+            auto texture = getTexture(texType);
+            if (texture)
+            {
+                auto ospTexture = _createOSPTexture2D(texture);
+                const auto str =
+                    textureTypeMaterialAttribute[texType].attribute.c_str();
+                ospSetObject(_ospMaterial, str, ospTexture);
+                ospRelease(ospTexture);
+            }
         }
     }
 
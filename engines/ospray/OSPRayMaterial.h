@@ -24,6 +24,8 @@
 #include <brayns/common/material/Material.h>
 #include <ospray.h>
 
+#include <memory>
+
 namespace brayns
 {
 class OSPRayMaterial : public Material
@@ -38,6 +40,22 @@ public:
 private:
     OSPTexture2D _createOSPTexture2D(Texture2DPtr texture);
     OSPMaterial _ospMaterial;
+
+    /** Values last passed to _ospMaterial, nullptr until the first commit */
+    struct CommittedValues
+    {
+        Vector3d diffuseColor;
+        Vector3d specularColor;
+        double specularExponent;
+        double reflectionIndex;
+        double opacity;
+        double refractionIndex;
+        double emission;
+        double glossiness;
+        bool castSimulationData;
+        TextureDescriptors textureDescriptors;
+    };
+    std::unique_ptr<CommittedValues> _committed;
 };
 }
 
@@ -28,8 +28,8 @@
 
 namespace
 {
-template <typename VecT>
-OSPData allocateVectorData(const std::vector<VecT>& vec,
+template <typename VecT, typename AllocT>
+OSPData allocateVectorData(const std::vector<VecT, AllocT>& vec,
                            const OSPDataType ospType,
                            const size_t memoryManagementFlags)
 {
@@ -74,7 +74,11 @@ OSPRayModel::~OSPRayModel()
     releaseModel(_simulationModel);
     releaseModel(_boundingBoxModel);
     releaseModel(_ospSDFGeometryData);
+    releaseModel(_ospSDFSpheresData);
+    releaseModel(_ospSDFPillsData);
+    releaseModel(_ospSDFConePillsData);
     releaseModel(_ospSDFNeighboursData);
+    releaseModel(_ospCellMaskData);
     releaseModel(_model);
 }
 
@@ -128,6 +132,67 @@ void OSPRayModel::buildBoundingBox()
     ospCommit(_boundingBoxModel);
 }
 
+void OSPRayModel::commitCellMask()
+{
+    const auto& mask = _cellMask.getData();
+    const bool sharedBuffer = _memoryManagementFlags & OSP_DATA_SHARED_BUFFER;
+
+    // The geometry needs to be committed again if the mask buffer was
+    // reallocated, or if OSPRay holds a copy of it
+    if (mask.data() != _cellMaskPtr ||
+        (!sharedBuffer && _cellMask.isModified()))
+    {
+        if (_ospCellMaskData)
+            ospRelease(_ospCellMaskData);
+        _ospCellMaskData = nullptr;
+        if (!mask.empty())
+        {
+            _ospCellMaskData =
+                allocateVectorData(mask, OSP_UCHAR, _memoryManagementFlags);
+            ospCommit(_ospCellMaskData);
+        }
+        _cellMaskPtr = mask.data();
+
+        _spheresDirty = _spheresDirty || !_cellTags.spheres.empty();
+        _cylindersDirty = _cylindersDirty || !_cellTags.cylinders.empty();
+        _conesDirty = _conesDirty || !_cellTags.cones.empty();
+        _sdfGeometriesDirty =
+            _sdfGeometriesDirty || !_cellTags.sdfGeometries.empty();
+    }
+    _cellMask.resetModified();
+}
+
+OSPData OSPRayModel::_createCellTagsData(uint32_ts& cellTags,
+                                         const size_t nbPrimitives)
+{
+    if (!_ospCellMaskData || cellTags.empty())
+        return nullptr;
+
+    // Primitives added without tags are never masked
+    cellTags.resize(nbPrimitives, CELL_TAG_NONE);
+    return allocateVectorData(cellTags, OSP_UINT, _memoryManagementFlags);
+}
+
+void OSPRayModel::_setCellMask(OSPGeometry geometry, OSPData cellTags)
+{
+    if (!cellTags)
+        return;
+
+    ospSetData(geometry, "cell_tags", cellTags);
+    ospSetData(geometry, "cell_mask", _ospCellMaskData);
+}
+
+void OSPRayModel::_setCellMask(OSPGeometry geometry, uint32_ts& cellTags,
+                               const size_t nbPrimitives)
+{
+    OSPData tags = _createCellTagsData(cellTags, nbPrimitives);
+    if (!tags)
+        return;
+
+    _setCellMask(geometry, tags);
+    ospRelease(tags);
+}
+
 void OSPRayModel::_commitSpheres(const size_t materialId)
 {
     const auto& spheres = _spheres[materialId];
@@ -149,6 +214,8 @@ void OSPRayModel::_commitSpheres(const size_t materialId)
     auto impl =
         std::static_pointer_cast<OSPRayMaterial>(_materials[materialId]);
     ospSetMaterial(_ospExtendedSpheres[materialId], impl->getOSPMaterial());
+    _setCellMask(_ospExtendedSpheres[materialId], _cellTags.spheres[materialId],
+                 spheres.size());
     ospCommit(_ospExtendedSpheres[materialId]);
 
     if (_useSimulationModel)
@@ -178,6 +245,8 @@ void OSPRayModel::_commitCylinders(const size_t materialId)
     auto impl =
         std::static_pointer_cast<OSPRayMaterial>(_materials[materialId]);
     ospSetMaterial(_ospExtendedCylinders[materialId], impl->getOSPMaterial());
+    _setCellMask(_ospExtendedCylinders[materialId],
+                 _cellTags.cylinders[materialId], cylinders.size());
 
     ospCommit(_ospExtendedCylinders[materialId]);
 
@@ -209,6 +278,8 @@ void OSPRayModel::_commitCones(const size_t materialId)
     auto impl =
         std::static_pointer_cast<OSPRayMaterial>(_materials[materialId]);
     ospSetMaterial(_ospExtendedCones[materialId], impl->getOSPMaterial());
+    _setCellMask(_ospExtendedCones[materialId], _cellTags.cones[materialId],
+                 cones.size());
     ospCommit(_ospExtendedCones[materialId]);
 
     if (_useSimulationModel)
@@ -278,6 +349,12 @@ void OSPRayModel::_commitMeshes(const size_t materialId)
 
 void OSPRayModel::_commitStreamlines(const size_t materialId)
 {
+    if (_ospStreamlines.find(materialId) != _ospStreamlines.end())
+    {
+        ospRemoveGeometry(_model, _ospStreamlines[materialId]);
+        ospRelease(_ospStreamlines[materialId]);
+    }
+
     auto streamlineGeometry = ospNewGeometry("streamlines");
     auto& streamlinesData = _streamlines[materialId];
 
@@ -315,42 +392,48 @@ void OSPRayModel::_commitStreamlines(const size_t materialId)
 
 void OSPRayModel::_commitSDFGeometries()
 {
-    assert(_ospSDFGeometryData == nullptr);
-    assert(_ospSDFNeighboursData == nullptr);
-
-    if (_ospSDFGeometryData)
-        ospRelease(_ospSDFGeometryData);
-    _ospSDFGeometryData =
-        allocateVectorData(_sdf.geometries, OSP_CHAR, _memoryManagementFlags);
-    ospCommit(_ospSDFGeometryData);
-
-    // Create and upload flat list of neighbours
-    const size_t numGeoms = _sdf.geometries.size();
-    _sdf.neighboursFlat.clear();
-
-    for (size_t geomI = 0; geomI < numGeoms; geomI++)
+    // the geometries of the materials left without SDF geometries, e.g. after
+    // clearSDFGeometries(), are removed
+    for (auto i = _ospSDFGeometryRefs.begin(); i != _ospSDFGeometryRefs.end();)
     {
-        const size_t currOffset = _sdf.neighboursFlat.size();
-        const auto& neighsI = _sdf.neighbours[geomI];
-        if (!neighsI.empty())
+        if (_sdf.geometryIndices.count(i->first))
+        {
+            ++i;
+            continue;
+        }
+        ospRemoveGeometry(_model, i->second);
+        ospRemoveGeometry(_simulationModel, i->second);
+        ospRelease(i->second);
+        const auto data = _ospSDFGeometryRefsData.find(i->first);
+        if (data != _ospSDFGeometryRefsData.end())
         {
-            _sdf.geometries[geomI].numNeighbours = neighsI.size();
-            _sdf.geometries[geomI].neighboursIndex = currOffset;
-            _sdf.neighboursFlat.insert(std::end(_sdf.neighboursFlat),
-                                       std::begin(neighsI), std::end(neighsI));
+            ospRelease(data->second);
+            _ospSDFGeometryRefsData.erase(data);
         }
+        i = _ospSDFGeometryRefs.erase(i);
     }
 
-    // Make sure we don't create an empty buffer in the case of no neighbours
-    if (_sdf.neighboursFlat.empty())
-        _sdf.neighboursFlat.resize(1, 0);
-
-    if (_ospSDFNeighboursData)
-        ospRelease(_ospSDFNeighboursData);
-    _ospSDFNeighboursData = allocateVectorData(_sdf.neighboursFlat, OSP_ULONG,
-                                               _memoryManagementFlags);
+    // The types and the neighbours that are not used are not set
+    const auto setData = [this](OSPData& data, const auto& vector,
+                                const OSPDataType type) {
+        if (data)
+            ospRelease(data);
+        data = nullptr;
+        if (vector.empty())
+            return;
+        data = allocateVectorData(vector, type, _memoryManagementFlags);
+        ospCommit(data);
+    };
+    setData(_ospSDFGeometryData, _sdf.geometries, OSP_CHAR);
+    setData(_ospSDFSpheresData, _sdf.spheres, OSP_CHAR);
+    setData(_ospSDFPillsData, _sdf.pills, OSP_CHAR);
+    setData(_ospSDFConePillsData, _sdf.conePills, OSP_CHAR);
+    setData(_ospSDFNeighboursData, _sdf.neighbours, OSP_UINT);
 
-    ospCommit(_ospSDFNeighboursData);
+    // The tags index the global geometry array, they are shared by the
+    // geometries of all materials
+    OSPData cellTags =
+        _createCellTagsData(_cellTags.sdfGeometries, _sdf.geometries.size());
 
     for (const auto& mat : _materials)
     {
@@ -373,17 +456,23 @@ void OSPRayModel::_commitSDFGeometries()
         if (_ospSDFGeometryRefsData[materialId])
             ospRelease(_ospSDFGeometryRefsData[materialId]);
         _ospSDFGeometryRefsData[materialId] =
-            allocateVectorData(_sdf.geometryIndices[materialId], OSP_ULONG,
+            allocateVectorData(_sdf.geometryIndices[materialId], OSP_UINT,
                                _memoryManagementFlags);
 
         ospSetObject(_ospSDFGeometryRefs[materialId], "extendedsdfgeometries",
                      _ospSDFGeometryRefsData[materialId]);
 
+        ospSetData(_ospSDFGeometryRefs[materialId], "geometries",
+                   _ospSDFGeometryData);
+        ospSetData(_ospSDFGeometryRefs[materialId], "spheres",
+                   _ospSDFSpheresData);
+        ospSetData(_ospSDFGeometryRefs[materialId], "pills", _ospSDFPillsData);
+        ospSetData(_ospSDFGeometryRefs[materialId], "cone_pills",
+                   _ospSDFConePillsData);
         ospSetData(_ospSDFGeometryRefs[materialId], "neighbours",
                    _ospSDFNeighboursData);
 
-        ospSetData(_ospSDFGeometryRefs[materialId], "geometries",
-                   _ospSDFGeometryData);
+        _setCellMask(_ospSDFGeometryRefs[materialId], cellTags);
 
         if (_materials[materialId] != nullptr)
         {
@@ -401,6 +490,9 @@ void OSPRayModel::_commitSDFGeometries()
         else
             ospAddGeometry(_model, _ospSDFGeometryRefs[materialId]);
     }
+
+    if (cellTags)
+        ospRelease(cellTags);
 }
 
 void OSPRayModel::commit()
@@ -411,6 +503,8 @@ void OSPRayModel::commit()
         ospVolume->commit();
     }
 
+    commitCellMask();
+
     if (!dirty())
         return;
 
@@ -473,6 +567,7 @@ void OSPRayModel::commit()
 MaterialPtr OSPRayModel::createMaterial(const size_t materialId,
                                         const std::string& name)
 {
+    std::lock_guard<std::mutex> lock(getObjectCreationMutex());
     MaterialPtr material = std::make_shared<OSPRayMaterial>();
     material->setName(name);
     _materials[materialId] = material;
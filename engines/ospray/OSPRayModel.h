@@ -46,7 +46,19 @@ public:
 
     void buildBoundingBox() final;
 
+    /**
+     * Makes the cell mask available to the geometry. With shared memory, the
+     * mask is read in place by the intersection kernels and updates do not
+     * require any geometry commit.
+     */
+    void commitCellMask();
+
 private:
+    OSPData _createCellTagsData(uint32_ts& cellTags,
+                                const size_t nbPrimitives);
+    void _setCellMask(OSPGeometry geometry, OSPData cellTags);
+    void _setCellMask(OSPGeometry geometry, uint32_ts& cellTags,
+                      const size_t nbPrimitives);
     void _commitSpheres(const size_t materialId);
     void _commitCylinders(const size_t materialId);
     void _commitCones(const size_t materialId);
@@ -76,8 +88,14 @@ private:
     std::map<size_t, OSPGeometry> _ospSDFGeometryRefs;
     std::map<size_t, OSPData> _ospSDFGeometryRefsData;
     OSPData _ospSDFGeometryData = nullptr;
+    OSPData _ospSDFSpheresData = nullptr;
+    OSPData _ospSDFPillsData = nullptr;
+    OSPData _ospSDFConePillsData = nullptr;
     OSPData _ospSDFNeighboursData = nullptr;
 
+    OSPData _ospCellMaskData{nullptr};
+    const uint8_t* _cellMaskPtr{nullptr};
+
     size_t _memoryManagementFlags{OSP_DATA_SHARED_BUFFER};
 };
 }
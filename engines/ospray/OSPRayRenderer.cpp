@@ -25,10 +25,20 @@
 #include "OSPRayMaterial.h"
 #include "OSPRayRenderer.h"
 #include "OSPRayScene.h"
+#include "StereoReprojection.h"
 #include "utils.h"
 
 namespace brayns
 {
+namespace
+{
+// Matches the modes in ispc/render/utils/AbstractRenderer.ih
+const int REPROJECTION_NONE = 0;
+const int REPROJECTION_LEFT_EYE = 1;
+const int REPROJECTION_RIGHT_EYE = 2;
+const int REPROJECTION_FRAME = 3;
+}
+
 OSPRayRenderer::OSPRayRenderer(const AnimationParameters& animationParameters,
                                const RenderingParameters& renderingParameters)
     : Renderer(animationParameters, renderingParameters)
@@ -37,6 +47,8 @@ OSPRayRenderer::OSPRayRenderer(const AnimationParameters& animationParameters,
 
 OSPRayRenderer::~OSPRayRenderer()
 {
+    if (_firstPassFrameBuffer)
+        ospRelease(_firstPassFrameBuffer);
     ospRelease(_renderer);
 }
 
@@ -46,9 +58,36 @@ void OSPRayRenderer::render(FrameBufferPtr frameBuffer)
         std::static_pointer_cast<OSPRayFrameBuffer>(frameBuffer);
     auto lock = osprayFrameBuffer->getScopeLock();
 
+    // Only the first frame is reprojected or sampled, the following ones trace
+    // all the pixels to converge to the exact image
+    const bool firstFrame = osprayFrameBuffer->numAccumFrames() == 0;
+    const bool reprojectStereo = _renderingParameters.getStereoReprojection() &&
+                                 firstFrame && _canReprojectStereo();
+    const bool foveate = _renderingParameters.getFoveatedRendering() &&
+                         firstFrame && !reprojectStereo;
+    if (reprojectStereo)
+        _reprojectLeftEye(osprayFrameBuffer->getSize());
+    else
+        _reprojectHistory(*osprayFrameBuffer);
+    if (foveate)
+        _sampleFoveated(osprayFrameBuffer->getSize());
+
     _variance = ospRenderFrame(osprayFrameBuffer->impl(), _renderer,
                                OSP_FB_COLOR | OSP_FB_DEPTH | OSP_FB_ACCUM);
 
+    if (reprojectStereo || foveate)
+    {
+        ospSet1i(_renderer, "reprojectionMode", REPROJECTION_NONE);
+        ospRemoveParam(_renderer, "reprojectionColors");
+        ospRemoveParam(_renderer, "reprojectionDepths");
+        ospCommit(_renderer);
+    }
+
+    // the camera of the frames accumulated from now on
+    _historyCameraValid = _canReprojectHistory();
+    if (_historyCameraValid)
+        _historyCamera = _getHistoryCamera();
+
     osprayFrameBuffer->incrementAccumFrames();
     osprayFrameBuffer->markModified();
 }
@@ -64,11 +103,18 @@ void OSPRayRenderer::commit()
         return;
     }
 
+    // only the accumulation of camera moves can be reprojected
+    if (ap.isModified() || rp.isModified() || _scene->isModified() ||
+        isModified())
+    {
+        _discardHistory = true;
+    }
+
     const bool rendererChanged = _currentOSPRenderer != getCurrentType();
     if (rendererChanged)
         createOSPRenderer();
 
-    setOSPRayProperties(*this, _renderer);
+    setOSPRayProperties(*this, _renderer, rendererChanged);
 
     auto scene = std::static_pointer_cast<OSPRayScene>(_scene);
     if (isModified() || rendererChanged || _scene->isModified())
@@ -157,6 +203,205 @@ Renderer::PickResult OSPRayRenderer::pick(const Vector2f& pickPos)
     return result;
 }
 
+bool OSPRayRenderer::_canReprojectStereo() const
+{
+    const auto& type = _camera->getCurrentType();
+    return _camera->isSideBySideStereo() &&
+           (type == "stereoFull" || type == "cylindricStereo");
+}
+
+void OSPRayRenderer::_renderFirstPass(const Vector2ui& frameSize)
+{
+    if (!_firstPassFrameBuffer || _firstPassFrameBufferSize != frameSize)
+    {
+        if (_firstPassFrameBuffer)
+            ospRelease(_firstPassFrameBuffer);
+        _firstPassFrameBuffer =
+            ospNewFrameBuffer({int(frameSize.x()), int(frameSize.y())},
+                              OSP_FB_RGBA32F, OSP_FB_COLOR | OSP_FB_DEPTH);
+        _firstPassFrameBufferSize = frameSize;
+    }
+
+    ospFrameBufferClear(_firstPassFrameBuffer, OSP_FB_COLOR | OSP_FB_DEPTH);
+    ospRenderFrame(_firstPassFrameBuffer, _renderer,
+                   OSP_FB_COLOR | OSP_FB_DEPTH);
+}
+
+void OSPRayRenderer::_setReprojection(const int mode, const size_t width,
+                                      const Vector4fs& colors,
+                                      const floats& depths)
+{
+    auto colorData = ospNewData(colors.size(), OSP_FLOAT4, colors.data(),
+                                OSP_DATA_SHARED_BUFFER);
+    auto depthData = ospNewData(depths.size(), OSP_FLOAT, depths.data(),
+                                OSP_DATA_SHARED_BUFFER);
+    ospSetData(_renderer, "reprojectionColors", colorData);
+    ospSetData(_renderer, "reprojectionDepths", depthData);
+    ospRelease(colorData);
+    ospRelease(depthData);
+    ospSet1i(_renderer, "reprojectionMode", mode);
+    ospSet1i(_renderer, "reprojectionWidth", width);
+    ospCommit(_renderer);
+}
+
+void OSPRayRenderer::_reprojectLeftEye(const Vector2ui& frameSize)
+{
+    ospSet1i(_renderer, "reprojectionMode", REPROJECTION_LEFT_EYE);
+    ospSet1i(_renderer, "reprojectionWidth", frameSize.x());
+    ospCommit(_renderer);
+    _renderFirstPass(frameSize);
+
+    StereoReprojection::Camera camera;
+    const auto& type = _camera->getCurrentType();
+    camera.projection = type == "stereoFull"
+                            ? StereoReprojection::Projection::planar
+                            : StereoReprojection::Projection::cylindric;
+    camera.position = Vector3f(_camera->getPosition());
+    camera.direction =
+        Vector3f(_camera->getTarget() - _camera->getPosition());
+    camera.up = Vector3f(_camera->getUp());
+    camera.interpupillaryDistance =
+        _camera->getProperty<double>(_interpupillaryDistance);
+    if (camera.projection == StereoReprojection::Projection::planar)
+    {
+        camera.fovy = _camera->getProperty<double>(_fovy);
+        camera.aspect = _camera->getProperty<double>(_aspect);
+        camera.zeroParallaxPlane =
+            _camera->getProperty<double>(_zeroParallaxPlane);
+    }
+
+    auto colors = static_cast<const float*>(
+        ospMapFrameBuffer(_firstPassFrameBuffer, OSP_FB_COLOR));
+    auto depths = static_cast<const float*>(
+        ospMapFrameBuffer(_firstPassFrameBuffer, OSP_FB_DEPTH));
+    _stereoReprojection.reproject(camera, frameSize, colors, depths);
+    ospUnmapFrameBuffer(depths, _firstPassFrameBuffer);
+    ospUnmapFrameBuffer(colors, _firstPassFrameBuffer);
+
+    BRAYNS_DEBUG << "Stereo reprojection traces "
+                 << _stereoReprojection.getNumPixelsToTrace() << " of "
+                 << frameSize.x() / 2 * frameSize.y()
+                 << " pixels of the right eye" << std::endl;
+
+    _setReprojection(REPROJECTION_RIGHT_EYE, frameSize.x(),
+                     _stereoReprojection.getColors(),
+                     _stereoReprojection.getDepths());
+}
+
+void OSPRayRenderer::_sampleFoveated(const Vector2ui& frameSize)
+{
+    const auto& rp = _renderingParameters;
+    FoveatedSampling::Parameters parameters;
+    parameters.focus = Vector2f(rp.getFoveationFocus());
+    parameters.innerRadius = rp.getFoveationRadii().x();
+    parameters.outerRadius = rp.getFoveationRadii().y();
+    parameters.peripheralDensity = rp.getFoveationPeripheralDensity();
+    // each eye of a side by side stereo frame is foveated on its own focus
+    parameters.numViews = _camera->isSideBySideStereo() ? 2 : 1;
+    const auto numPixelsToTrace =
+        _foveatedSampling.sample(parameters, frameSize);
+
+    BRAYNS_DEBUG << "Foveated sampling traces " << numPixelsToTrace << " of "
+                 << frameSize.product() << " pixels" << std::endl;
+
+    // the data shares the buffers of the sampling, which are filled with the
+    // interpolated frame in place for the second pass
+    _setReprojection(REPROJECTION_FRAME, frameSize.x(),
+                     _foveatedSampling.getColors(),
+                     _foveatedSampling.getDepths());
+    _renderFirstPass(frameSize);
+
+    auto colors = static_cast<const float*>(
+        ospMapFrameBuffer(_firstPassFrameBuffer, OSP_FB_COLOR));
+    auto depths = static_cast<const float*>(
+        ospMapFrameBuffer(_firstPassFrameBuffer, OSP_FB_DEPTH));
+    _foveatedSampling.interpolate(colors, depths);
+    ospUnmapFrameBuffer(depths, _firstPassFrameBuffer);
+    ospUnmapFrameBuffer(colors, _firstPassFrameBuffer);
+}
+
+bool OSPRayRenderer::_canReprojectHistory() const
+{
+    const auto& type = _camera->getCurrentType();
+    if (type != "perspective" && type != "clippedperspective")
+        return false;
+    if (_camera->getProperty<int>(_stereoMode) != 0)
+        return false;
+    return _camera->getProperty<double>(_apertureRadius) == 0.;
+}
+
+TemporalReprojection::Camera OSPRayRenderer::_getHistoryCamera() const
+{
+    TemporalReprojection::Camera camera;
+    camera.position = Vector3f(_camera->getPosition());
+    camera.direction =
+        Vector3f(_camera->getTarget() - _camera->getPosition());
+    camera.up = Vector3f(_camera->getUp());
+    camera.fovy = _camera->getProperty<double>(_fovy);
+    camera.aspect = _camera->getProperty<double>(_aspect);
+    return camera;
+}
+
+void OSPRayRenderer::_reprojectHistory(const OSPRayFrameBuffer& frameBuffer)
+{
+    const auto frame = frameBuffer.numAccumFrames();
+    if (frame == 0)
+    {
+        const auto& colors = frameBuffer.getHistoryColors();
+        const bool reproject =
+            _renderingParameters.getTemporalReprojection() &&
+            _renderingParameters.getAccumulation() && !_discardHistory &&
+            _historyCameraValid && _canReprojectHistory() &&
+            frameBuffer.getHistoryFrames() > 0 &&
+            colors.size() == frameBuffer.getSize().product();
+        _discardHistory = false;
+
+        if (reproject)
+        {
+            _temporalReprojection.reproject(_historyCamera,
+                                            _getHistoryCamera(),
+                                            frameBuffer.getSize(), colors,
+                                            frameBuffer.getHistoryDepths(),
+                                            frameBuffer.getHistoryFrames());
+
+            const auto& historyColors = _temporalReprojection.getColors();
+            const auto& historyDepths = _temporalReprojection.getDepths();
+            const auto& historyWeights = _temporalReprojection.getWeights();
+            auto colorData =
+                ospNewData(historyColors.size(), OSP_FLOAT4,
+                           historyColors.data(), OSP_DATA_SHARED_BUFFER);
+            auto depthData =
+                ospNewData(historyDepths.size(), OSP_FLOAT,
+                           historyDepths.data(), OSP_DATA_SHARED_BUFFER);
+            auto weightData =
+                ospNewData(historyWeights.size(), OSP_FLOAT,
+                           historyWeights.data(), OSP_DATA_SHARED_BUFFER);
+            ospSetData(_renderer, "historyColors", colorData);
+            ospSetData(_renderer, "historyDepths", depthData);
+            ospSetData(_renderer, "historyWeights", weightData);
+            ospRelease(colorData);
+            ospRelease(depthData);
+            ospRelease(weightData);
+            ospSet1i(_renderer, "historyWidth", frameBuffer.getSize().x());
+        }
+        else if (_temporalReprojection.isActive())
+        {
+            _temporalReprojection.reset();
+            ospRemoveParam(_renderer, "historyColors");
+            ospRemoveParam(_renderer, "historyDepths");
+            ospRemoveParam(_renderer, "historyWeights");
+            ospCommit(_renderer);
+        }
+    }
+
+    // the weight of the new samples grows with the accumulated frames
+    if (_temporalReprojection.isActive())
+    {
+        ospSet1f(_renderer, "historyFrame", frame);
+        ospCommit(_renderer);
+    }
+}
+
 void OSPRayRenderer::createOSPRenderer()
 {
     auto newRenderer = ospNewRenderer(getCurrentType().c_str());
@@ -27,6 +27,10 @@
 #include <ospray.h>
 
 #include "OSPRayCamera.h"
+#include "FoveatedSampling.h"
+#include "OSPRayFrameBuffer.h"
+#include "StereoReprojection.h"
+#include "TemporalReprojection.h"
 
 namespace brayns
 {
@@ -48,10 +52,64 @@ public:
     void createOSPRenderer();
 
 private:
+    /**
+     * Renders the color and depth of the frame without accumulation to the
+     * first pass frame buffer
+     */
+    void _renderFirstPass(const Vector2ui& frameSize);
+
+    /**
+     * Sets the colors and depths that the renderer uses instead of tracing,
+     * see AbstractRenderer_reprojectSample()
+     */
+    void _setReprojection(int mode, size_t width, const Vector4fs& colors,
+                          const floats& depths);
+
+    bool _canReprojectStereo() const;
+
+    /**
+     * Renders the left eye and sets its reprojection to the right eye for the
+     * next frame
+     */
+    void _reprojectLeftEye(const Vector2ui& frameSize);
+
+    /**
+     * Renders the pixels of the foveated sampling and sets the interpolated
+     * frame for the next frame
+     */
+    void _sampleFoveated(const Vector2ui& frameSize);
+
+    bool _canReprojectHistory() const;
+    TemporalReprojection::Camera _getHistoryCamera() const;
+
+    /**
+     * Reprojects the frame accumulated before the last camera move on the
+     * first frame, and updates the weight of the new samples on the next ones
+     */
+    void _reprojectHistory(const OSPRayFrameBuffer& frameBuffer);
+
     OSPRayCamera* _camera{nullptr};
     OSPRenderer _renderer{nullptr};
     std::atomic<float> _variance{std::numeric_limits<float>::max()};
     std::string _currentOSPRenderer;
+
+    OSPFrameBuffer _firstPassFrameBuffer{nullptr};
+    Vector2ui _firstPassFrameBufferSize;
+    StereoReprojection _stereoReprojection;
+    FoveatedSampling _foveatedSampling;
+
+    TemporalReprojection _temporalReprojection;
+    TemporalReprojection::Camera _historyCamera;
+    bool _historyCameraValid{false};
+    bool _discardHistory{false};
+
+    // camera properties read on every frame
+    PropertyHandle _fovy{"fovy"};
+    PropertyHandle _aspect{"aspect"};
+    PropertyHandle _apertureRadius{"apertureRadius"};
+    PropertyHandle _stereoMode{"stereoMode"};
+    PropertyHandle _interpupillaryDistance{"interpupillaryDistance"};
+    PropertyHandle _zeroParallaxPlane{"zeroParallaxPlane"};
 };
 }
 
@@ -31,6 +31,7 @@
 #include <brayns/common/log.h>
 #include <brayns/common/scene/Model.h>
 #include <brayns/common/simulation/AbstractSimulationHandler.h>
+#include <brayns/common/utils/Utils.h>
 
 #include <brayns/parameters/GeometryParameters.h>
 #include <brayns/parameters/ParametersManager.h>
@@ -38,6 +39,8 @@
 
 #include <boost/algorithm/string/predicate.hpp> // ends_with
 
+#include <algorithm>
+
 namespace brayns
 {
 OSPRayScene::OSPRayScene(ParametersManager& parametersManager,
@@ -80,7 +83,7 @@ void OSPRayScene::commit()
     const bool rebuildScene = isModified();
     const bool addRemoveVolumes = _commitVolumeData();
 
-    _commitSimulationData();
+    const float* frameData = _commitSimulationData();
     commitTransferFunctionData();
 
     // copy the list to avoid locking the mutex
@@ -90,6 +93,29 @@ void OSPRayScene::commit()
         modelDescriptors = _modelDescriptors;
     }
 
+    // cell masks are read in place by the geometry, they only need a
+    // framebuffer clear, not a rebuild of the scene. They are modified here by
+    // the simulation and by set-cell-visibility, both under the exclusive
+    // model lock.
+    bool cellMasksModified = false;
+    std::unique_lock<std::shared_timed_mutex> cellMaskLock(_modelMutex);
+    for (auto& modelDescriptor : modelDescriptors)
+    {
+        auto& impl = static_cast<OSPRayModel&>(modelDescriptor->getModel());
+        auto& cellMask = impl.getCellMask();
+        if (frameData)
+            cellMask.applySimulationFrame(frameData,
+                                          _simulationHandler->getFrameSize());
+        if (cellMask.isModified())
+        {
+            impl.commitCellMask();
+            cellMasksModified = true;
+        }
+    }
+    cellMaskLock.unlock();
+    if (cellMasksModified)
+        markModified(false); // triggers framebuffer clear
+
     if (!rebuildScene && !addRemoveVolumes)
     {
         // check for dirty models aka their geometry has been altered
@@ -109,12 +135,22 @@ void OSPRayScene::commit()
             return;
     }
 
+    // models removed from the scene are destroyed with the previous root model,
+    // hand their memory back to the system right away
+    std::vector<std::weak_ptr<ModelDescriptor>> previousModels(
+        _activeModels.begin(), _activeModels.end());
     _activeModels.clear();
 
     if (_rootModel)
         ospRelease(_rootModel);
     _rootModel = ospNewModel();
 
+    if (std::any_of(previousModels.begin(), previousModels.end(),
+                    [](const auto& model) { return model.expired(); }))
+    {
+        releaseUnusedMemory();
+    }
+
     if (_rootSimulationModel)
         ospRelease(_rootSimulationModel);
     _rootSimulationModel = nullptr;
@@ -332,24 +368,34 @@ bool OSPRayScene::_commitVolumeData()
     return rebuildScene;
 }
 
-void OSPRayScene::_commitSimulationData()
+const float* OSPRayScene::_commitSimulationData()
 {
     if (!_simulationHandler)
-        return;
-
-    const auto animationFrame =
-        _parametersManager.getAnimationParameters().getFrame();
-
+        return nullptr;
+
+    const auto& ap = _parametersManager.getAnimationParameters();
+    const auto animationFrame = ap.getFrame();
+    const auto interpolation = ap.getInterpolation();
+    const auto fraction = interpolation == SimulationInterpolation::none
+                              ? 0.
+                              : ap.getFrameFraction();
+
+    // the handler wraps the frame in its own frames
+    const auto position =
+        _simulationHandler->getBoundedFrame(animationFrame) + fraction;
     if (_ospSimulationData &&
-        _simulationHandler->getCurrentFrame() == animationFrame)
+        _simulationHandler->getCurrentPosition() == position &&
+        _simulationHandler->getCurrentInterpolation() == interpolation)
     {
-        return;
+        return nullptr;
     }
 
-    auto frameData = _simulationHandler->getFrameData(animationFrame);
+    auto frameData =
+        _simulationHandler->getInterpolatedFrameData(animationFrame, fraction,
+                                                     interpolation);
 
     if (!frameData)
-        return;
+        return nullptr;
 
     if (_ospSimulationData)
         ospRelease(_ospSimulationData);
@@ -359,10 +405,12 @@ void OSPRayScene::_commitSimulationData()
     ospCommit(_ospSimulationData);
 
     markModified(false); // triggers framebuffer clear
+    return static_cast<const float*>(frameData);
 }
 
 ModelPtr OSPRayScene::createModel() const
 {
+    std::lock_guard<std::mutex> lock(getObjectCreationMutex());
     return std::make_unique<OSPRayModel>();
 }
 
@@ -370,6 +418,7 @@ SharedDataVolumePtr OSPRayScene::createSharedDataVolume(
     const Vector3ui& dimensions, const Vector3f& spacing,
     const DataType type) const
 {
+    std::lock_guard<std::mutex> lock(getObjectCreationMutex());
     return std::make_shared<OSPRaySharedDataVolume>(
         dimensions, spacing, type, _parametersManager.getVolumeParameters(),
         _ospTransferFunction);
@@ -379,6 +428,7 @@ BrickedVolumePtr OSPRayScene::createBrickedVolume(const Vector3ui& dimensions,
                                                   const Vector3f& spacing,
                                                   const DataType type) const
 {
+    std::lock_guard<std::mutex> lock(getObjectCreationMutex());
     return std::make_shared<OSPRayBrickedVolume>(
         dimensions, spacing, type, _parametersManager.getVolumeParameters(),
         _ospTransferFunction);
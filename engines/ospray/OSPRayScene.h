@@ -73,7 +73,7 @@ public:
     }
 
 private:
-    void _commitSimulationData();
+    const float* _commitSimulationData();
     bool _commitVolumeData();
 
     OSPModel _rootModel{nullptr};
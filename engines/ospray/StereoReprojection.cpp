@@ -0,0 +1,277 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "StereoReprojection.h"
+
+#include <cmath>
+#include <limits>
+
+namespace brayns
+{
+namespace
+{
+const float INFINITE_DEPTH = std::numeric_limits<float>::infinity();
+
+// Vertical field of view of the cylindricStereo camera, in degrees
+const float OPENDECK_FOV_Y = 48.549f;
+
+bool isInfinite(const float depth)
+{
+    return !std::isfinite(depth) || depth >= 1e30f;
+}
+
+/** @return x solving x[0] * a + x[1] * b + x[2] * c = v */
+Vector3f solve(const Vector3f& a, const Vector3f& b, const Vector3f& c,
+               const Vector3f& v)
+{
+    const float det = dot(a, cross(b, c));
+    return Vector3f(dot(v, cross(b, c)), dot(a, cross(v, c)),
+                    dot(a, cross(b, v))) /
+           det;
+}
+
+/** Ray of a pixel of the left eye, and projection to the right eye */
+class Eyes
+{
+public:
+    explicit Eyes(const StereoReprojection::Camera& camera)
+        : _camera(camera)
+    {
+        const Vector3f dir = normalize(camera.direction);
+        _du = normalize(cross(dir, camera.up));
+        _dv = normalize(camera.up);
+        _dc = -dir;
+
+        const float toRadians = float(M_PI) / 180.f;
+        if (camera.projection == StereoReprojection::Projection::planar)
+        {
+            _sizeY = 2.f * camera.zeroParallaxPlane *
+                     std::tan(0.5f * camera.fovy * toRadians);
+            _sizeX = _sizeY * camera.aspect * 0.5f;
+        }
+        else
+            _sizeY = 2.f * std::tan(0.5f * OPENDECK_FOV_Y * toRadians);
+        _radius = 0.5f * camera.interpupillaryDistance;
+    }
+
+    /** Ray through the given screen position of the left eye */
+    void leftRay(const float sx, const float sy, Vector3f& origin,
+                 Vector3f& direction) const
+    {
+        if (_camera.projection == StereoReprojection::Projection::planar)
+        {
+            const float ox = -_radius;
+            const Vector3f local =
+                normalize(Vector3f((2.f * sx - 0.5f) * _sizeX - ox,
+                                   (sy - 0.5f) * _sizeY,
+                                   -_camera.zeroParallaxPlane));
+            direction =
+                normalize(_du * local.x() + _dv * local.y() + _dc * local.z());
+            origin = _camera.position + _du * ox;
+        }
+        else
+        {
+            const float alpha = -2.f * float(M_PI) * sx;
+            const Vector3f local = normalize(
+                Vector3f(std::sin(alpha), _sizeY * (sy - 0.5f),
+                         -std::cos(alpha)));
+            direction =
+                normalize(_dc * local.x() + _dv * local.y() + _du * local.z());
+            origin = _camera.position + _dc * _radius * std::cos(alpha) +
+                     _du * _radius * std::sin(alpha);
+        }
+    }
+
+    /**
+     * Projects a point, or a direction for a point at infinity, to the right
+     * eye.
+     * @return false if the point is not visible from the right eye
+     */
+    bool projectRight(const Vector3f& point, const bool atInfinity, float& sx,
+                      float& sy, float& depth) const
+    {
+        if (_camera.projection == StereoReprojection::Projection::planar)
+        {
+            const float ox = _radius;
+            Vector3f local = solve(_du, _dv, _dc,
+                                   atInfinity ? point
+                                              : point - _camera.position);
+            if (!atInfinity)
+                local.x() -= ox;
+            const float s = -local.z() / _camera.zeroParallaxPlane;
+            if (s <= 0.f)
+                return false;
+            sx = ((ox + local.x() / s) / _sizeX + 1.5f) * 0.5f;
+            sy = local.y() / s / _sizeY + 0.5f;
+            depth = atInfinity
+                        ? INFINITE_DEPTH
+                        : (point - _camera.position - _du * ox).length();
+            return sx >= 0.5f && sx < 1.f && sy >= 0.f && sy < 1.f;
+        }
+
+        const float radius = -_radius;
+        const Vector3f local = solve(_dc, _dv, _du,
+                                     atInfinity ? point
+                                                : point - _camera.position);
+        const float rho = std::hypot(local.x(), local.z());
+        if (rho <= std::abs(radius) || (atInfinity && rho <= 0.f))
+            return false;
+
+        const float phi = std::atan2(local.z(), local.x());
+        float alpha;
+        float distance;
+        if (atInfinity)
+        {
+            alpha = phi + 0.5f * float(M_PI);
+            distance = rho;
+        }
+        else
+        {
+            alpha = phi + std::acos(radius / rho);
+            distance = std::sqrt(rho * rho - radius * radius);
+        }
+        while (alpha > float(M_PI))
+            alpha -= 2.f * float(M_PI);
+        while (alpha <= -float(M_PI))
+            alpha += 2.f * float(M_PI);
+        if (alpha > 0.f)
+            return false;
+
+        sx = 0.5f - alpha / (2.f * float(M_PI));
+        sy = local.y() / distance / _sizeY + 0.5f;
+        depth = atInfinity ? INFINITE_DEPTH
+                           : (point - _camera.position -
+                              _dc * radius * std::cos(alpha) -
+                              _du * radius * std::sin(alpha))
+                                 .length();
+        return sx >= 0.5f && sx < 1.f && sy >= 0.f && sy < 1.f;
+    }
+
+private:
+    const StereoReprojection::Camera& _camera;
+    Vector3f _du;
+    Vector3f _dv;
+    Vector3f _dc;
+    float _sizeX{0.f};
+    float _sizeY{0.f};
+    float _radius{0.f};
+};
+
+bool isDiscontinuous(const float a, const float b)
+{
+    if (isInfinite(a) || isInfinite(b))
+        return isInfinite(a) != isInfinite(b);
+    return std::abs(a - b) >
+           StereoReprojection::DEPTH_DISCONTINUITY * std::min(a, b);
+}
+}
+
+void StereoReprojection::reproject(const Camera& camera,
+                                   const Vector2ui& frameSize,
+                                   const float* colors, const float* depths)
+{
+    const size_t width = frameSize.x();
+    const size_t height = frameSize.y();
+    const size_t half = width / 2;
+
+    _colors.assign(width * height, Vector4f(0.f, 0.f, 0.f, -1.f));
+    _depths.assign(width * height, INFINITE_DEPTH);
+    std::vector<bool> covered(width * height, false);
+
+    const Eyes eyes(camera);
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < half; ++x)
+        {
+            const size_t index = y * width + x;
+            const float* color = colors + 4 * index;
+            _colors[index] = Vector4f(color[0], color[1], color[2], color[3]);
+            _depths[index] = depths[index];
+
+            // forward warp to the right eye, keeping the nearest surface
+            Vector3f origin;
+            Vector3f direction;
+            eyes.leftRay((x + 0.5f) / width, (y + 0.5f) / height, origin,
+                         direction);
+            const bool atInfinity = isInfinite(depths[index]);
+            float sx, sy, depth;
+            if (!eyes.projectRight(atInfinity
+                                       ? direction
+                                       : origin + direction * depths[index],
+                                   atInfinity, sx, sy, depth))
+            {
+                continue;
+            }
+            const size_t rx = sx * width;
+            const size_t ry = sy * height;
+            if (rx < half || rx >= width || ry >= height)
+                continue;
+            const size_t target = ry * width + rx;
+            if (covered[target] && _depths[target] <= depth)
+                continue;
+            covered[target] = true;
+            _colors[target] = _colors[index];
+            _depths[target] = depth;
+        }
+    }
+
+    // the pixels next to a depth discontinuity may show a surface that is
+    // hidden from the left eye, trace them
+    std::vector<bool> trace(width * height, false);
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = half; x < width; ++x)
+        {
+            const size_t index = y * width + x;
+            if (!covered[index])
+            {
+                trace[index] = true;
+                continue;
+            }
+            const size_t right = index + 1;
+            const size_t up = index + width;
+            if (x + 1 < width && covered[right] &&
+                isDiscontinuous(_depths[index], _depths[right]))
+            {
+                trace[index] = trace[right] = true;
+            }
+            if (y + 1 < height && covered[up] &&
+                isDiscontinuous(_depths[index], _depths[up]))
+            {
+                trace[index] = trace[up] = true;
+            }
+        }
+    }
+
+    _numPixelsToTrace = 0;
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = half; x < width; ++x)
+        {
+            const size_t index = y * width + x;
+            if (!trace[index])
+                continue;
+            _colors[index] = Vector4f(0.f, 0.f, 0.f, -1.f);
+            _depths[index] = INFINITE_DEPTH;
+            ++_numPixelsToTrace;
+        }
+    }
+}
+}
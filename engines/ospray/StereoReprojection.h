@@ -0,0 +1,93 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * Reprojects the left eye of a side by side stereo frame to the right eye
+ * using the depth of the left eye, so that only the pixels of the right eye
+ * that are not visible from the left eye need to be traced.
+ *
+ * The camera models are the ones of the stereoFull (stereoscopy module) and
+ * cylindricStereo (opendeck module) cameras.
+ */
+class StereoReprojection
+{
+public:
+    enum class Projection
+    {
+        planar,   // stereoFull
+        cylindric // cylindricStereo
+    };
+
+    struct Camera
+    {
+        Projection projection{Projection::planar};
+        Vector3f position;
+        Vector3f direction;
+        Vector3f up;
+        float interpupillaryDistance{0.0635f};
+        /** Vertical field of view in degrees, planar projection only */
+        float fovy{45.f};
+        /** Aspect ratio of the whole frame, planar projection only */
+        float aspect{1.f};
+        /** Planar projection only */
+        float zeroParallaxPlane{1.f};
+    };
+
+    /**
+     * Relative depth difference between neighbouring pixels of the right eye
+     * above which both pixels are traced, as the reprojection cannot tell
+     * whether the background is disoccluded there.
+     */
+    static constexpr float DEPTH_DISCONTINUITY = 0.05f;
+
+    /**
+     * Reprojects the left half of the frame to the right half. The right eye
+     * pixels that no left eye pixel reprojects to, or that are next to a depth
+     * discontinuity, are marked to be traced.
+     *
+     * @param colors RGBA colors of the whole frame, only the left half is used
+     * @param depths distance along the ray of the whole frame, only the left
+     *        half is used
+     */
+    void reproject(const Camera& camera, const Vector2ui& frameSize,
+                   const float* colors, const float* depths);
+
+    /**
+     * @return the RGBA colors of the whole frame: the left eye as given to
+     *         reproject() and the reprojected right eye, with a negative alpha
+     *         for the pixels to trace
+     */
+    const Vector4fs& getColors() const { return _colors; }
+    /** @return the depths matching getColors() */
+    const floats& getDepths() const { return _depths; }
+    /** @return the number of pixels of the right eye to trace */
+    size_t getNumPixelsToTrace() const { return _numPixelsToTrace; }
+private:
+    Vector4fs _colors;
+    floats _depths;
+    size_t _numPixelsToTrace{0};
+};
+}
@@ -0,0 +1,198 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "TemporalReprojection.h"
+
+#include <cmath>
+#include <limits>
+
+namespace brayns
+{
+namespace
+{
+const float INFINITE_DEPTH = std::numeric_limits<float>::infinity();
+
+// Cosine of the angle above which a surface seen at grazing angle from the
+// new view is not reprojected, its pixels would stretch over many new ones
+const float MIN_FACING_COSINE = 0.1f;
+
+bool isInfinite(const float depth)
+{
+    return !std::isfinite(depth) || depth >= 1e30f;
+}
+
+/** Pinhole projection of the perspective cameras */
+class Pinhole
+{
+public:
+    explicit Pinhole(const TemporalReprojection::Camera& camera)
+        : _origin(camera.position)
+    {
+        _dir = normalize(camera.direction);
+        _du = normalize(cross(_dir, camera.up));
+        _dv = cross(_du, _dir);
+        _sizeY = 2.f * std::tan(0.5f * camera.fovy * float(M_PI) / 180.f);
+        _sizeX = _sizeY * camera.aspect;
+    }
+
+    const Vector3f& getOrigin() const { return _origin; }
+    Vector3f direction(const float sx, const float sy) const
+    {
+        return normalize(_dir + _du * ((sx - 0.5f) * _sizeX) +
+                         _dv * ((sy - 0.5f) * _sizeY));
+    }
+
+    /**
+     * Projects a point, or a direction for a point at infinity.
+     * @return false if the point is behind the camera
+     */
+    bool project(const Vector3f& point, const bool atInfinity, float& sx,
+                 float& sy) const
+    {
+        const Vector3f local = atInfinity ? point : point - _origin;
+        const float z = dot(local, _dir);
+        if (z <= 0.f)
+            return false;
+        sx = dot(local, _du) / z / _sizeX + 0.5f;
+        sy = dot(local, _dv) / z / _sizeY + 0.5f;
+        return sx >= 0.f && sx < 1.f && sy >= 0.f && sy < 1.f;
+    }
+
+private:
+    Vector3f _origin;
+    Vector3f _dir;
+    Vector3f _du;
+    Vector3f _dv;
+    float _sizeX;
+    float _sizeY;
+};
+}
+
+void TemporalReprojection::reproject(const Camera& previousCamera,
+                                     const Camera& camera,
+                                     const Vector2ui& frameSize,
+                                     const Vector4fs& colors,
+                                     const floats& depths,
+                                     const size_t numFrames)
+{
+    const size_t width = frameSize.x();
+    const size_t height = frameSize.y();
+    const size_t size = width * height;
+
+    // samples already in the history before the last accumulation
+    floats previousWeights(size, 0.f);
+    if (isActive() && _frameSize == frameSize)
+        previousWeights = _weights;
+
+    _frameSize = frameSize;
+    _colors.assign(size, Vector4f(0.f, 0.f, 0.f, 0.f));
+    _depths.assign(size, INFINITE_DEPTH);
+    _weights.assign(size, 0.f);
+
+    const Pinhole previous(previousCamera);
+    const Pinhole current(camera);
+
+    // world position of the previous pixels, to estimate their normal
+    std::vector<Vector3f> positions(size);
+    for (size_t y = 0; y < height; ++y)
+        for (size_t x = 0; x < width; ++x)
+        {
+            const size_t index = y * width + x;
+            if (!isInfinite(depths[index]))
+                positions[index] =
+                    previous.getOrigin() +
+                    previous.direction((x + 0.5f) / width,
+                                       (y + 0.5f) / height) *
+                        depths[index];
+        }
+
+    // neighbour on the same surface, or the pixel itself
+    const auto neighbour = [&](const size_t index, const int offset) {
+        const size_t other = index + offset;
+        if (other >= size || isInfinite(depths[other]))
+            return index;
+        const float depth = depths[index];
+        return std::abs(depths[other] - depth) < 0.05f * depth ? other
+                                                               : index;
+    };
+
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            const size_t index = y * width + x;
+            const bool atInfinity = isInfinite(depths[index]);
+            const Vector3f direction =
+                previous.direction((x + 0.5f) / width, (y + 0.5f) / height);
+
+            float sx, sy;
+            if (!current.project(atInfinity ? direction : positions[index],
+                                 atInfinity, sx, sy))
+            {
+                continue;
+            }
+
+            float depth = INFINITE_DEPTH;
+            if (!atInfinity)
+            {
+                const Vector3f& position = positions[index];
+                const Vector3f toCamera = current.getOrigin() - position;
+                depth = toCamera.length();
+
+                // the normal is estimated from the depth of the neighbours, as
+                // the frame buffer does not have a normal channel
+                const size_t left = neighbour(index, x > 0 ? -1 : 0);
+                const size_t right = neighbour(index, x + 1 < width ? 1 : 0);
+                const int row = int(width);
+                const size_t down = neighbour(index, y > 0 ? -row : 0);
+                const size_t up = neighbour(index, y + 1 < height ? row : 0);
+                Vector3f normal = cross(positions[right] - positions[left],
+                                        positions[up] - positions[down]);
+                const float length = normal.length();
+                if (length > 0.f)
+                {
+                    normal = normal / length;
+                    if (dot(normal, direction) > 0.f)
+                        normal = -normal;
+                    if (dot(normal, toCamera) < MIN_FACING_COSINE * depth)
+                        continue;
+                }
+            }
+
+            const size_t target =
+                size_t(sy * height) * width + size_t(sx * width);
+            if (_weights[target] > 0.f && _depths[target] <= depth)
+                continue;
+
+            _colors[target] = colors[index];
+            _depths[target] = depth;
+            _weights[target] = std::min(previousWeights[index] + numFrames,
+                                        float(MAX_HISTORY_WEIGHT));
+        }
+    }
+}
+
+void TemporalReprojection::reset()
+{
+    _colors.clear();
+    _depths.clear();
+    _weights.clear();
+}
+}
@@ -0,0 +1,90 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * Reprojects the frame accumulated for a previous camera position to the
+ * current one, so that accumulation can continue from the previous samples
+ * after small camera moves instead of restarting from a noisy image.
+ *
+ * The previous pixels are forward-warped to the new view using their depth.
+ * The renderer blends the reprojected history with the new samples and
+ * rejects it where the new depth does not match the reprojected one.
+ *
+ * The camera model is the pinhole one of the perspective and
+ * clippedperspective cameras.
+ */
+class TemporalReprojection
+{
+public:
+    struct Camera
+    {
+        Vector3f position;
+        Vector3f direction;
+        Vector3f up;
+        /** Vertical field of view in degrees */
+        float fovy{45.f};
+        float aspect{1.f};
+    };
+
+    /**
+     * Maximum number of samples the history counts for, to bound the blur
+     * accumulated by successive reprojections.
+     */
+    static constexpr float MAX_HISTORY_WEIGHT = 32.f;
+
+    /**
+     * Reprojects the accumulated frame of the previous camera to the current
+     * one.
+     *
+     * @param colors accumulated RGBA colors of the previous frame
+     * @param depths distance along the ray of the previous frame
+     * @param numFrames number of frames accumulated in colors
+     */
+    void reproject(const Camera& previousCamera, const Camera& camera,
+                   const Vector2ui& frameSize, const Vector4fs& colors,
+                   const floats& depths, size_t numFrames);
+
+    /** Forgets the history, the next reprojection starts from no samples */
+    void reset();
+
+    /** @return true if there is a reprojected history to blend */
+    bool isActive() const { return !_weights.empty(); }
+    /** @return the reprojected RGBA colors of the history */
+    const Vector4fs& getColors() const { return _colors; }
+    /** @return the reprojected depths of the history, infinite if none */
+    const floats& getDepths() const { return _depths; }
+    /**
+     * @return the number of samples the history counts for in each pixel, 0
+     *         where there is no history
+     */
+    const floats& getWeights() const { return _weights; }
+private:
+    Vector2ui _frameSize;
+    Vector4fs _colors;
+    floats _depths;
+    floats _weights;
+};
+}
@@ -40,6 +40,8 @@ ExtendedCones::ExtendedCones()
 void ExtendedCones::finalize(ospray::Model* model)
 {
     data = getParamData("extendedcones", nullptr);
+    cellTags = getParamData("cell_tags", nullptr);
+    cellMask = getParamData("cell_mask", nullptr);
     constexpr size_t bytesPerCone = sizeof(brayns::Cone);
 
     if (data.ptr == nullptr || bytesPerCone == 0)
@@ -48,8 +50,11 @@ void ExtendedCones::finalize(ospray::Model* model)
             "no 'extendedcones' data specified");
 
     const size_t numExtendedCones = data->numBytes / bytesPerCone;
-    ispc::ExtendedConesGeometry_set(getIE(), model->getIE(), data->data,
-                                    numExtendedCones);
+    ispc::ExtendedConesGeometry_set(
+        getIE(), model->getIE(), data->data, numExtendedCones,
+        cellTags ? cellTags->data : nullptr,
+        cellMask ? cellMask->data : nullptr,
+        cellMask ? cellMask->numItems : 0);
 }
 
 OSP_REGISTER_GEOMETRY(ExtendedCones, extendedcones);
@@ -39,6 +39,8 @@ ExtendedCylinders::ExtendedCylinders()
 void ExtendedCylinders::finalize(ospray::Model* model)
 {
     data = getParamData("extendedcylinders", nullptr);
+    cellTags = getParamData("cell_tags", nullptr);
+    cellMask = getParamData("cell_mask", nullptr);
     constexpr size_t bytesPerCylinder = sizeof(brayns::Cylinder);
 
     if (data.ptr == nullptr || bytesPerCylinder == 0)
@@ -47,8 +49,11 @@ void ExtendedCylinders::finalize(ospray::Model* model)
             "no 'extendedcylinders' data specified");
 
     const size_t numExtendedCylinders = data->numBytes / bytesPerCylinder;
-    ispc::ExtendedCylindersGeometry_set(getIE(), model->getIE(), data->data,
-                                        numExtendedCylinders);
+    ispc::ExtendedCylindersGeometry_set(
+        getIE(), model->getIE(), data->data, numExtendedCylinders,
+        cellTags ? cellTags->data : nullptr,
+        cellMask ? cellMask->data : nullptr,
+        cellMask ? cellMask->numItems : 0);
 }
 
 OSP_REGISTER_GEOMETRY(ExtendedCylinders, extendedcylinders);
@@ -30,6 +30,8 @@ struct ExtendedCylinders : public ospray::Geometry
     void finalize(ospray::Model* model) final;
 
     ospray::Ref<ospray::Data> data;
+    ospray::Ref<ospray::Data> cellTags;
+    ospray::Ref<ospray::Data> cellMask;
 
     ExtendedCylinders();
 };
@@ -40,21 +40,38 @@ ExtendedSDFGeometries::ExtendedSDFGeometries()
 void ExtendedSDFGeometries::finalize(ospray::Model* model)
 {
     data = getParamData("extendedsdfgeometries", nullptr);
-    neighbours = getParamData("neighbours", nullptr);
     geometries = getParamData("geometries", nullptr);
+    spheres = getParamData("spheres", nullptr);
+    pills = getParamData("pills", nullptr);
+    conePills = getParamData("cone_pills", nullptr);
+    neighbours = getParamData("neighbours", nullptr);
+    cellTags = getParamData("cell_tags", nullptr);
+    cellMask = getParamData("cell_mask", nullptr);
 
-    if (data.ptr == nullptr)
+    if (data.ptr == nullptr || geometries.ptr == nullptr)
         throw std::runtime_error(
             "#ospray:geometry/ExtendedSDFGeometries: "
             "no 'ExtendedSDFGeometries' data specified");
 
-    const size_t numExtendedSDFGeometries = data->numItems;
-    const size_t numNeighbours = neighbours->numItems;
+    // the geometries and their shapes are passed as bytes
+    const auto numItems = [](const ospray::Ref<ospray::Data>& items,
+                             const size_t itemSize) -> size_t {
+        return items ? items->numBytes / itemSize : 0;
+    };
 
-    ispc::ExtendedSDFGeometriesGeometry_set(getIE(), model->getIE(), data->data,
-                                            numExtendedSDFGeometries,
-                                            neighbours->data, numNeighbours,
-                                            geometries->data);
+    ispc::ExtendedSDFGeometriesGeometry_set(
+        getIE(), model->getIE(), data->data, data->numItems, geometries->data,
+        numItems(geometries, sizeof(brayns::SDFGeometryInfo)),
+        spheres ? spheres->data : nullptr,
+        numItems(spheres, sizeof(brayns::SDFSphere)),
+        pills ? pills->data : nullptr, numItems(pills, sizeof(brayns::SDFPill)),
+        conePills ? conePills->data : nullptr,
+        numItems(conePills, sizeof(brayns::SDFConePill)),
+        neighbours ? neighbours->data : nullptr,
+        neighbours ? neighbours->numItems : 0,
+        cellTags ? cellTags->data : nullptr,
+        cellMask ? cellMask->data : nullptr,
+        cellMask ? cellMask->numItems : 0);
 }
 
 OSP_REGISTER_GEOMETRY(ExtendedSDFGeometries, extendedsdfgeometries);
@@ -32,8 +32,13 @@ struct ExtendedSDFGeometries : public ospray::Geometry
     void finalize(ospray::Model* model) final;
 
     ospray::Ref<ospray::Data> data;
-    ospray::Ref<ospray::Data> neighbours;
     ospray::Ref<ospray::Data> geometries;
+    ospray::Ref<ospray::Data> spheres;
+    ospray::Ref<ospray::Data> pills;
+    ospray::Ref<ospray::Data> conePills;
+    ospray::Ref<ospray::Data> neighbours;
+    ospray::Ref<ospray::Data> cellTags;
+    ospray::Ref<ospray::Data> cellMask;
 
     ExtendedSDFGeometries();
 
@@ -39,6 +39,8 @@ ExtendedSpheres::ExtendedSpheres()
 void ExtendedSpheres::finalize(ospray::Model* model)
 {
     data = getParamData("extendedspheres", nullptr);
+    cellTags = getParamData("cell_tags", nullptr);
+    cellMask = getParamData("cell_mask", nullptr);
     constexpr size_t bytesPerExtendedSphere = sizeof(brayns::Sphere);
 
     if (data.ptr == nullptr)
@@ -47,8 +49,11 @@ void ExtendedSpheres::finalize(ospray::Model* model)
             "no 'extendedspheres' data specified");
 
     const size_t numExtendedSpheres = data->numBytes / bytesPerExtendedSphere;
-    ispc::ExtendedSpheresGeometry_set(getIE(), model->getIE(), data->data,
-                                      numExtendedSpheres);
+    ispc::ExtendedSpheresGeometry_set(
+        getIE(), model->getIE(), data->data, numExtendedSpheres,
+        cellTags ? cellTags->data : nullptr,
+        cellMask ? cellMask->data : nullptr,
+        cellMask ? cellMask->numItems : 0);
 }
 
 OSP_REGISTER_GEOMETRY(ExtendedSpheres, extendedspheres);
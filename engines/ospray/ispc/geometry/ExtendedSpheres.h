@@ -32,6 +32,8 @@ struct ExtendedSpheres : public ospray::Geometry
     void finalize(ospray::Model* model) final;
 
     ospray::Ref<ospray::Data> data;
+    ospray::Ref<ospray::Data> cellTags;
+    ospray::Ref<ospray::Data> cellMask;
 
     ExtendedSpheres();
 
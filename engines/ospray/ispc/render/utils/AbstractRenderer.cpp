@@ -21,6 +21,7 @@
  */
 
 #include "AbstractRenderer.h"
+#include "AbstractRenderer_ispc.h"
 
 // ospray
 #include <ospray/SDK/common/Data.h>
@@ -46,6 +47,23 @@ void AbstractRenderer::commit()
     _bgMaterial =
         (brayns::obj::ExtendedOBJMaterial*)getParamObject("bgMaterial",
                                                           nullptr);
+
+    auto reprojectionColors = getParamData("reprojectionColors");
+    auto reprojectionDepths = getParamData("reprojectionDepths");
+    ispc::AbstractRenderer_setReprojection(
+        getIE(), getParam1i("reprojectionMode", 0),
+        getParam1i("reprojectionWidth", 0),
+        reprojectionColors ? reprojectionColors->data : nullptr,
+        reprojectionDepths ? reprojectionDepths->data : nullptr);
+
+    auto historyColors = getParamData("historyColors");
+    auto historyDepths = getParamData("historyDepths");
+    auto historyWeights = getParamData("historyWeights");
+    ispc::AbstractRenderer_setHistory(
+        getIE(), getParam1i("historyWidth", 0), getParam1f("historyFrame", 0.f),
+        historyColors ? historyColors->data : nullptr,
+        historyDepths ? historyDepths->data : nullptr,
+        historyWeights ? historyWeights->data : nullptr);
 }
 
 /*! \brief create a material of given type */
@@ -43,7 +43,8 @@ namespace brayns
         break;                                                   \
     }
 
-void setOSPRayProperties(const PropertyObject& object, OSPObject ospObject)
+void setOSPRayProperties(PropertyObject& object, OSPObject ospObject,
+                         const bool all)
 {
     if (!object.hasProperties())
         return;
@@ -51,6 +52,8 @@ void setOSPRayProperties(const PropertyObject& object, OSPObject ospObject)
     {
         for (const auto& prop : object.getPropertyMap().getProperties())
         {
+            if (!all && !prop->isModified())
+                continue;
             switch (prop->type)
             {
             case PropertyMap::Property::Type::Float:
@@ -75,6 +78,7 @@ void setOSPRayProperties(const PropertyObject& object, OSPObject ospObject)
                 SET_ARRAY_FLOAT(4fv, 4);
             }
         }
+        object.resetModifiedProperties();
     }
     catch (const std::exception& e)
     {
@@ -83,6 +87,12 @@ void setOSPRayProperties(const PropertyObject& object, OSPObject ospObject)
     }
 }
 
+std::mutex& getObjectCreationMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
 ospcommon::affine3f transformationToAffine3f(
     const Transformation& transformation)
 {
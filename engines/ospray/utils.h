@@ -23,13 +23,26 @@
 #include <brayns/common/types.h>
 #include <ospray/SDK/common/OSPCommon.h>
 
+#include <mutex>
+
 namespace brayns
 {
 /**
- * Set all the properties from the current property map of the given object to
- * the given ospray object.
+ * Set the properties from the current property map of the given object to the
+ * given ospray object, and mark them as unchanged afterwards.
+ *
+ * @param all set all the properties, for instance for a new ospray object,
+ *            instead of only the ones that changed since the last call
+ */
+void setOSPRayProperties(PropertyObject& object, OSPObject ospObject,
+                         bool all);
+
+/**
+ * The creation of OSPRay objects is not thread safe, while the loaders create
+ * their models, materials and volumes from several threads. The engine object
+ * factories lock this mutex.
  */
-void setOSPRayProperties(const PropertyObject& object, OSPObject ospObject);
+std::mutex& getObjectCreationMutex();
 
 /** Convert a brayns::Transformation to an ospcommon::affine3f. */
 ospcommon::affine3f transformationToAffine3f(
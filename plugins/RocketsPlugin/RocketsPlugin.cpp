@@ -90,6 +90,7 @@ const std::string METHOD_INSPECT = "inspect";
 const std::string METHOD_MODEL_PROPERTIES_SCHEMA = "model-properties-schema";
 const std::string METHOD_REMOVE_MODEL = "remove-model";
 const std::string METHOD_SCHEMA = "schema";
+const std::string METHOD_SET_CELL_VISIBILITY = "set-cell-visibility";
 const std::string METHOD_SET_MODEL_PROPERTIES = "set-model-properties";
 const std::string METHOD_UPDATE_INSTANCE = "update-instance";
 const std::string METHOD_UPDATE_MODEL = "update-model";
@@ -675,6 +676,8 @@ public:
         _handleGetInstances();
         _handleUpdateInstance();
 
+        _handleSetCellVisibility();
+
         _handlePropertyObject(_engine->getCamera(), ENDPOINT_CAMERA_PARAMS,
                               "camera");
         _handlePropertyObject(_engine->getRenderer(), ENDPOINT_RENDERER_PARAMS,
@@ -1031,6 +1034,41 @@ public:
                       buildJsonRpcSchemaRequest<ModelDescriptor, bool>(desc));
     }
 
+    void _handleSetCellVisibility()
+    {
+        const RpcParameterDescription desc{
+            METHOD_SET_CELL_VISIBILITY,
+            "Show or hide cells and section types of a circuit model without "
+            "reloading it; returns false if some GIDs are not loaded",
+            "param",
+            "model ID, GIDs of the cells (all if empty), visible section "
+            "types and optional simulation value range"};
+        _handleRPC<CellVisibility, bool>(
+            desc, [engine = _engine](const CellVisibility& param) {
+                auto& scene = engine->getScene();
+                auto model = scene.getModel(param.modelID);
+                if (!model)
+                    throw rockets::jsonrpc::response_error("Model not found",
+                                                           MODEL_NOT_FOUND);
+
+                // the mask is read by the render thread on scene commit
+                std::unique_lock<std::shared_timed_mutex> lock(
+                    scene.modelMutex());
+                auto& cellMask = model->getModel().getCellMask();
+                const auto sectionTypes = static_cast<uint8_t>(
+                    enumsToBitmask(param.sectionTypes));
+                const auto unknownGids =
+                    cellMask.setVisibleSections(param.gids, sectionTypes,
+                                                param.isolate);
+                cellMask.setSimulationRange(
+                    param.useSimulationRange,
+                    {float(param.simulationRange[0]),
+                     float(param.simulationRange[1])});
+                engine->triggerRender();
+                return unknownGids == 0;
+            });
+    }
+
     void _handleGetModelProperties()
     {
         const RpcParameterDescription desc{
@@ -70,6 +70,16 @@ struct ModelProperties
     size_t modelID;
     PropertyMap properties;
 };
+
+struct CellVisibility
+{
+    size_t modelID;
+    uint64_ts gids;
+    MorphologySectionTypes sectionTypes{MorphologySectionType::all};
+    bool isolate{false};
+    bool useSimulationRange{false};
+    std::array<double, 2> simulationRange{{0., 0.}};
+};
 }
 
 STATICJSON_DECLARE_ENUM(brayns::GeometryQuality,
@@ -103,6 +113,25 @@ STATICJSON_DECLARE_ENUM(brayns::MemoryMode,
                         {"shared", brayns::MemoryMode::shared},
                         {"replicated", brayns::MemoryMode::replicated});
 
+STATICJSON_DECLARE_ENUM(
+    brayns::SimulationInterpolation,
+    {"none", brayns::SimulationInterpolation::none},
+    {"linear", brayns::SimulationInterpolation::linear},
+    {"cubic", brayns::SimulationInterpolation::cubic});
+
+STATICJSON_DECLARE_ENUM(brayns::FrameReaderType,
+                        {"mmap", brayns::FrameReaderType::mmap},
+                        {"pread", brayns::FrameReaderType::pread},
+                        {"io_uring", brayns::FrameReaderType::io_uring});
+
+STATICJSON_DECLARE_ENUM(
+    brayns::SimulationReduction,
+    {"none", brayns::SimulationReduction::none},
+    {"section_mean", brayns::SimulationReduction::section_mean},
+    {"section_max", brayns::SimulationReduction::section_max},
+    {"cell_mean", brayns::SimulationReduction::cell_mean},
+    {"cell_max", brayns::SimulationReduction::cell_max});
+
 STATICJSON_DECLARE_ENUM(brayns::EngineType,
                         {"ospray", brayns::EngineType::ospray},
                         {"optix", brayns::EngineType::optix});
@@ -146,6 +175,17 @@ inline void init(brayns::ModelProperties* s, ObjectHandler* h)
     h->add_property("properties", &s->properties);
     h->set_flags(Flags::DisallowUnknownKey);
 }
+inline void init(brayns::CellVisibility* s, ObjectHandler* h)
+{
+    h->add_property("id", &s->modelID);
+    h->add_property("gids", &s->gids, Flags::Optional);
+    h->add_property("section_types", &s->sectionTypes, Flags::Optional);
+    h->add_property("isolate", &s->isolate, Flags::Optional);
+    h->add_property("use_simulation_range", &s->useSimulationRange,
+                    Flags::Optional);
+    h->add_property("simulation_range", &s->simulationRange, Flags::Optional);
+    h->set_flags(Flags::DisallowUnknownKey);
+}
 inline void init(brayns::ModelID* s, ObjectHandler* h)
 {
     h->add_property("id", &s->modelID);
@@ -172,6 +212,8 @@ inline void init(brayns::BinaryParam* s, ObjectHandler* h)
 {
     h->add_property("bounding_box", &s->_boundingBox, Flags::Optional);
     h->add_property("chunks_id", &s->chunksID);
+    h->add_property("compression", &s->compression, Flags::Optional);
+    h->add_property("compressed_size", &s->compressedSize, Flags::Optional);
     h->add_property("name", &s->_name, Flags::Optional);
     h->add_property("path", &s->_path);
     h->add_property("size", &s->size);
@@ -204,6 +246,9 @@ inline void init(brayns::Statistics* s, ObjectHandler* h)
 {
     h->add_property("fps", &s->_fps);
     h->add_property("scene_size_in_bytes", &s->_sceneSizeInBytes);
+    h->add_property("texture_size_in_bytes", &s->_textureSizeInBytes);
+    h->add_property("frame_time_jitter", &s->_frameTimeJitter,
+                    Flags::Optional);
     h->set_flags(Flags::DisallowUnknownKey);
 }
 
@@ -364,6 +409,8 @@ inline void init(brayns::CircuitConfiguration* c, ObjectHandler* h)
                     Flags::Optional);
     h->add_property("density", &c->density, Flags::Optional);
     h->add_property("bounding_box", &c->boundingBox, Flags::Optional);
+    h->add_property("bounding_box_clipping", &c->boundingBoxClipping,
+                    Flags::Optional);
     h->add_property("mesh_filename_pattern", &c->meshFilenamePattern,
                     Flags::Optional);
     h->add_property("mesh_folder", &c->meshFolder, Flags::Optional);
@@ -373,6 +420,10 @@ inline void init(brayns::CircuitConfiguration* c, ObjectHandler* h)
                     Flags::Optional);
     h->add_property("targets", &c->targets, Flags::Optional);
     h->add_property("report", &c->report, Flags::Optional);
+    h->add_property("simulation_cache_file", &c->simulationCacheFile,
+                    Flags::Optional);
+    h->add_property("simulation_reduction", &c->simulationReduction,
+                    Flags::Optional);
     h->add_property("start_simulation_time", &c->startSimulationTime,
                     Flags::Optional);
     h->add_property("end_simulation_time", &c->endSimulationTime,
@@ -434,6 +485,8 @@ inline void init(brayns::GeometryParameters* g, ObjectHandler* h)
     h->add_property("metaballs_samples_from_soma",
                     &g->_metaballsSamplesFromSoma, Flags::Optional);
     h->add_property("memory_mode", &g->_memoryMode, Flags::Optional);
+    h->add_property("simulation_frame_reader", &g->_simulationFrameReader,
+                    Flags::Optional);
     h->add_property("circuit_configuration", &g->_circuitConfiguration,
                     Flags::Optional);
     h->set_flags(Flags::DisallowUnknownKey);
@@ -445,9 +498,21 @@ inline void init(brayns::RenderingParameters* r, ObjectHandler* h)
     h->add_property("background_color", Vector3dArray(r->_backgroundColor),
                     Flags::Optional);
     h->add_property("current", &r->_renderer, Flags::Optional);
+    h->add_property("foveated_rendering", &r->_foveatedRendering,
+                    Flags::Optional);
+    h->add_property("foveation_focus", Vector2dArray(r->_foveationFocus),
+                    Flags::Optional);
+    h->add_property("foveation_peripheral_density",
+                    &r->_foveationPeripheralDensity, Flags::Optional);
+    h->add_property("foveation_radii", Vector2dArray(r->_foveationRadii),
+                    Flags::Optional);
     h->add_property("head_light", &r->_headLight, Flags::Optional);
     h->add_property("max_accum_frames", &r->_maxAccumFrames, Flags::Optional);
     h->add_property("samples_per_pixel", &r->_spp, Flags::Optional);
+    h->add_property("stereo_reprojection", &r->_stereoReprojection,
+                    Flags::Optional);
+    h->add_property("temporal_reprojection", &r->_temporalReprojection,
+                    Flags::Optional);
     h->add_property("types", &r->_renderers,
                     Flags::IgnoreRead | Flags::Optional);
     h->add_property("variance_threshold", &r->_varianceThreshold,
@@ -498,7 +563,9 @@ inline void init(brayns::AnimationParameters* a, ObjectHandler* h)
     h->add_property("start", &a->_start, Flags::Optional);
     h->add_property("end", &a->_end, Flags::Optional);
     h->add_property("current", &a->_current, Flags::Optional);
+    h->add_property("fraction", &a->_fraction, Flags::Optional);
     h->add_property("delta", &a->_delta, Flags::Optional);
+    h->add_property("interpolation", &a->_interpolation, Flags::Optional);
     h->add_property("dt", &a->_dt, Flags::Optional);
     h->add_property("unit", &a->_unit, Flags::Optional);
     h->set_flags(Flags::DisallowUnknownKey);
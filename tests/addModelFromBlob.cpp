@@ -152,6 +152,87 @@ BOOST_AUTO_TEST_CASE(xyz)
     BOOST_CHECK_EQUAL(model.getPath(), "monkey.xyz");
 }
 
+BOOST_AUTO_TEST_CASE(unsupported_compression)
+{
+    brayns::BinaryParam params;
+    params.size = 4;
+    params.type = "xyz";
+    params.compression = "blub";
+    try
+    {
+        makeRequest<brayns::BinaryParam, brayns::ModelDescriptor>(
+            REQUEST_MODEL_UPLOAD, {params});
+        BOOST_REQUIRE(false);
+    }
+    catch (const rockets::jsonrpc::response_error& e)
+    {
+        BOOST_CHECK_EQUAL(e.code, -1735);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(gzip_xyz)
+{
+    if (!brayns::StreamDecompressor::isSupported("gzip"))
+        return;
+
+    // "0.0 0.0 0.0\n1.0 1.0 1.0\n" compressed with gzip
+    const std::vector<unsigned char> compressed{
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x33,
+        0xd0, 0x33, 0x50, 0x30, 0x80, 0x60, 0x2e, 0x43, 0x20, 0x0d, 0xc5,
+        0x5c, 0x00, 0x74, 0x4b, 0x05, 0x8c, 0x18, 0x00, 0x00, 0x00};
+
+    brayns::BinaryParam params;
+    params.size = 24; // uncompressed size
+    params.type = "xyz";
+    params.compression = "gzip";
+    params.compressedSize = compressed.size();
+    params.setPath("points.xyz");
+
+    auto request = getJsonRpcClient()
+                       .request<brayns::BinaryParam, brayns::ModelDescriptor>(
+                           REQUEST_MODEL_UPLOAD, {params});
+
+    // send in two chunks to exercise the streaming decompression
+    const size_t half = compressed.size() / 2;
+    getWsClient().sendBinary((const char*)compressed.data(), half);
+    process();
+    getWsClient().sendBinary((const char*)compressed.data() + half,
+                             compressed.size() - half);
+
+    while (!request.is_ready())
+        process();
+    const auto& model = request.get();
+    BOOST_CHECK_EQUAL(model.getPath(), "points.xyz");
+}
+
+BOOST_AUTO_TEST_CASE(mismatching_compression)
+{
+    if (!brayns::StreamDecompressor::isSupported("bzip2"))
+        return;
+
+    // "0.0 0.0 0.0\n1.0 1.0 1.0\n" compressed with gzip, declared as bzip2
+    const std::vector<unsigned char> compressed{
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x33,
+        0xd0, 0x33, 0x50, 0x30, 0x80, 0x60, 0x2e, 0x43, 0x20, 0x0d, 0xc5,
+        0x5c, 0x00, 0x74, 0x4b, 0x05, 0x8c, 0x18, 0x00, 0x00, 0x00};
+
+    brayns::BinaryParam params;
+    params.size = 24;
+    params.type = "xyz";
+    params.compression = "bzip2";
+    params.compressedSize = compressed.size();
+
+    auto request = getJsonRpcClient()
+                       .request<brayns::BinaryParam, brayns::ModelDescriptor>(
+                           REQUEST_MODEL_UPLOAD, {params});
+    getWsClient().sendBinary((const char*)compressed.data(),
+                             compressed.size());
+
+    while (!request.is_ready())
+        process();
+    BOOST_CHECK_THROW(request.get(), rockets::jsonrpc::response_error);
+}
+
 BOOST_AUTO_TEST_CASE(broken_xyz)
 {
     brayns::BinaryParam params;
@@ -27,6 +27,7 @@
 #include <brayns/common/renderer/FrameBuffer.h>
 #include <brayns/common/scene/Model.h>
 #include <brayns/common/scene/Scene.h>
+#include <brayns/parameters/ParametersManager.h>
 
 #define BOOST_TEST_MODULE braynsTestData
 #include <boost/test/unit_test.hpp>
@@ -290,3 +291,103 @@ BOOST_AUTO_TEST_CASE(render_protein_in_stereo_and_compare)
     BOOST_CHECK(compareTestImage("testdataProteinStereo.png",
                                  brayns.getEngine().getFrameBuffer()));
 }
+
+BOOST_AUTO_TEST_CASE(render_protein_with_stereo_reprojection_and_compare)
+{
+    auto& testSuite = boost::unit_test::framework::master_test_suite();
+
+    const char* app = testSuite.argv[0];
+    const char* argv[] = {app,
+                          PDB_FILE,
+                          "--accumulation",
+                          "off",
+                          "--module",
+                          "stereoscopy",
+                          "--camera",
+                          "stereoFull",
+                          "--stereo-reprojection",
+                          "on"};
+    const int argc = sizeof(argv) / sizeof(char*);
+
+    brayns::Brayns brayns(argc, argv);
+    auto& engine = brayns.getEngine();
+    engine.getCamera().updateProperty("stereoMode", 3);
+    brayns.commitAndRender();
+    const auto reprojectedImage =
+        createPDiffRGBAImage(engine.getFrameBuffer());
+
+    // trace both eyes in full
+    auto& renderingParameters =
+        brayns.getParametersManager().getRenderingParameters();
+    renderingParameters.setStereoReprojection(false);
+    engine.getFrameBuffer().clear();
+    brayns.commitAndRender();
+    const auto fullImage = createPDiffRGBAImage(engine.getFrameBuffer());
+
+    BOOST_CHECK(pdiff::yee_compare(*fullImage, *reprojectedImage));
+}
+
+BOOST_AUTO_TEST_CASE(render_protein_with_temporal_reprojection_and_compare)
+{
+    auto& testSuite = boost::unit_test::framework::master_test_suite();
+
+    const char* app = testSuite.argv[0];
+    const char* argv[] = {app, PDB_FILE, "--temporal-reprojection", "on"};
+    const int argc = sizeof(argv) / sizeof(char*);
+
+    brayns::Brayns brayns(argc, argv);
+    auto& engine = brayns.getEngine();
+    for (size_t i = 0; i < 16; ++i)
+        brayns.commitAndRender();
+
+    // a small move continues from the reprojected accumulation
+    auto& camera = engine.getCamera();
+    const auto distance =
+        (camera.getTarget() - camera.getPosition()).length();
+    camera.setPosition(camera.getPosition() +
+                       brayns::Vector3d(0.005 * distance, 0., 0.));
+    brayns.commitAndRender();
+    const auto reprojectedImage =
+        createPDiffRGBAImage(engine.getFrameBuffer());
+
+    // converged render of the new view
+    auto& renderingParameters =
+        brayns.getParametersManager().getRenderingParameters();
+    renderingParameters.setTemporalReprojection(false);
+    for (size_t i = 0; i < 16; ++i)
+        brayns.commitAndRender();
+    const auto convergedImage = createPDiffRGBAImage(engine.getFrameBuffer());
+
+    BOOST_CHECK(pdiff::yee_compare(*convergedImage, *reprojectedImage));
+}
+
+BOOST_AUTO_TEST_CASE(render_protein_with_foveated_rendering_and_compare)
+{
+    auto& testSuite = boost::unit_test::framework::master_test_suite();
+
+    const char* app = testSuite.argv[0];
+    const char* argv[] = {app,
+                          PDB_FILE,
+                          "--accumulation",
+                          "off",
+                          "--foveated-rendering",
+                          "on",
+                          "--foveation-peripheral-density",
+                          "0.25"};
+    const int argc = sizeof(argv) / sizeof(char*);
+
+    brayns::Brayns brayns(argc, argv);
+    auto& engine = brayns.getEngine();
+    brayns.commitAndRender();
+    const auto foveatedImage = createPDiffRGBAImage(engine.getFrameBuffer());
+
+    // trace all the pixels
+    auto& renderingParameters =
+        brayns.getParametersManager().getRenderingParameters();
+    renderingParameters.setFoveatedRendering(false);
+    engine.getFrameBuffer().clear();
+    brayns.commitAndRender();
+    const auto fullImage = createPDiffRGBAImage(engine.getFrameBuffer());
+
+    BOOST_CHECK(pdiff::yee_compare(*fullImage, *foveatedImage));
+}
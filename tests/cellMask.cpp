@@ -0,0 +1,91 @@
+/* Copyright (c) 2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define BOOST_TEST_MODULE braynsCellMask
+
+#include <brayns/common/scene/CellMask.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+const uint8_t ALL = uint8_t(brayns::MorphologySectionType::all);
+const uint8_t SOMA = uint8_t(brayns::MorphologySectionType::soma);
+}
+
+BOOST_AUTO_TEST_CASE(select_by_gid)
+{
+    brayns::CellMask mask;
+    mask.resize(4);
+    mask.setCellIds({10, 20, 30, 40});
+    BOOST_CHECK_EQUAL(mask.getData()[0], ALL);
+
+    BOOST_CHECK_EQUAL(mask.setVisibleSections({20, 40}, SOMA, false), 0);
+    BOOST_CHECK_EQUAL(mask.getData()[0], ALL);
+    BOOST_CHECK_EQUAL(mask.getData()[1], SOMA);
+    BOOST_CHECK_EQUAL(mask.getData()[3], SOMA);
+
+    BOOST_CHECK_EQUAL(mask.setVisibleSections({30, 50}, ALL, true), 1);
+    BOOST_CHECK_EQUAL(mask.getData()[0], 0);
+    BOOST_CHECK_EQUAL(mask.getData()[1], 0);
+    BOOST_CHECK_EQUAL(mask.getData()[2], ALL);
+
+    mask.setVisibleSections({}, ALL, false);
+    for (const auto value : mask.getData())
+        BOOST_CHECK_EQUAL(value, ALL);
+}
+
+BOOST_AUTO_TEST_CASE(update_keeps_buffer)
+{
+    brayns::CellMask mask;
+    mask.resize(1000);
+    mask.resetModified();
+    const auto data = mask.getData().data();
+
+    mask.setVisibleSections({1, 2, 3}, 0, false);
+    BOOST_CHECK(mask.isModified());
+    BOOST_CHECK_EQUAL(mask.getData().data(), data);
+}
+
+BOOST_AUTO_TEST_CASE(simulation_range)
+{
+    brayns::CellMask mask;
+    mask.resize(3);
+    mask.setSimulationOffsets({0, 2, 4});
+
+    const float frame[] = {-70.f, 0.f, -40.f, 0.f, 10.f};
+    mask.applySimulationFrame(frame, 5);
+    mask.setSimulationRange(true, {-50.f, 20.f});
+    BOOST_CHECK_EQUAL(mask.getData()[0], 0);
+    BOOST_CHECK_EQUAL(mask.getData()[1], ALL);
+    BOOST_CHECK_EQUAL(mask.getData()[2], ALL);
+
+    // Selection and range are combined
+    mask.setVisibleSections({2}, 0, false);
+    BOOST_CHECK_EQUAL(mask.getData()[2], 0);
+
+    const float nextFrame[] = {-30.f, 0.f, -90.f, 0.f, 10.f};
+    mask.applySimulationFrame(nextFrame, 5);
+    BOOST_CHECK_EQUAL(mask.getData()[0], ALL);
+    BOOST_CHECK_EQUAL(mask.getData()[1], 0);
+
+    mask.setSimulationRange(false, {});
+    BOOST_CHECK_EQUAL(mask.getData()[1], ALL);
+}
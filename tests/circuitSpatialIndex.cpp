@@ -0,0 +1,134 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/io/CircuitSpatialIndex.h>
+
+#define BOOST_TEST_MODULE braynsCircuitSpatialIndex
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+namespace
+{
+brayns::CircuitSpatialIndex::Cell makeCell(const uint32_t gid,
+                                           const brayns::Vector3f& soma,
+                                           const brayns::Vector3f& min,
+                                           const brayns::Vector3f& max)
+{
+    brayns::CircuitSpatialIndex::Cell cell;
+    cell.gid = gid;
+    cell.soma = soma;
+    cell.bounds = brayns::Boxf(min, max);
+    return cell;
+}
+
+/** Cells on a 10x10x10 grid with a unit box around the soma */
+std::vector<brayns::CircuitSpatialIndex::Cell> makeGrid()
+{
+    std::vector<brayns::CircuitSpatialIndex::Cell> cells;
+    uint32_t gid = 1;
+    for (float z = 0; z < 10; ++z)
+        for (float y = 0; y < 10; ++y)
+            for (float x = 0; x < 10; ++x)
+            {
+                const brayns::Vector3f soma(10 * x, 10 * y, 10 * z);
+                cells.push_back(
+                    makeCell(gid++, soma, soma - 1.f, soma + 1.f));
+            }
+    return cells;
+}
+}
+
+BOOST_AUTO_TEST_CASE(intersect_cells)
+{
+    brayns::CircuitSpatialIndex index;
+    index.addCells(makeGrid());
+    BOOST_CHECK_EQUAL(index.getNumCells(), 1000);
+
+    // 2x2x2 cells between (5, 5, 5) and (25, 25, 25)
+    const auto gids = index.intersect({{5, 5, 5}, {25, 25, 25}});
+    const brayns::uint32_ts expected{112, 113, 122, 123, 212, 213, 222, 223};
+    BOOST_CHECK_EQUAL_COLLECTIONS(gids.begin(), gids.end(), expected.begin(),
+                                  expected.end());
+
+    BOOST_CHECK(index.intersect({{200, 200, 200}, {300, 300, 300}}).empty());
+    BOOST_CHECK(brayns::CircuitSpatialIndex().intersect({{0, 0, 0}, {1, 1, 1}})
+                    .empty());
+}
+
+BOOST_AUTO_TEST_CASE(intersect_arbor_outside_of_soma)
+{
+    brayns::CircuitSpatialIndex index;
+    index.addCells(makeGrid());
+
+    // the soma is far from the region, the arbor crosses it
+    index.addCells(
+        {makeCell(2000, {500, 500, 500}, {4, 4, 4}, {500, 500, 500})});
+    const auto gids = index.intersect({{4, 4, 4}, {6, 6, 6}});
+    BOOST_REQUIRE_EQUAL(gids.size(), 1);
+    BOOST_CHECK_EQUAL(gids[0], 2000);
+}
+
+BOOST_AUTO_TEST_CASE(missing_gids)
+{
+    brayns::CircuitSpatialIndex index;
+    index.addCells(makeGrid());
+
+    const auto missing = index.getMissingGIDs({999, 1000, 1001, 1002});
+    const brayns::uint32_ts expected{1001, 1002};
+    BOOST_CHECK_EQUAL_COLLECTIONS(missing.begin(), missing.end(),
+                                  expected.begin(), expected.end());
+
+    // replacing a cell moves it
+    index.addCells({makeCell(1, {50, 50, 50}, {50, 50, 50}, {50, 50, 50})});
+    BOOST_CHECK_EQUAL(index.getNumCells(), 1000);
+    BOOST_CHECK(index.intersect({{-1, -1, -1}, {1, 1, 1}}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(cache_file)
+{
+    const auto folder = boost::filesystem::temp_directory_path();
+    const auto circuit = (folder / boost::filesystem::unique_path()).string();
+    std::ofstream(circuit) << "Run Default {}";
+    const auto filename =
+        brayns::CircuitSpatialIndex::getCacheFilename(folder.string(),
+                                                      circuit);
+
+    brayns::CircuitSpatialIndex index;
+    BOOST_CHECK(!index.load(filename, circuit));
+    index.addCells(makeGrid());
+    index.save(filename, circuit);
+
+    brayns::CircuitSpatialIndex loaded;
+    BOOST_REQUIRE(loaded.load(filename, circuit));
+    BOOST_CHECK_EQUAL(loaded.getNumCells(), 1000);
+    const brayns::Boxf box({5, 5, 5}, {25, 25, 25});
+    const auto gids = loaded.intersect(box);
+    const auto expected = index.intersect(box);
+    BOOST_CHECK_EQUAL_COLLECTIONS(gids.begin(), gids.end(), expected.begin(),
+                                  expected.end());
+
+    // the index of another circuit is not used
+    BOOST_CHECK(!loaded.load(filename, circuit + "2"));
+
+    boost::filesystem::remove(filename);
+    boost::filesystem::remove(circuit);
+}
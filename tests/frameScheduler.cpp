@@ -0,0 +1,104 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define BOOST_TEST_MODULE braynsFrameScheduler
+
+#include <brayns/common/FrameScheduler.h>
+#include <brayns/common/Timer.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+// The timing checks only compare with the deadlines, which the waits reach at
+// the earliest, so that a loaded machine does not make them fail.
+
+BOOST_AUTO_TEST_CASE(unlimited_does_not_wait)
+{
+    brayns::FrameScheduler scheduler;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        scheduler.startFrame();
+        scheduler.waitForNextFrame();
+    }
+    BOOST_CHECK_EQUAL(scheduler.getJitter().intervals, 9);
+    BOOST_CHECK_EQUAL(scheduler.getJitter().maxDeviation, 0.);
+}
+
+BOOST_AUTO_TEST_CASE(deadlines_include_frame_duration)
+{
+    brayns::FrameScheduler scheduler;
+    scheduler.setMaxFPS(50);
+
+    brayns::Timer timer;
+    timer.start();
+    for (size_t i = 0; i < 10; ++i)
+    {
+        scheduler.startFrame();
+        // rendering time is part of the frame interval, not added to it
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        scheduler.waitForNextFrame();
+    }
+    BOOST_CHECK_GE(timer.elapsed(), 0.2 * 0.999);
+
+    // the frames start on the grid of deadlines, or later
+    const auto jitter = scheduler.getJitter();
+    BOOST_CHECK_EQUAL(jitter.intervals, 9);
+    BOOST_CHECK_GE(jitter.meanInterval, 0.02 * 0.999);
+
+    scheduler.resetJitter();
+    BOOST_CHECK_EQUAL(scheduler.getJitter().intervals, 0);
+}
+
+BOOST_AUTO_TEST_CASE(wake_up_before_frame_is_discarded)
+{
+    brayns::FrameScheduler scheduler;
+    scheduler.setMaxFPS(20);
+
+    // e.g. the animation commits a change before every frame
+    brayns::Timer timer;
+    timer.start();
+    for (size_t i = 0; i < 3; ++i)
+    {
+        scheduler.wakeUp();
+        scheduler.startFrame();
+        scheduler.waitForNextFrame();
+    }
+    BOOST_CHECK_GE(timer.elapsed(), 0.15 * 0.999);
+}
+
+BOOST_AUTO_TEST_CASE(wake_up_ends_wait)
+{
+    brayns::FrameScheduler scheduler;
+    scheduler.setMaxFPS(1);
+    scheduler.startFrame();
+
+    std::thread waker([&scheduler] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        scheduler.wakeUp();
+    });
+
+    // the wait ends before its deadline
+    brayns::Timer timer;
+    timer.start();
+    scheduler.waitForNextFrame();
+    BOOST_CHECK_LT(timer.elapsed(), 1.);
+    waker.join();
+}
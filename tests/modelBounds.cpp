@@ -0,0 +1,57 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/Brayns.h>
+
+#include <brayns/common/engine/Engine.h>
+#include <brayns/common/scene/Model.h>
+#include <brayns/common/scene/Scene.h>
+
+#define BOOST_TEST_MODULE braynsModelBounds
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(incremental_bounds)
+{
+    auto& testSuite = boost::unit_test::framework::master_test_suite();
+    const char* app = testSuite.argv[0];
+    const char* argv[] = {app, "demo", "--synchronous-mode", "on"};
+    const int argc = sizeof(argv) / sizeof(char*);
+    brayns::Brayns brayns(argc, argv);
+
+    auto model = brayns.getEngine().getScene().createModel();
+    model->addSphere(0, {{0.f, 0.f, 0.f}, 1.f});
+    model->addSpheres(1, {{{10.f, 0.f, 0.f}, 1.f}, {{0.f, 10.f, 0.f}, 1.f}});
+    model->addCylinder(2, {{0.f, 0.f, -5.f}, {0.f, 0.f, 5.f}, 1.f});
+    model->createMissingMaterials();
+    model->commit();
+
+    BOOST_CHECK_EQUAL(model->getBounds().getMin(),
+                      brayns::Vector3d(-1, -1, -5));
+    BOOST_CHECK_EQUAL(model->getBounds().getMax(), brayns::Vector3d(11, 11, 5));
+
+    // only the modified material is computed again
+    model->getSpheres(1).pop_back();
+    model->commit();
+    BOOST_CHECK_EQUAL(model->getBounds().getMax(), brayns::Vector3d(11, 1, 5));
+
+    model->getSpheres().erase(1);
+    model->commit();
+    BOOST_CHECK_EQUAL(model->getBounds().getMax(), brayns::Vector3d(1, 1, 5));
+}
@@ -0,0 +1,93 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/Brayns.h>
+
+#include <brayns/common/engine/Engine.h>
+#include <brayns/common/geometry/Sphere.h>
+#include <brayns/common/scene/Model.h>
+#include <brayns/common/scene/Scene.h>
+
+#define BOOST_TEST_MODULE braynsModelMemory
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <unistd.h>
+
+namespace
+{
+const size_t NB_SPHERES = 1000000;
+const size_t NB_CYCLES = 20;
+const size_t WARMUP_CYCLES = 3;
+
+// Tolerated growth of the resident memory after the warm-up cycles, a small
+// fraction of the size of one model
+const size_t MAX_GROWTH = NB_SPHERES * sizeof(brayns::Sphere) / 4;
+
+size_t residentMemory()
+{
+    size_t size = 0;
+    size_t resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> size >> resident;
+    return resident * ::sysconf(_SC_PAGESIZE);
+}
+
+size_t addSpheresModel(brayns::Scene& scene)
+{
+    auto model = scene.createModel();
+    model->createMaterial(0, "spheres");
+    for (size_t i = 0; i < NB_SPHERES; ++i)
+        model->addSphere(0, {{float(i % 100), float(i / 100 % 100),
+                              float(i / 10000)},
+                             0.5f});
+    return scene.addModel(
+        std::make_shared<brayns::ModelDescriptor>(std::move(model), "soak"));
+}
+}
+
+BOOST_AUTO_TEST_CASE(load_unload_cycles)
+{
+    if (residentMemory() == 0)
+        return; // procfs not available
+
+    auto& testSuite = boost::unit_test::framework::master_test_suite();
+    const char* app = testSuite.argv[0];
+    const char* argv[] = {app, "demo", "--synchronous-mode", "on"};
+    const int argc = sizeof(argv) / sizeof(char*);
+    brayns::Brayns brayns(argc, argv);
+
+    auto& scene = brayns.getEngine().getScene();
+
+    size_t baseline = 0;
+    for (size_t i = 0; i < NB_CYCLES; ++i)
+    {
+        const auto id = addSpheresModel(scene);
+        brayns.commitAndRender();
+
+        scene.removeModel(id);
+        brayns.commitAndRender();
+
+        if (i + 1 == WARMUP_CYCLES)
+            baseline = residentMemory();
+        else if (i + 1 > WARMUP_CYCLES)
+            BOOST_CHECK_LE(residentMemory(), baseline + MAX_GROWTH);
+    }
+}
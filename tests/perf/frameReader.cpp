@@ -0,0 +1,101 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/common/Timer.h>
+#include <brayns/common/simulation/FrameReader.h>
+#include <brayns/common/simulation/SimulationCacheWriter.h>
+
+#define BOOST_TEST_MODULE braynsFrameReader
+#include <boost/test/unit_test.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+const uint64_t NB_FRAMES = 256;
+const uint64_t FRAME_SIZE = 1000003; // not aligned on the block size
+
+/** Evicts the file from the page cache, so that reads hit the disk */
+void dropCache(const std::string& filename)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+/** Plays all frames in order, prefetching the next ones; @return MB/s */
+double play(brayns::FrameReader& reader)
+{
+    brayns::Timer timer;
+    timer.start();
+    float sum = 0.f;
+    for (uint64_t frame = 0; frame < reader.getNbFrames(); ++frame)
+    {
+        const float* values = reader.getFrame(frame, true);
+        BOOST_REQUIRE_EQUAL(values[0], float(frame));
+        for (uint64_t i = 0; i < reader.getFrameSize(); i += 1024)
+            sum += values[i];
+        for (size_t i = 1; i < reader.getQueueDepth(); ++i)
+            reader.prefetch(frame + i);
+    }
+    BOOST_CHECK_GT(sum, 0.f);
+    return reader.getNbFrames() * reader.getFrameSize() * sizeof(float) /
+           (1024. * 1024. * timer.elapsed());
+}
+}
+
+BOOST_AUTO_TEST_CASE(frame_reader_throughput)
+{
+    const auto filename = boost::filesystem::unique_path().string();
+    {
+        brayns::SimulationCacheWriter writer(filename, NB_FRAMES, FRAME_SIZE,
+                                             false);
+        brayns::floats values(FRAME_SIZE);
+        for (uint64_t frame = 0; frame < NB_FRAMES; ++frame)
+        {
+            std::fill(values.begin(), values.end(), float(frame));
+            writer.append(values.data(), 1);
+        }
+        writer.close();
+    }
+
+    const std::pair<brayns::FrameReaderType, std::string> types[] = {
+        {brayns::FrameReaderType::mmap, "mmap"},
+        {brayns::FrameReaderType::pread, "pread"},
+        {brayns::FrameReaderType::io_uring, "io_uring"}};
+    for (const auto& type : types)
+    {
+        for (const size_t queueDepth : {1, 4, 16})
+        {
+            dropCache(filename);
+            auto reader =
+                brayns::FrameReader::create(type.first, filename, queueDepth);
+            if (reader->getType() != type.first)
+                continue;
+            BOOST_TEST_MESSAGE(type.second << ", queue depth " << queueDepth
+                                           << ": " << play(*reader)
+                                           << " MB/s");
+        }
+    }
+    boost::filesystem::remove(filename);
+}
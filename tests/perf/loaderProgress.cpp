@@ -0,0 +1,99 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/common/Timer.h>
+#include <brayns/common/loader/ProgressAggregator.h>
+
+#define BOOST_TEST_MODULE braynsLoaderProgress
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const size_t NB_ITEMS = 1 << 24;
+
+/** Runs body(item) over NB_ITEMS items on all cores, returns milliseconds */
+template <typename Body>
+int64_t runParallel(const Body& body)
+{
+    const size_t nbThreads = std::max(1u, std::thread::hardware_concurrency());
+    brayns::Timer timer;
+    timer.start();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nbThreads; ++t)
+        threads.emplace_back([&body, t, nbThreads] {
+            for (size_t i = t; i < NB_ITEMS; i += nbThreads)
+                body(i);
+        });
+    for (auto& thread : threads)
+        thread.join();
+    timer.stop();
+    return timer.milliseconds();
+}
+}
+
+BOOST_AUTO_TEST_CASE(progress_overhead)
+{
+    // stands for the work done per element by a loader
+    std::vector<float> values(NB_ITEMS);
+    auto work = [&values](const size_t i) { values[i] = std::sqrt(float(i)); };
+
+    const auto reference = runParallel(work);
+
+    // progress reported the way the loaders did before: one callback per
+    // element, serialized
+    size_t serializedCalls = 0;
+    std::mutex mutex;
+    auto serializedCallback = [&serializedCalls](const std::string&, float) {
+        ++serializedCalls;
+    };
+    const auto serialized = runParallel([&](const size_t i) {
+        work(i);
+        std::lock_guard<std::mutex> lock(mutex);
+        serializedCallback("Loading", float(i) / NB_ITEMS);
+    });
+
+    size_t aggregatedCalls = 0;
+    brayns::ProgressAggregator progress(
+        [&aggregatedCalls](const std::string&, float) { ++aggregatedCalls; },
+        "Loading", NB_ITEMS);
+    const auto aggregated = runParallel([&](const size_t i) {
+        work(i);
+        progress.increment();
+    });
+    progress.finish();
+
+    BOOST_TEST_MESSAGE("No progress: " << reference << " ms");
+    BOOST_TEST_MESSAGE("Serialized progress: " << serialized << " ms, "
+                                               << serializedCalls
+                                               << " callbacks");
+    BOOST_TEST_MESSAGE("Aggregated progress: " << aggregated << " ms, "
+                                               << aggregatedCalls
+                                               << " callbacks");
+
+    // the timings depend on the machine load, they are only reported
+    BOOST_CHECK_EQUAL(progress.getCurrent(), NB_ITEMS);
+    BOOST_CHECK_EQUAL(serializedCalls, NB_ITEMS);
+    BOOST_CHECK_LT(aggregatedCalls, serializedCalls);
+}
@@ -0,0 +1,143 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/common/Timer.h>
+#include <brayns/io/sampleBatch.h>
+
+#define BOOST_TEST_MODULE braynsMorphologyTransform
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+const size_t NB_MORPHOLOGIES = 1000;
+const size_t NB_SECTIONS = 100;
+const size_t NB_SAMPLES = 50;
+const float RADIUS_MULTIPLIER = 2.f;
+
+/** Sections of random walks, in the layout of brain::neuron::Section */
+std::vector<brayns::Vector4fs> createSections()
+{
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> step(-1.f, 1.f);
+    std::uniform_real_distribution<float> diameter(0.1f, 2.f);
+    std::vector<brayns::Vector4fs> sections(NB_SECTIONS);
+    for (auto& samples : sections)
+    {
+        brayns::Vector4f sample(0.f, 0.f, 0.f, 1.f);
+        for (size_t i = 0; i < NB_SAMPLES; ++i)
+        {
+            sample = brayns::Vector4f(sample.x() + step(generator),
+                                      sample.y() + step(generator),
+                                      sample.z() + step(generator),
+                                      diameter(generator));
+            samples.push_back(sample);
+        }
+    }
+    return sections;
+}
+
+/** Rotation around the z axis followed by a translation */
+brayns::Matrix4f createTransformation(const size_t index)
+{
+    const float angle = 0.01f * index;
+    brayns::Matrix4f matrix;
+    matrix(0, 0) = std::cos(angle);
+    matrix(0, 1) = -std::sin(angle);
+    matrix(1, 0) = std::sin(angle);
+    matrix(1, 1) = std::cos(angle);
+    matrix(0, 3) = float(index);
+    matrix(1, 3) = 2.f * index;
+    matrix(2, 3) = 3.f * index;
+    return matrix;
+}
+}
+
+BOOST_AUTO_TEST_CASE(batched_transform)
+{
+    const auto sections = createSections();
+    const brayns::Vector3f translation(1.f, 2.f, 3.f);
+
+    // one sample at a time into an array of structures, the way the loader
+    // generated the geometry before
+    brayns::Timer timer;
+    timer.start();
+    double referenceSum = 0;
+    brayns::Vector4fs transformed;
+    for (size_t m = 0; m < NB_MORPHOLOGIES; ++m)
+    {
+        const auto transformation = createTransformation(m);
+        for (const auto& samples : sections)
+        {
+            transformed.clear();
+            for (const auto& sample : samples)
+            {
+                const auto position = brayns::transformPoint(
+                    {sample.x(), sample.y(), sample.z()}, transformation,
+                    translation);
+                transformed.push_back(brayns::Vector4f(
+                    position, sample.w() * 0.5f * RADIUS_MULTIPLIER));
+            }
+            referenceSum += transformed.back().x() + transformed.back().w();
+        }
+    }
+    timer.stop();
+    const auto reference = timer.milliseconds();
+
+    timer.start();
+    double batchedSum = 0;
+    brayns::SampleBatch batch;
+    for (size_t m = 0; m < NB_MORPHOLOGIES; ++m)
+    {
+        const auto transformation = createTransformation(m);
+        for (const auto& samples : sections)
+        {
+            brayns::transformSamples(samples, transformation, translation,
+                                     RADIUS_MULTIPLIER, 0.f, batch);
+            batchedSum += batch.x.back() + batch.radius.back();
+        }
+    }
+    timer.stop();
+    const auto batched = timer.milliseconds();
+
+    BOOST_TEST_MESSAGE(NB_MORPHOLOGIES * NB_SECTIONS * NB_SAMPLES
+                       << " samples");
+    BOOST_TEST_MESSAGE("Per sample: " << reference << " ms");
+    BOOST_TEST_MESSAGE("Batched: " << batched << " ms");
+
+    BOOST_CHECK_CLOSE(batchedSum, referenceSum, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(radius_correction)
+{
+    const auto sections = createSections();
+    brayns::SampleBatch batch;
+    brayns::transformSamples(sections[0], brayns::Matrix4f(),
+                             brayns::Vector3f(0.f, 0.f, 0.f), RADIUS_MULTIPLIER,
+                             0.5f, batch);
+    BOOST_REQUIRE_EQUAL(batch.size(), NB_SAMPLES);
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(batch.radius[i], 0.5f);
+        BOOST_CHECK_EQUAL(batch.x[i], sections[0][i].x());
+    }
+}
@@ -0,0 +1,108 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/Brayns.h>
+
+#include <brayns/common/Timer.h>
+#include <brayns/common/engine/Engine.h>
+#include <brayns/common/renderer/FrameBuffer.h>
+#include <brayns/common/renderer/Renderer.h>
+#include <brayns/parameters/ParametersManager.h>
+
+#define BOOST_TEST_MODULE braynsPathTracingConvergence
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const size_t REFERENCE_FRAMES = 1024;
+const double TIME_BUDGETS[] = {0.25, 0.5, 1., 2.};
+
+brayns::floats readColors(brayns::FrameBuffer& frameBuffer)
+{
+    frameBuffer.map();
+    const auto size = frameBuffer.getSize();
+    const uint8_t* colors = frameBuffer.getColorBuffer();
+    brayns::floats values;
+    values.reserve(size.x() * size.y() * 3);
+    for (size_t i = 0; i < size.x() * size.y(); ++i)
+        for (size_t channel = 0; channel < 3; ++channel)
+            values.push_back(colors[4 * i + channel] / 255.f);
+    frameBuffer.unmap();
+    return values;
+}
+
+double rootMeanSquareError(const brayns::floats& image,
+                           const brayns::floats& reference)
+{
+    double sum = 0.;
+    for (size_t i = 0; i < image.size(); ++i)
+        sum += (image[i] - reference[i]) * (image[i] - reference[i]);
+    return std::sqrt(sum / image.size());
+}
+}
+
+BOOST_AUTO_TEST_CASE(path_tracing_convergence_at_equal_time)
+{
+    auto& testSuite = boost::unit_test::framework::master_test_suite();
+    const char* app = testSuite.argv[0];
+    const char* argv[] = {app, "demo", "--renderer", "pathtracing"};
+    const int argc = sizeof(argv) / sizeof(char*);
+    brayns::Brayns brayns(argc, argv);
+
+    auto& renderer = brayns.getEngine().getRenderer();
+    auto props = renderer.getPropertyMap();
+    props.updateProperty("shadows", 1.);
+    renderer.updateProperties(props);
+    brayns.getParametersManager().getRenderingParameters().setMaxAccumFrames(
+        REFERENCE_FRAMES + 1);
+    brayns.commit();
+
+    // high sample count reference
+    for (size_t i = 0; i < REFERENCE_FRAMES; ++i)
+        brayns.render();
+    auto& frameBuffer = brayns.getEngine().getFrameBuffer();
+    const auto reference = readColors(frameBuffer);
+
+    // error reached within each time budget
+    double previousError = std::numeric_limits<double>::max();
+    for (const auto budget : TIME_BUDGETS)
+    {
+        frameBuffer.clear();
+        size_t frames = 0;
+        brayns::Timer timer;
+        timer.start();
+        while (timer.elapsed() < budget)
+        {
+            brayns.render();
+            ++frames;
+        }
+
+        const auto error =
+            rootMeanSquareError(readColors(frameBuffer), reference);
+        BOOST_TEST_MESSAGE("Path tracing after " << budget << "s, " << frames
+                                                 << " frames: RMSE "
+                                                 << error);
+        BOOST_CHECK_LT(error, previousError);
+        previousError = error;
+    }
+}
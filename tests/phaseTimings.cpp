@@ -0,0 +1,67 @@
+/* Copyright (c) 2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define BOOST_TEST_MODULE braynsPhaseTimings
+
+#include <brayns/common/PhaseTimings.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(consecutive_phases)
+{
+    brayns::PhaseTimings timings;
+    BOOST_CHECK(!timings.isRunning());
+    BOOST_CHECK_EQUAL(timings.getTotal(), 0.);
+
+    timings.start("first");
+    BOOST_CHECK(timings.isRunning());
+    // starting a phase ends the current one
+    timings.start("second");
+    timings.stop();
+    BOOST_CHECK(!timings.isRunning());
+    timings.stop();
+
+    const auto& phases = timings.getPhases();
+    BOOST_REQUIRE_EQUAL(phases.size(), 2);
+    BOOST_CHECK_EQUAL(phases[0].first, "first");
+    BOOST_CHECK_EQUAL(phases[1].first, "second");
+    BOOST_CHECK_GE(phases[0].second, 0.);
+    BOOST_CHECK_GE(phases[1].second, 0.);
+    BOOST_CHECK_CLOSE(timings.getTotal(), phases[0].second + phases[1].second,
+                      0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(running_phase_not_counted)
+{
+    brayns::PhaseTimings timings;
+    timings.start("done");
+    timings.start("running");
+    BOOST_CHECK_EQUAL(timings.getTotal(), timings.getPhases()[0].second);
+
+    brayns::PhaseTimings total;
+    total.start("own");
+    total.stop();
+    total.append(timings, "Other: ");
+    const auto& phases = total.getPhases();
+    BOOST_REQUIRE_EQUAL(phases.size(), 2);
+    BOOST_CHECK_EQUAL(phases[0].first, "own");
+    BOOST_CHECK_EQUAL(phases[1].first, "Other: done");
+    BOOST_CHECK(!total.isRunning());
+}
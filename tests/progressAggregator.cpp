@@ -0,0 +1,82 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define BOOST_TEST_MODULE braynsProgressAggregator
+
+#include <boost/test/unit_test.hpp>
+
+#include <brayns/common/loader/ProgressAggregator.h>
+
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(sum_of_threads)
+{
+    float last = 0.f;
+    std::string lastMessage;
+    {
+        brayns::ProgressAggregator progress(
+            [&](const std::string& message, const float amount) {
+                lastMessage = message;
+                last = amount;
+            },
+            "Counting", 4000, std::chrono::milliseconds(1));
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < 4; ++i)
+            threads.emplace_back([&progress] {
+                for (size_t j = 0; j < 1000; ++j)
+                    progress.increment();
+            });
+        for (auto& thread : threads)
+            thread.join();
+
+        BOOST_CHECK_EQUAL(progress.getCurrent(), 4000);
+        progress.finish();
+    }
+    BOOST_CHECK_EQUAL(lastMessage, "Counting");
+    BOOST_CHECK_EQUAL(last, 1.f);
+}
+
+BOOST_AUTO_TEST_CASE(cancel_from_callback)
+{
+    brayns::ProgressAggregator progress(
+        [](const std::string&, float) {
+            throw std::runtime_error("cancelled");
+        },
+        "Cancelling", 100, std::chrono::milliseconds(1));
+
+    progress.increment();
+    BOOST_CHECK_THROW(
+        for (;;) {
+            progress.increment(0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        },
+        std::runtime_error);
+    BOOST_CHECK_THROW(progress.finish(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(no_callback)
+{
+    brayns::ProgressAggregator progress({}, "Silent", 10);
+    progress.increment(10);
+    BOOST_CHECK_EQUAL(progress.getCurrent(), 10);
+    BOOST_CHECK_NO_THROW(progress.finish());
+}
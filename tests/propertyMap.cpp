@@ -21,6 +21,7 @@
 #define BOOST_TEST_MODULE braynsPropertyMap
 
 #include <brayns/common/PropertyMap.h>
+#include <brayns/common/PropertyObject.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -126,3 +127,80 @@ BOOST_AUTO_TEST_CASE(set_and_get_all_supported_types)
     BOOST_CHECK(properties.getPropertyType("vec3f") == Type::Vec3f);
     BOOST_CHECK(properties.getPropertyType("vec4f") == Type::Vec4f);
 }
+
+BOOST_AUTO_TEST_CASE(modified_properties)
+{
+    brayns::PropertyMap properties;
+    properties.setProperty({"foo", "Foo", 1});
+    properties.setProperty({"bar", "Bar", std::string("bar")});
+    BOOST_CHECK(properties.isModified());
+
+    properties.resetModified();
+    BOOST_CHECK(!properties.isModified());
+
+    // setting the same value does not mark the property as modified
+    properties.updateProperty("foo", 1);
+    properties.setProperty({"bar", "Bar", (const char*)"bar"});
+    BOOST_CHECK(!properties.isModified());
+
+    properties.updateProperty("foo", 2);
+    BOOST_CHECK(properties.isModified());
+    BOOST_CHECK(properties.getProperties()[0]->isModified());
+    BOOST_CHECK(!properties.getProperties()[1]->isModified());
+
+    properties.resetModified();
+    properties.setProperty({"baz", "Baz", true});
+    BOOST_CHECK(properties.getProperties()[2]->isModified());
+    BOOST_CHECK(!properties.getProperties()[0]->isModified());
+}
+
+BOOST_AUTO_TEST_CASE(property_indices)
+{
+    brayns::PropertyMap properties;
+    properties.setProperty({"foo", "Foo", 1});
+    properties.setProperty({"bar", "Bar", 2.});
+
+    const auto index = properties.getIndex("bar");
+    BOOST_REQUIRE(index != brayns::PropertyMap::NO_INDEX);
+    BOOST_CHECK(properties.getIndex("baz") == brayns::PropertyMap::NO_INDEX);
+    BOOST_CHECK_EQUAL(properties.getPropertyAt<double>(index), 2.);
+
+    // the indices are stable while properties are added
+    properties.setProperty({"baz", "Baz", true});
+    properties.updatePropertyAt(index, 3.);
+    BOOST_CHECK_EQUAL(properties.getProperty<double>("bar"), 3.);
+    BOOST_CHECK_THROW(properties.updatePropertyAt(index, 1),
+                      std::runtime_error);
+    BOOST_CHECK_THROW(properties.getPropertyAt<int32_t>(3), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(property_handles)
+{
+    brayns::PropertyMap first;
+    first.setProperty({"foo", "Foo", 1});
+    brayns::PropertyMap second;
+    second.setProperty({"bar", "Bar", 2});
+    second.setProperty({"foo", "Foo", 3});
+
+    brayns::PropertyObject object;
+    object.setProperties("first", first);
+    object.setProperties("second", second);
+    object.setCurrentType("first");
+
+    const brayns::PropertyObject::PropertyHandle foo("foo");
+    BOOST_CHECK_EQUAL(object.getProperty<int32_t>(foo), 1);
+    object.updateProperty(foo, 4);
+    BOOST_CHECK_EQUAL(object.getProperty<int32_t>("foo"), 4);
+
+    // the handle follows the current type and replaced properties
+    object.setCurrentType("second");
+    BOOST_CHECK_EQUAL(object.getProperty<int32_t>(foo), 3);
+    brayns::PropertyMap third;
+    third.setProperty({"foo", "Foo", 5});
+    object.setProperties(third);
+    BOOST_CHECK_EQUAL(object.getProperty<int32_t>(foo), 5);
+
+    const brayns::PropertyObject::PropertyHandle bar("bar");
+    BOOST_CHECK(!object.hasProperty(bar));
+    BOOST_CHECK_THROW(object.getProperty<int32_t>(bar), std::runtime_error);
+}
@@ -46,3 +46,12 @@ BOOST_AUTO_TEST_CASE(bounding_box)
     BOOST_CHECK_EQUAL(boxPill.getMin(), brayns::Vector3d(-2.0, -2.0, -2.0));
     BOOST_CHECK_EQUAL(boxPill.getMax(), brayns::Vector3d(3.0, 3.0, 3.0));
 }
+
+BOOST_AUTO_TEST_CASE(packed_layout)
+{
+    // must match the structs in ExtendedSDFGeometries.ispc
+    BOOST_CHECK_EQUAL(sizeof(brayns::SDFSphere), 16);
+    BOOST_CHECK_EQUAL(sizeof(brayns::SDFPill), 28);
+    BOOST_CHECK_EQUAL(sizeof(brayns::SDFConePill), 32);
+    BOOST_CHECK_EQUAL(sizeof(brayns::SDFGeometryInfo), 24);
+}
@@ -0,0 +1,356 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/common/simulation/CompactFrameReader.h>
+#include <brayns/common/simulation/FrameReader.h>
+#include <brayns/common/simulation/SimulationCacheWriter.h>
+#include <brayns/common/simulation/SimulationReducer.h>
+#include <brayns/io/simulation/SpikeSimulationHandler.h>
+#include <brayns/parameters/GeometryParameters.h>
+
+#define BOOST_TEST_MODULE braynsSimulationCache
+#include <boost/test/unit_test.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const uint64_t NB_FRAMES = 100;
+const uint64_t FRAME_SIZE = 1000;
+
+brayns::floats makeFrames(const uint64_t first, const uint64_t nbFrames)
+{
+    brayns::floats values(nbFrames * FRAME_SIZE);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = first * FRAME_SIZE + i;
+    return values;
+}
+
+void checkCache(const std::string& filename)
+{
+    brayns::GeometryParameters geometryParameters;
+    brayns::SpikeSimulationHandler handler(geometryParameters);
+    BOOST_REQUIRE(handler.attachSimulationToCacheFile(filename));
+    BOOST_REQUIRE_EQUAL(handler.getNbFrames(), NB_FRAMES);
+    BOOST_REQUIRE_EQUAL(handler.getFrameSize(), FRAME_SIZE);
+    for (uint32_t frame = 0; frame < NB_FRAMES; frame += 33)
+    {
+        const auto expected = makeFrames(frame, 1);
+        const auto data = static_cast<float*>(handler.getFrameData(frame));
+        BOOST_CHECK_EQUAL_COLLECTIONS(data, data + FRAME_SIZE,
+                                      expected.begin(), expected.end());
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(write_cache)
+{
+    const auto filename = boost::filesystem::unique_path().string();
+    {
+        // small blocks to go through the aligned flushes
+        brayns::SimulationCacheWriter writer(filename, NB_FRAMES, FRAME_SIZE,
+                                             false, 4096);
+        for (uint64_t frame = 0; frame < NB_FRAMES; frame += 10)
+            writer.append(makeFrames(frame, 10).data(), 10);
+        BOOST_CHECK_THROW(writer.append(makeFrames(0, 1).data(), 1),
+                          std::runtime_error);
+        writer.close();
+    }
+    BOOST_CHECK_EQUAL(boost::filesystem::file_size(filename),
+                      brayns::SIMULATION_CACHE_HEADER_SIZE +
+                          NB_FRAMES * FRAME_SIZE * sizeof(float));
+    checkCache(filename);
+    boost::filesystem::remove(filename);
+}
+
+BOOST_AUTO_TEST_CASE(resume_cache)
+{
+    const auto filename = boost::filesystem::unique_path().string();
+    {
+        brayns::SimulationCacheWriter writer(filename, NB_FRAMES, FRAME_SIZE,
+                                             false, 4096);
+        writer.append(makeFrames(0, 50).data(), 50);
+        writer.close();
+    }
+
+    // an interrupted write leaves a partial frame
+    boost::filesystem::resize_file(filename,
+                                   boost::filesystem::file_size(filename) - 10);
+    {
+        brayns::SimulationCacheWriter writer(filename, NB_FRAMES, FRAME_SIZE,
+                                             true, 4096);
+        BOOST_REQUIRE_EQUAL(writer.getNbFrames(), 49);
+        writer.append(makeFrames(49, 51).data(), 51);
+        writer.close();
+    }
+    checkCache(filename);
+
+    // another report overwrites the cache
+    {
+        brayns::SimulationCacheWriter writer(filename, NB_FRAMES,
+                                             FRAME_SIZE + 1, true, 4096);
+        BOOST_CHECK_EQUAL(writer.getNbFrames(), 0);
+    }
+    boost::filesystem::remove(filename);
+}
+
+BOOST_AUTO_TEST_CASE(frame_readers)
+{
+    const auto filename = boost::filesystem::unique_path().string();
+    {
+        brayns::SimulationCacheWriter writer(filename, NB_FRAMES, FRAME_SIZE,
+                                             false);
+        writer.append(makeFrames(0, NB_FRAMES).data(), NB_FRAMES);
+        writer.close();
+    }
+
+    for (const auto type :
+         {brayns::FrameReaderType::mmap, brayns::FrameReaderType::pread,
+          brayns::FrameReaderType::io_uring})
+    {
+        auto reader = brayns::FrameReader::create(type, filename, 4);
+        BOOST_REQUIRE_EQUAL(reader->getNbFrames(), NB_FRAMES);
+        BOOST_REQUIRE_EQUAL(reader->getFrameSize(), FRAME_SIZE);
+
+        // more prefetches than buffers, and frames read out of order
+        for (uint64_t frame = 0; frame < NB_FRAMES; frame += 7)
+        {
+            for (uint64_t i = 1; i < 8; ++i)
+                reader->prefetch((frame + i) % NB_FRAMES);
+            const auto expected = makeFrames(frame, 1);
+            const auto data = reader->getFrame(frame, true);
+            BOOST_REQUIRE(data);
+            BOOST_CHECK_EQUAL_COLLECTIONS(data, data + FRAME_SIZE,
+                                          expected.begin(), expected.end());
+        }
+    }
+
+    // truncated cache
+    boost::filesystem::resize_file(filename,
+                                   boost::filesystem::file_size(filename) - 4);
+    BOOST_CHECK_THROW(brayns::FrameReader::create(
+                          brayns::FrameReaderType::pread, filename),
+                      std::runtime_error);
+    boost::filesystem::remove(filename);
+}
+
+BOOST_AUTO_TEST_CASE(compact_frames)
+{
+    const auto filename = boost::filesystem::unique_path().string();
+    {
+        brayns::SimulationCacheWriter writer(filename, NB_FRAMES, FRAME_SIZE,
+                                             false);
+        writer.append(makeFrames(0, NB_FRAMES).data(), NB_FRAMES);
+        writer.close();
+    }
+
+    // two ranges overlapping in the file, small gaps and a distant range
+    const brayns::FrameRanges ranges{{10, 0, 5},
+                                     {15, 5, 5},
+                                     {12, 30, 2},
+                                     {30, 20, 3},
+                                     {900, 10, 10}};
+    brayns::CompactFrameReader reader(filename, ranges, 32, 16);
+    BOOST_CHECK_EQUAL(reader.getNbFrames(), NB_FRAMES);
+    BOOST_CHECK_EQUAL(reader.getCacheFrameSize(), FRAME_SIZE);
+    BOOST_CHECK_EQUAL(reader.getNbReads(), 3);
+    BOOST_CHECK_EQUAL(reader.getNbReadValues(), 36);
+
+    for (uint64_t frame = 0; frame < NB_FRAMES; frame += 33)
+    {
+        const auto full = makeFrames(frame, 1);
+        brayns::floats expected(32, -1.f);
+        for (const auto& range : ranges)
+            std::copy_n(full.begin() + range.source, range.count,
+                        expected.begin() + range.target);
+
+        brayns::floats values(32, -1.f);
+        reader.read(frame, values.data());
+        BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(),
+                                      expected.begin(), expected.end());
+    }
+    BOOST_CHECK_THROW(reader.read(NB_FRAMES, nullptr), std::runtime_error);
+    BOOST_CHECK_THROW(brayns::CompactFrameReader(filename,
+                                                 {{FRAME_SIZE - 1, 0, 2}}, 2),
+                      std::runtime_error);
+    boost::filesystem::remove(filename);
+}
+
+BOOST_AUTO_TEST_CASE(interpolated_frames)
+{
+    const auto filename = boost::filesystem::unique_path().string();
+    {
+        brayns::SimulationCacheWriter writer(filename, NB_FRAMES, FRAME_SIZE,
+                                             false);
+        writer.append(makeFrames(0, NB_FRAMES).data(), NB_FRAMES);
+        writer.close();
+    }
+
+    brayns::GeometryParameters geometryParameters;
+    brayns::SpikeSimulationHandler handler(geometryParameters);
+    BOOST_REQUIRE(handler.attachSimulationToCacheFile(filename));
+
+    // the frames are linear in time, reproduced by both interpolations
+    for (const auto interpolation : {brayns::SimulationInterpolation::linear,
+                                     brayns::SimulationInterpolation::cubic})
+    {
+        const auto data = static_cast<float*>(
+            handler.getInterpolatedFrameData(3, 0.25, interpolation));
+        BOOST_REQUIRE(data);
+        BOOST_CHECK_EQUAL(handler.getCurrentPosition(), 3.25);
+        for (uint64_t i = 0; i < FRAME_SIZE; ++i)
+            BOOST_CHECK_CLOSE(data[i], 3250.f + i, 0.001f);
+    }
+    // the key frames are read aside from the playback
+    BOOST_CHECK_EQUAL(handler.getCurrentFrame(),
+                      std::numeric_limits<uint32_t>::max());
+
+    // out of range fractions are clamped
+    auto clamped = static_cast<float*>(handler.getInterpolatedFrameData(
+        3, 1.5, brayns::SimulationInterpolation::linear));
+    BOOST_REQUIRE(clamped);
+    BOOST_CHECK_EQUAL(handler.getCurrentPosition(), 4);
+    BOOST_CHECK_CLOSE(clamped[10], 4010.f, 0.001f);
+
+    // the last frame blends with the first one
+    auto data = static_cast<float*>(handler.getInterpolatedFrameData(
+        NB_FRAMES - 1, 0.5, brayns::SimulationInterpolation::linear));
+    BOOST_REQUIRE(data);
+    BOOST_CHECK_CLOSE(data[10], (NB_FRAMES - 1) * FRAME_SIZE / 2.f + 10.f,
+                      0.001f);
+
+    data = static_cast<float*>(handler.getInterpolatedFrameData(
+        5, 0.5, brayns::SimulationInterpolation::none));
+    BOOST_REQUIRE(data);
+    BOOST_CHECK_EQUAL(handler.getCurrentPosition(), 5);
+    BOOST_CHECK_EQUAL(data[10], 5010.f);
+    boost::filesystem::remove(filename);
+}
+
+BOOST_AUTO_TEST_CASE(compressed_cache)
+{
+    // smooth values in space and time, as voltages
+    brayns::floats frames(NB_FRAMES * FRAME_SIZE);
+    for (uint64_t frame = 0; frame < NB_FRAMES; ++frame)
+        for (uint64_t i = 0; i < FRAME_SIZE; ++i)
+            frames[frame * FRAME_SIZE + i] =
+                -65.f + 10.f * std::sin(0.01f * i + 0.1f * frame);
+
+    const auto filename = boost::filesystem::unique_path().string();
+    const brayns::SimulationCacheFormat formats[] = {{16, 8}, {8, 0}};
+    for (const auto& format : formats)
+    {
+        float maxError = 0;
+        float errorBound = 0;
+        {
+            brayns::SimulationCacheWriter writer(
+                filename, NB_FRAMES, FRAME_SIZE, false,
+                brayns::SimulationCacheWriter::DEFAULT_BLOCK_SIZE, format);
+            writer.append(frames.data(), NB_FRAMES);
+            writer.close();
+            maxError = writer.getMaxError();
+            errorBound = writer.getErrorBound();
+        }
+        // the bound holds with the rounding of values around -65
+        BOOST_CHECK_LE(maxError, errorBound);
+        BOOST_CHECK_LT(boost::filesystem::file_size(filename),
+                       NB_FRAMES * FRAME_SIZE * format.bits / 8);
+        BOOST_CHECK_LT(maxError, 20.f / ((1 << format.bits) - 1));
+
+        // out of order reads decode from the previous key frame
+        auto reader = brayns::FrameReader::create(
+            brayns::FrameReaderType::pread, filename, 4);
+        BOOST_REQUIRE_EQUAL(reader->getNbFrames(), NB_FRAMES);
+        BOOST_REQUIRE_EQUAL(reader->getFrameSize(), FRAME_SIZE);
+        for (const uint64_t frame : {0, 1, 2, 3, 21, 13, 99, 98, 57})
+        {
+            reader->prefetch((frame + 1) % NB_FRAMES);
+            const auto data = reader->getFrame(frame, true);
+            BOOST_REQUIRE(data);
+            const auto expected = frames.data() + frame * FRAME_SIZE;
+            float error = 0;
+            for (uint64_t i = 0; i < FRAME_SIZE; ++i)
+                error = std::max(error, std::abs(data[i] - expected[i]));
+            BOOST_CHECK_LE(error, maxError);
+        }
+    }
+    BOOST_CHECK_THROW(brayns::CompactFrameReader(filename, {}, 0),
+                      std::runtime_error);
+    BOOST_CHECK_THROW(brayns::SimulationCacheWriter(
+                          filename, NB_FRAMES, FRAME_SIZE, true,
+                          brayns::SimulationCacheWriter::DEFAULT_BLOCK_SIZE,
+                          {16, 0}),
+                      std::runtime_error);
+    boost::filesystem::remove(filename);
+}
+
+BOOST_AUTO_TEST_CASE(reduced_frames)
+{
+    const brayns::floats frame{1, 2, 3, 4, 5, 6, 7, 8};
+
+    // two sections of one cell, then a cell of two ranges
+    brayns::SimulationReducer sections(
+        brayns::SimulationReduction::section_mean);
+    BOOST_CHECK_EQUAL(sections.addValue(), 0);
+    sections.addRange(0, 2);
+    BOOST_CHECK_EQUAL(sections.addValue(), 1);
+    sections.addRange(2, 3);
+    BOOST_CHECK_EQUAL(sections.addValue(), 2);
+    sections.addRange(6, 2);
+    sections.addRange(5, 1);
+    BOOST_REQUIRE_EQUAL(sections.getFrameSize(), 3);
+
+    brayns::floats values(sections.getFrameSize());
+    sections.reduce(frame.data(), frame.size(), values.data());
+    BOOST_CHECK_EQUAL(values[0], 1.5f);
+    BOOST_CHECK_EQUAL(values[1], 4.f);
+    BOOST_CHECK_EQUAL(values[2], 7.f);
+
+    // values out of the frame are ignored
+    sections.reduce(frame.data(), 3, values.data());
+    BOOST_CHECK_EQUAL(values[1], 3.f);
+    BOOST_CHECK_EQUAL(values[2], 0.f);
+
+    brayns::SimulationReducer cells(brayns::SimulationReduction::cell_max);
+    cells.addValue();
+    cells.addRange(0, 2);
+    cells.addRange(2, 3);
+    cells.addValue();
+    cells.addRange(6, 2);
+    cells.addRange(5, 1);
+    BOOST_REQUIRE_EQUAL(cells.getFrameSize(), 2);
+    cells.reduce(frame.data(), frame.size(), values.data());
+    BOOST_CHECK_EQUAL(values[0], 5.f);
+    BOOST_CHECK_EQUAL(values[1], 8.f);
+
+    // the cached reduced frames are told apart by their layout
+    BOOST_CHECK_NE(sections.getLayoutHash(), cells.getLayoutHash());
+    brayns::SimulationReducer sectionsMax(
+        brayns::SimulationReduction::section_max);
+    for (const auto& range : {std::make_pair(0, 2), std::make_pair(2, 3)})
+    {
+        sectionsMax.addValue();
+        sectionsMax.addRange(range.first, range.second);
+    }
+    BOOST_CHECK_NE(sections.getLayoutHash(), sectionsMax.getLayoutHash());
+}
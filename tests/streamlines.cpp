@@ -105,3 +105,85 @@ BOOST_AUTO_TEST_CASE(streamlines)
     BOOST_CHECK(compareTestImage("streamlines.png",
                                  brayns.getEngine().getFrameBuffer()));
 }
+
+BOOST_AUTO_TEST_CASE(bulk_streamlines)
+{
+    auto& testSuite = boost::unit_test::framework::master_test_suite();
+
+    const char* app = testSuite.argv[0];
+    const char* argv[] = {app,    "--accumulation",
+                          "off",  "--window-size",
+                          "1600", "900"};
+    const int argc = sizeof(argv) / sizeof(char*);
+
+    brayns::Brayns brayns(argc, argv);
+    auto& scene = brayns.getEngine().getScene();
+
+    {
+        constexpr size_t materialId = 0;
+        auto model = scene.createModel();
+        const brayns::Vector3f WHITE = {1.f, 1.f, 1.f};
+
+        auto material = model->createMaterial(materialId, "streamline");
+        material->setDiffuseColor(WHITE);
+        material->setSpecularColor(WHITE);
+        material->setSpecularExponent(10.f);
+
+        // same spirals as above, in one call
+        brayns::Vector3fs vertices;
+        brayns::Vector4fs vertexColors;
+        brayns::floats radii;
+        brayns::uint64_ts offsets;
+        for (size_t col = 0; col < 8; ++col)
+        {
+            for (size_t row = 0; row < 3; ++row)
+            {
+                offsets.push_back(vertices.size());
+
+                const auto offset =
+                    brayns::Vector3f{0.5f * col, 1.f * row, 0.0f};
+                const float thicknessStart = 0.03f;
+                const float thicknessEnd = 0.005f;
+
+                constexpr size_t numVertices = 70;
+                for (size_t i = 0; i < numVertices; ++i)
+                {
+                    const float t = i / static_cast<float>(numVertices);
+                    const auto v =
+                        brayns::Vector3f(0.1f * std::cos(i * 0.5f), i * 0.01f,
+                                         0.1f * std::sin(i * 0.5f));
+                    vertices.push_back(v + offset);
+                    radii.push_back((1.f - t) * thicknessStart +
+                                    t * thicknessEnd);
+                    vertexColors.push_back(
+                        brayns::Vector4f(t, std::abs(1.0f - 2.0f * t), 1.0f - t,
+                                         1.0f));
+                }
+            }
+        }
+        model->addStreamlines(materialId, vertices, vertexColors, radii,
+                              offsets);
+
+        const auto& data = model->getStreamlines().at(materialId);
+        BOOST_CHECK_EQUAL(data.vertex.size(), vertices.size());
+        BOOST_CHECK_EQUAL(data.indices.size(),
+                          vertices.size() - offsets.size());
+        BOOST_CHECK_EQUAL(data.indices[69], 70);
+
+        BOOST_CHECK_THROW(model->addStreamlines(materialId, vertices,
+                                                vertexColors, radii, {0, 1}),
+                          std::runtime_error);
+
+        auto modelDesc =
+            std::make_shared<brayns::ModelDescriptor>(std::move(model),
+                                                      "Streamlines");
+        scene.addModel(modelDesc);
+
+        brayns.getEngine().getCamera().setInitialState(
+            modelDesc->getModel().getBounds());
+    }
+
+    brayns.commitAndRender();
+    BOOST_CHECK(compareTestImage("streamlines.png",
+                                 brayns.getEngine().getFrameBuffer()));
+}
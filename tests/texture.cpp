@@ -0,0 +1,137 @@
+/* Copyright (c) 2015-2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/common/material/Texture2D.h>
+#include <brayns/common/material/TextureCache.h>
+
+#include <tests/paths.h>
+
+#define BOOST_TEST_MODULE braynsTexture
+#include <boost/test/unit_test.hpp>
+
+#include <boost/filesystem.hpp>
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+/**
+ * Temporary folder with a.png, its copy b.png, a symbolic link to it and a
+ * different image c.png
+ */
+struct TextureFiles
+{
+    TextureFiles()
+        : folder(fs::temp_directory_path() / fs::unique_path())
+    {
+        fs::create_directories(folder);
+        const std::string images = BRAYNS_TESTDATA_IMAGES_PATH;
+        fs::copy_file(images + "snapshot.png", folder / "a.png");
+        fs::copy_file(images + "snapshot.png", folder / "b.png");
+        fs::copy_file(images + "streamlines.png", folder / "c.png");
+        fs::create_symlink(folder / "a.png", folder / "link.png");
+    }
+
+    ~TextureFiles() { fs::remove_all(folder); }
+
+    std::string path(const std::string& name) const
+    {
+        return (folder / name).string();
+    }
+
+    const fs::path folder;
+};
+}
+
+BOOST_AUTO_TEST_CASE(size_in_bytes)
+{
+    brayns::Texture2D texture;
+    texture.setWidth(4);
+    texture.setHeight(2);
+    texture.setNbChannels(1);
+    texture.setDepth(1);
+    unsigned char data[] = {0, 4, 8, 12, 4, 8, 12, 16};
+    texture.setRawData(data, sizeof(data));
+
+    // only the full resolution is uploaded, no mip levels are kept
+    BOOST_CHECK_EQUAL(texture.getSizeInBytes(), sizeof(data));
+    BOOST_CHECK_EQUAL(texture.getData()[7], 16);
+}
+
+BOOST_AUTO_TEST_CASE(missing_file)
+{
+    brayns::TextureCache cache;
+    BOOST_CHECK(!cache.get("missing.png"));
+    BOOST_CHECK_EQUAL(cache.getSizeInBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(shared_by_path)
+{
+    const TextureFiles files;
+    brayns::TextureCache cache;
+    const auto texture = cache.get(files.path("a.png"));
+    if (!texture) // no image support
+        return;
+
+    BOOST_CHECK_EQUAL(cache.get(files.path("link.png")), texture);
+    BOOST_CHECK_EQUAL(
+        cache.get((files.folder / "." / "a.png").string()), texture);
+    BOOST_CHECK_EQUAL(cache.getSizeInBytes(), texture->getSizeInBytes());
+}
+
+BOOST_AUTO_TEST_CASE(shared_by_content)
+{
+    const TextureFiles files;
+    brayns::TextureCache cache;
+    const auto textures =
+        cache.get({files.path("a.png"), files.path("b.png"),
+                   files.path("c.png")});
+    if (!textures[0])
+        return;
+
+    // identical images in different files are decoded once
+    BOOST_CHECK_EQUAL(textures[0], textures[1]);
+    BOOST_CHECK_EQUAL(cache.get(files.path("b.png")), textures[0]);
+
+    BOOST_REQUIRE(textures[2]);
+    BOOST_CHECK_NE(textures[2], textures[0]);
+    BOOST_CHECK_EQUAL(cache.getSizeInBytes(),
+                      textures[0]->getSizeInBytes() +
+                          textures[2]->getSizeInBytes());
+}
+
+BOOST_AUTO_TEST_CASE(released_by_last_user)
+{
+    const TextureFiles files;
+    brayns::TextureCache cache;
+    auto texture = cache.get(files.path("a.png"));
+    if (!texture)
+        return;
+
+    std::weak_ptr<brayns::Texture2D> cached = texture;
+    auto otherUser = cache.get(files.path("b.png"));
+    texture.reset();
+    BOOST_CHECK(!cached.expired());
+    BOOST_CHECK_NE(cache.getSizeInBytes(), 0);
+
+    otherUser.reset();
+    BOOST_CHECK(cached.expired());
+    BOOST_CHECK_EQUAL(cache.getSizeInBytes(), 0);
+}
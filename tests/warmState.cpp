@@ -0,0 +1,99 @@
+/* Copyright (c) 2018, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Daniel.Nachbaur@epfl.ch
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/Brayns.h>
+
+#include <brayns/common/engine/Engine.h>
+#include <brayns/common/scene/Model.h>
+#include <brayns/common/scene/Scene.h>
+
+#define BOOST_TEST_MODULE braynsWarmState
+#include <boost/test/unit_test.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+void writePoints(const std::string& filename, const size_t nbPoints)
+{
+    std::ofstream file(filename);
+    for (size_t i = 0; i < nbPoints; ++i)
+        file << i << " " << i * 2 << " " << i * 3 << std::endl;
+}
+
+std::string readFile(const std::string& filename)
+{
+    std::ifstream file(filename);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+size_t countSpheres(const std::string& input, const std::string& state)
+{
+    auto& testSuite = boost::unit_test::framework::master_test_suite();
+    const char* argv[] = {testSuite.argv[0],   input.c_str(),
+                          "--warm-state-file", state.c_str(),
+                          "--synchronous-mode", "on"};
+    const int argc = sizeof(argv) / sizeof(char*);
+    brayns::Brayns brayns(argc, argv);
+
+    size_t nbSpheres = 0;
+    auto& scene = brayns.getEngine().getScene();
+    for (const auto& modelDescriptor : scene.getModelDescriptors())
+    {
+        const auto& model = modelDescriptor->getModel();
+        for (const auto& spheres : model.getSpheres())
+            nbSpheres += spheres.second.size();
+    }
+    return nbSpheres;
+}
+}
+
+BOOST_AUTO_TEST_CASE(invalidated_by_changed_inputs)
+{
+    const auto folder = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(folder);
+    const auto input = (folder / "points.xyz").string();
+    const auto state = (folder / "state").string();
+    const auto arguments = state + ".arguments";
+
+    writePoints(input, 3);
+    BOOST_CHECK_EQUAL(countSpheres(input, state), 3);
+    BOOST_REQUIRE(fs::exists(state));
+    BOOST_REQUIRE(fs::exists(arguments));
+    const auto key = readFile(arguments);
+
+    // loaded from the warm state, which is kept
+    BOOST_CHECK_EQUAL(countSpheres(input, state), 3);
+    BOOST_CHECK_EQUAL(readFile(arguments), key);
+
+    // the input changed, it is loaded again and the state saved again
+    writePoints(input, 4);
+    BOOST_CHECK_EQUAL(countSpheres(input, state), 4);
+    BOOST_CHECK(readFile(arguments) != key);
+
+    fs::remove_all(folder);
+}